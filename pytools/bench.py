@@ -0,0 +1,104 @@
+"""
+Helpers shared by the benchmark scripts of the test problems (bench*.py)
+"""
+import argparse
+import os
+import re
+import shutil
+import subprocess
+import sys
+
+def argParser(cmakeExample="Kokkos_ENABLE_OPENMP=ON", maxcycles=200):
+  """
+  Parser of the options common to the benchmark scripts: -cmake, -maxcycles (unless maxcycles
+  is None) and -j. The scripts add their own options before parsing.
+  """
+  parser = argparse.ArgumentParser()
+  parser.add_argument("-cmake",
+                      default=[],
+                      help="Additional CMake options common to all builds (e.g. "
+                           +cmakeExample+")",
+                      nargs='+')
+  if maxcycles is not None:
+    parser.add_argument("-maxcycles",
+                        type=int,
+                        default=maxcycles,
+                        help="Number of cycles of each run")
+  parser.add_argument("-j",
+                      type=int,
+                      default=8,
+                      help="Number of parallel compilation jobs")
+  return parser
+
+def build(problemDir, name, cmakeOptions, jobs):
+  """
+  Configure and compile the problem of problemDir in a clean build-bench-<name> directory with
+  the given CMake options (without -D), and return the path of this directory.
+  """
+  buildDir = os.path.join(problemDir, "build-bench-"+name)
+  if os.path.exists(buildDir):
+    shutil.rmtree(buildDir)
+  os.makedirs(buildDir)
+
+  comm = ["cmake", os.getenv("IDEFIX_DIR"), "-DIdefix_PROBLEM_DIR="+problemDir]
+  for opt in cmakeOptions:
+    comm.append("-D"+opt)
+  subprocess.run(comm, cwd=buildDir, check=True)
+  subprocess.run(["make", "-j"+str(jobs)], cwd=buildDir, check=True)
+  return buildDir
+
+def run(buildDir, options, cwd):
+  """
+  Run the idefix executable of buildDir from cwd, and return its standard output.
+  """
+  result = subprocess.run([os.path.join(buildDir, "idefix")] + options,
+                          cwd=cwd, check=True, capture_output=True, text=True)
+  return result.stdout
+
+def cellUpdates(output, label):
+  """
+  Performance of a run (cell updates/second), as reported at the end of its output.
+  """
+  match = re.search(r"Perfs are\s+([0-9.eE+-]+) cell updates/second", output)
+  if match is None:
+    sys.exit("Unable to find performances in the output of the "+label)
+  return float(match.group(1))
+
+# Kernel of the -profile summary:
+# <total time>  <% of total time>  <launches>  <cell updates/s>  <GB/s>  <name>
+kernelRe = re.compile(r"^\S+ sec\s+\S+%\s+\d+\s+([0-9.eE+-]+)\s+\S+\s+(\S+)$")
+
+def kernelPerf(output, name):
+  """
+  Cell updates/s of the kernel name, as reported by -profile (0 if the kernel is not found).
+  """
+  for line in output.splitlines():
+    match = kernelRe.match(line.strip())
+    if match is not None and match.group(2) == name:
+      return float(match.group(1))
+  return 0
+
+# Region of the -profile tree:
+# <indent>|-> <total time> sec  <% of total time>  <% of parent time>  <calls>  <name>
+regionRe = re.compile(r"^((?:\|   )*)\|-> \S+ sec\s+([0-9.]+)%\s+\S+%\s+\d+\s+(\S+)")
+
+def regionShare(output, prefixes):
+  """
+  Fraction (in %) of the total time spent in the profiler regions whose name starts with one
+  of prefixes, as reported by -profile. Only the outermost matching regions are summed, so that
+  nested regions are not counted twice.
+  """
+  share = 0
+  matchLevel = None
+  for line in output.splitlines():
+    match = regionRe.match(line)
+    if match is None:
+      continue
+    level = len(match.group(1))//4
+    name = match.group(3)
+    if matchLevel is not None and level <= matchLevel:
+      matchLevel = None
+    if matchLevel is None and name.startswith(prefixes):
+      matchLevel = level
+      share += float(match.group(2))
+  return share
@@ -71,6 +71,10 @@ class idfxTest:
                         help="Enable single precision",
                         action="store_true")
 
+    parser.add_argument("-mixed",
+                        help="Enable mixed precision (single precision fluxes)",
+                        action="store_true")
+
     parser.add_argument("-vectPot",
                         help="Enable vector potential formulation",
                         action="store_true")
@@ -78,7 +82,7 @@ class idfxTest:
     parser.add_argument("-reconstruction",
                         type=int,
                         default=2,
-                        help="set reconstruction scheme (2=PLM, 3=LimO3, 4=PPM)")
+                        help="set reconstruction scheme (2=PLM, 3=LimO3, 4=PPM, 5=WENO5-Z, 6=MP5)")
 
     parser.add_argument("-idefixDir",
                         default=idefix_dir_env,
@@ -213,6 +217,8 @@ class idfxTest:
     #if we use single precision
     if(self.single):
       comm.append("-DIdefix_PRECISION=Single")
+    elif(self.mixed):
+      comm.append("-DIdefix_PRECISION=Mixed")
     else:
       comm.append("-DIdefix_PRECISION=Double")
 
@@ -244,6 +250,10 @@ class idfxTest:
       comm.append("-DIdefix_RECONSTRUCTION=LimO3")
     elif(self.reconstruction==4):
       comm.append("-DIdefix_RECONSTRUCTION=Parabolic")
+    elif(self.reconstruction==5):
+      comm.append("-DIdefix_RECONSTRUCTION=Weno5Z")
+    elif(self.reconstruction==6):
+      comm.append("-DIdefix_RECONSTRUCTION=MP5")
 
     # export ccache env
     if self.ccache:
@@ -403,6 +413,11 @@ class idfxTest:
     else:
       self.single = False
 
+    if "MIXED PRECISION" in log:
+      self.mixed = True
+    else:
+      self.mixed = False
+
     if "Kokkos CUDA target ENABLED" in log:
       self.cuda = True
     else:
@@ -421,6 +436,12 @@ class idfxTest:
     if "4th order (PPM)" in log:
       self.reconstruction = 4
 
+    if "5th order (WENO5-Z)" in log:
+      self.reconstruction = 5
+
+    if "5th order (MP5)" in log:
+      self.reconstruction = 6
+
     self.mpi=False
     if "MPI ENABLED" in log:
       self.mpi=True
@@ -454,9 +475,11 @@ class idfxTest:
     self.standardTest()
     self.nonRegressionTest(filename, tolerance)
 
-  def standardTest(self):
+  def standardTest(self, args=[]):
     # log and in fake mode do not execute.
-    self.addLog({"call": "standardTest", "args":{}})
+    self.addLog({"call": "standardTest", "args":{
+      "args": args,
+    }})
     if self.fake:
       return
 
@@ -466,6 +489,8 @@ class idfxTest:
       comm = [sys.executable, "testidefix.py"]
       if self.noplot:
         comm.append("-noplot")
+      # options of the standard test of this run
+      comm += args
 
       print(bcolors.OKCYAN+"Running standard test...")
       try:
@@ -543,6 +568,9 @@ class idfxTest:
       return
 
     self._readLog()
+    if self.mixed:
+      print(bcolors.WARNING+"Mixed precision runs use double precision references, skipping."+bcolors.ENDC)
+      return
     targetDir = os.path.join(self.referenceDirectory,self.testDir)
     if not os.path.exists(targetDir):
       print("Creating reference directory")
@@ -569,6 +597,8 @@ class idfxTest:
     print("Input File: "+self.inifile)
     if(self.single):
       print("Precision: Single")
+    elif(self.mixed):
+      print("Precision: Mixed")
     else:
       print("Precision: Double")
     if(self.reconstruction==2):
@@ -577,6 +607,10 @@ class idfxTest:
       print("Reconstruction: LimO3")
     elif(self.reconstruction==4):
       print("Reconstruction: PPM")
+    elif(self.reconstruction==5):
+      print("Reconstruction: WENO5-Z")
+    elif(self.reconstruction==6):
+      print("Reconstruction: MP5")
     if(self.vectPot):
       print("Vector Potential: ON")
     else:
@@ -594,7 +628,12 @@ class idfxTest:
       strReconstruction = "limo3"
     if self.reconstruction == 4:
       strReconstruction= "ppm"
+    if self.reconstruction == 5:
+      strReconstruction= "weno5z"
+    if self.reconstruction == 6:
+      strReconstruction= "mp5"
 
+    # mixed precision runs are compared to double precision references
     strPrecision="double"
     if self.single:
       strPrecision="single"
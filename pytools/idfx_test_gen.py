@@ -8,7 +8,8 @@
 import copy
 import pytest
 
-DO_NOT_LOOP_ON = ['restart_no_overwrite', "dec", "multirun", "check_file_produced"]
+DO_NOT_LOOP_ON = ['restart_no_overwrite', "dec", "multirun", "check_file_produced", "saveDump",
+                  "compareDump", "standardTestArgs"]
 
 class IdefixDirTestGenerator:
   '''
@@ -8,6 +8,7 @@
 import os
 import sys
 import json
+import shutil
 import glob
 import copy
 import pytest
@@ -194,6 +195,12 @@ class IdexPytestRunner:
     nonRegIni = config_override.get("nonRegressionTestIni", nonRegIni)
     if 'nonRegressionTestIni' in config_override:
       del config_override['nonRegressionTestIni']
+    # keep the dump of this run (saveDump), or compare it to a dump kept by a previous run of
+    # a multirun (compareDump: {"file": ..., "tolerance": ...}, or a list of them)
+    saveDump = config_override.pop("saveDump", None)
+    compareDump = config_override.pop("compareDump", None)
+    # command line options given to the standard test of this run
+    standardTestArgs = config_override.pop("standardTestArgs", [])
 
     # apply config
     idefixTest.applyConfig(config_override)
@@ -229,11 +236,19 @@ class IdexPytestRunner:
 
     # check outputs
     if standardTest:
-      idefixTest.standardTest()
+      idefixTest.standardTest(standardTestArgs)
     if nonReg:
       if nonRegIni:
         idefixTest.inifile = nonRegIni
       idefixTest.nonRegressionTest(filename=dumpname, tolerance=tolerance)
+    if saveDump and not idefixTest.fake:
+      shutil.copy(dumpname, saveDump)
+    if compareDump:
+      # a single comparison or a list of them
+      if isinstance(compareDump, dict):
+        compareDump = [compareDump]
+      for comparison in compareDump:
+        idefixTest.compareDump(comparison["file"], dumpname, tolerance=comparison["tolerance"])
 
     # check that we didn't overrite the file during the restart
     if not idefixTest.fake:
@@ -0,0 +1,60 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <sstream>
+#include <string>
+#include "idefix.hpp"
+#include "dataBlock.hpp"
+#include "input.hpp"
+
+// Split the active domain of this process in blocks along the outermost direction
+void DataBlock::InitBlocks(Input &input) {
+  nBlocks = input.GetOrSet<int>("Grid","blocksPerRank",0,1);
+  blockDir = DIMENSIONS-1;
+  if(nBlocks < 1) {
+    IDEFIX_ERROR("[Grid] blocksPerRank should be >= 1");
+  }
+  if(nBlocks > np_int[blockDir]) {
+    std::stringstream msg;
+    msg << "[Grid] blocksPerRank=" << nBlocks << " is larger than the number of cells of this "
+        << "process in direction X" << blockDir+1 << " (" << np_int[blockDir] << ")";
+    IDEFIX_ERROR(msg);
+  }
+  if(nBlocks > 1 && haveGridCoarsening) {
+    IDEFIX_WARNING("[Grid] blocksPerRank is not compatible with grid coarsening, "
+                   "the active domain of each process is kept in a single block");
+    nBlocks = 1;
+  }
+
+  // Blocks of even sizes, the first ones getting the remaining cells
+  blockBeg = std::vector<int>(nBlocks+1);
+  blockBeg[0] = beg[blockDir];
+  for(int b = 0 ; b < nBlocks ; b++) {
+    const int size = np_int[blockDir]/nBlocks + (b < np_int[blockDir]%nBlocks ? 1 : 0);
+    blockBeg[b+1] = blockBeg[b] + size;
+  }
+  domainLbound = lbound[blockDir];
+  domainRbound = rbound[blockDir];
+}
+
+// Restrict the active domain (beg, end) to block b, or restore the whole domain when b<0.
+// The faces between two blocks are internal boundaries: the ghost cells of a block are the
+// active cells of its neighbours, shared in memory.
+void DataBlock::SetActiveBlock(int b) {
+  if(nBlocks == 1) return;
+  if(b < 0) {
+    beg[blockDir] = blockBeg[0];
+    end[blockDir] = blockBeg[nBlocks];
+    lbound[blockDir] = domainLbound;
+    rbound[blockDir] = domainRbound;
+  } else {
+    beg[blockDir] = blockBeg[b];
+    end[blockDir] = blockBeg[b+1];
+    lbound[blockDir] = (b == 0) ? domainLbound : internal;
+    rbound[blockDir] = (b == nBlocks-1) ? domainRbound : internal;
+  }
+}
@@ -0,0 +1,91 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <memory>
+#include <vector>
+#include "idefix.hpp"
+#include "dataBlock.hpp"
+#include "fluid.hpp"
+#ifdef WITH_MPI
+#include "mpi.hpp"
+#endif
+
+// Register the fields of all of the fluids in a single Mpi object, so that the halo exchanges
+// of the gas and of the dust species are packed in one message per neighbour and direction.
+void DataBlock::InitCoalescedExchanges() {
+  idfx::pushRegion("DataBlock::InitCoalescedExchanges");
+  #ifdef WITH_MPI
+  std::vector<ExchangeFieldSet> fieldSets;
+
+  fieldSets.push_back(hydro->boundary->mpiFieldSet);
+  fluidsVc.push_back(hydro->Vc);
+  fluidsVs.push_back(hydro->Vs);
+
+  if(haveDustSharedStorage) {
+    ExchangeFieldSet dustSet;
+    for(int n = 0 ; n < dustVc.extent(0) ; n++) {
+      dustSet.mapVars.push_back(n);
+    }
+    fieldSets.push_back(dustSet);
+    fluidsVc.push_back(dustVc);
+    fluidsVs.push_back(IdefixArray4D<real>());
+  } else {
+    for(int s = 0 ; s < dust.size() ; s++) {
+      fieldSets.push_back(dust[s]->boundary->mpiFieldSet);
+      fluidsVc.push_back(dust[s]->Vc);
+      fluidsVs.push_back(IdefixArray4D<real>());
+    }
+  }
+
+  fluidsMpi = std::make_unique<Mpi>();
+  fluidsMpi->Init(mygrid, fieldSets, nghost, np_int, lbound, rbound);
+  haveCoalescedExchanges = true;
+  #endif
+  idfx::popRegion();
+}
+
+// Same sequence as Boundary::SetBoundaries for each fluid, except that the MPI exchanges
+// of all of the fluids are done at once in each direction.
+void DataBlock::SetBoundariesCoalesced() {
+  idfx::pushRegion("DataBlock::SetBoundariesCoalesced");
+  for(int s = 0 ; s < dust.size() ; s++) {
+    dust[s]->boundary->EnforceInternalBoundary(t);
+  }
+  hydro->boundary->EnforceInternalBoundary(t);
+
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    #ifdef WITH_MPI
+    if(mygrid->nproc[dir]>1) {
+      switch(dir) {
+        case 0:
+          fluidsMpi->ExchangeX1(fluidsVc, fluidsVs);
+          break;
+        case 1:
+          fluidsMpi->ExchangeX2(fluidsVc, fluidsVs);
+          break;
+        case 2:
+          fluidsMpi->ExchangeX3(fluidsVc, fluidsVs);
+          break;
+      }
+    }
+    #endif
+    for(int s = 0 ; s < dust.size() ; s++) {
+      dust[s]->boundary->EnforceBoundaryDir(t, dir);
+    }
+    hydro->boundary->EnforceBoundaryDir(t, dir);
+    #if MHD == YES
+      // Reconstruct the normal field component when using CT
+      hydro->boundary->ReconstructNormalField(dir);
+    #endif
+  }
+
+  #if MHD == YES
+    // Remake the cell-centered field.
+    hydro->boundary->ReconstructVcField(hydro->Vc);
+  #endif
+  idfx::popRegion();
+}
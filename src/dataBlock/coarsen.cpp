@@ -48,6 +48,7 @@ void DataBlock::ComputeGridCoarseningLevels() {
       idfx::popRegion();
       // We check the levels the first time this function is called. After that, there is no check!
       CheckCoarseningLevels();
+      coarseningLevelsRevision++;
     } else {
       IDEFIX_ERROR("Grid coarsening requires the enrollment of a grid coarsening function");
     }
@@ -57,6 +58,7 @@ void DataBlock::ComputeGridCoarseningLevels() {
     idfx::pushRegion("User-defined Coarsening function");
       gridCoarseningFunc(*this);
     idfx::popRegion();
+    coarseningLevelsRevision++;
     levelsHaveBeenComputedOnce = true;
   }
   idfx::popRegion();
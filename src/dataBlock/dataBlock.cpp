@@ -6,8 +6,10 @@
 // ***********************************************************************************
 
 #include <algorithm>
+#include <cmath>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include "idefix.hpp"
 #include "dataBlock.hpp"
 #include "fluid.hpp"
@@ -32,9 +34,8 @@ DataBlock::DataBlock(Grid &grid, Input &input) {
   // Get the number of points from the parent grid object
   for(int dir = 0 ; dir < 3 ; dir++) {
     nghost[dir] = grid.nghost[dir];
-    // Domain decomposition: decompose the full domain size in grid by the number of processes
-    // in that direction
-    np_int[dir] = grid.np_int[dir]/grid.nproc[dir];
+    // Domain decomposition: size of the subdomain of the current process in that direction
+    np_int[dir] = grid.procBeg[dir][grid.xproc[dir]+1] - grid.procBeg[dir][grid.xproc[dir]];
     np_tot[dir] = np_int[dir]+2*nghost[dir];
 
     // Boundary conditions
@@ -56,9 +57,8 @@ DataBlock::DataBlock(Grid &grid, Input &input) {
     end[dir] = grid.nghost[dir]+np_int[dir];
 
     // Where does this datablock starts and end in the grid?
-    // This assumes even distribution of points between procs
-    gbeg[dir] = grid.nghost[dir] + grid.xproc[dir]*np_int[dir];
-    gend[dir] = grid.nghost[dir] + (grid.xproc[dir]+1)*np_int[dir];
+    gbeg[dir] = grid.nghost[dir] + grid.procBeg[dir][grid.xproc[dir]];
+    gend[dir] = gbeg[dir] + np_int[dir];
 
     // Local start and end of current datablock
     xbeg[dir] = gridHost.xl[dir](gbeg[dir]);
@@ -105,6 +105,12 @@ DataBlock::DataBlock(Grid &grid, Input &input) {
   // Initialize the geometry
   this->MakeGeometry();
 
+  // Split the sub-domain in blocks
+  this->InitBlocks(input);
+
+  // Reconstruction weights are computed on demand, once the geometry is known
+  this->reconstructionWeights.Init(this);
+
   // Initialise the state containers
   // (by default, datablock only initialise the current state, which is a reference
   // to arrays in the daughter object
@@ -148,14 +154,53 @@ DataBlock::DataBlock(Grid &grid, Input &input) {
   if(input.CheckBlock("Dust")) {
     haveDust = true;
     int nSpecies = input.Get<int>("Dust","nSpecies",0);
+    std::string storage = input.GetOrSet<std::string>("Dust","storage",0,"separate");
+    if(storage.compare("shared") == 0) {
+      InitDustSharedStorage(input);
+    } else if(storage.compare("separate") != 0) {
+      IDEFIX_ERROR("[Dust]:storage should be either separate or shared");
+    }
     for(int i = 0 ; i < nSpecies ; i++) {
       dust.emplace_back(std::make_unique<Fluid<DustPhysics>>(grid, input, this, i));
     }
+    // Dust sub-cycling
+    haveDustSubcycling = input.GetOrSet<bool>("Dust","subcycling",0,false);
+    if(haveDustSubcycling) {
+      dustSubcyclesMax = input.GetOrSet<int>("Dust","max_subcycles",0,16);
+      if(dustSubcyclesMax < 1) {
+        IDEFIX_ERROR("[Dust]:max_subcycles should be >= 1");
+      }
+      if(dust[0]->haveDrag && !dust[0]->drag->IsImplicit()) {
+        IDEFIX_ERROR("Dust sub-cycling requires an implicit drag "
+                     "(set [Dust]:drag_implicit to yes)");
+      }
+    }
+    dustSubcycles = std::vector<int>(nSpecies, 1);
+    dustDt = std::vector<real>(nSpecies, 0);
+    // Implicit drag, applied to all of the species at once
+    if(dust[0]->haveDrag && dust[0]->drag->IsImplicit()) {
+      implicitDrag = std::make_unique<MultiSpeciesDrag>(input, this);
+    }
+    if(input.GetOrSet<bool>("Dust","concurrent_fluids",0,false)) {
+      InitConcurrentFluids();
+    }
+    if(haveDustSharedStorage) {
+      InitDustFusedKernels();
+    }
+    #ifdef WITH_MPI
+    // Pack the halo exchanges of all of the fluids in the same messages
+    if(idfx::psize > 1 && input.GetOrSet<bool>("Boundary","coalesce_exchanges",0,true)) {
+      InitCoalescedExchanges();
+    }
+    #endif
   }
   // Register variables that need to be saved in case of restart dump
   dump->RegisterVariable(&t, "time");
   dump->RegisterVariable(&dt, "dt");
 
+  // All of the modules have requested their scratch arrays, allocate them
+  scratch.Allocate(input);
+
   idfx::popRegion();
 }
 
@@ -177,9 +222,8 @@ DataBlock::DataBlock(SubGrid *subgrid) {
   // Get the number of points from the parent grid object
   for(int dir = 0 ; dir < 3 ; dir++) {
     nghost[dir] = grid->nghost[dir];
-    // Domain decomposition: decompose the full domain size in grid by the number of processes
-    // in that direction
-    np_int[dir] = grid->np_int[dir]/grid->nproc[dir];
+    // Domain decomposition: size of the subdomain of the current process in that direction
+    np_int[dir] = grid->procBeg[dir][grid->xproc[dir]+1] - grid->procBeg[dir][grid->xproc[dir]];
     np_tot[dir] = np_int[dir]+2*nghost[dir];
 
     // Boundary conditions
@@ -201,9 +245,8 @@ DataBlock::DataBlock(SubGrid *subgrid) {
     end[dir] = grid->nghost[dir]+np_int[dir];
 
     // Where does this datablock starts and end in the grid?
-    // This assumes even distribution of points between procs
-    gbeg[dir] = grid->nghost[dir] + grid->xproc[dir]*np_int[dir];
-    gend[dir] = grid->nghost[dir] + (grid->xproc[dir]+1)*np_int[dir];
+    gbeg[dir] = grid->nghost[dir] + grid->procBeg[dir][grid->xproc[dir]];
+    gend[dir] = gbeg[dir] + np_int[dir];
 
     // Local start and end of current datablock
     xbeg[dir] = gridHost.xl[dir](gbeg[dir]);
@@ -261,7 +304,9 @@ void DataBlock::ResetStage() {
 
 void DataBlock::ConsToPrim() {
   this->hydro->ConvertConsToPrim();
-  if(haveDust) {
+  if(haveDustSharedStorage) {
+    DustConsToPrim();
+  } else if(haveDust) {
     for(int i = 0 ; i < dust.size() ; i++) {
       dust[i]->ConvertConsToPrim();
     }
@@ -270,7 +315,9 @@ void DataBlock::ConsToPrim() {
 
 void DataBlock::PrimToCons() {
   this->hydro->ConvertPrimToCons();
-  if(haveDust) {
+  if(haveDustSharedStorage) {
+    DustPrimToCons();
+  } else if(haveDust) {
     for(int i = 0 ; i < dust.size() ; i++) {
       dust[i]->ConvertPrimToCons();
     }
@@ -291,7 +338,13 @@ void DataBlock::SetBoundaries() {
       }
     }
   }
-  if(haveDust) {
+  if(haveCoalescedExchanges) {
+    SetBoundariesCoalesced();
+    return;
+  }
+  if(haveDustSharedStorage) {
+    SetDustBoundaries();
+  } else if(haveDust) {
     for(int i = 0 ; i < dust.size() ; i++) {
       dust[i]->boundary->SetBoundaries(t);
     }
@@ -310,6 +363,13 @@ void DataBlock::ShowConfig() {
         << "...." << xend[dir] << std::endl;
     }
   }
+  if(nBlocks>1) {
+    idfx::cout << "DataBlock: the fluxes are computed in " << nBlocks << " blocks of ";
+    for(int b = 0 ; b < nBlocks ; b++) {
+      idfx::cout << (b>0 ? ", " : "") << blockBeg[b+1]-blockBeg[b];
+    }
+    idfx::cout << " cells along X" << blockDir+1 << "." << std::endl;
+  }
   hydro->ShowConfig();
   if(haveFargo) fargo->ShowConfig();
   if(haveplanetarySystem) planetarySystem->ShowConfig();
@@ -320,13 +380,39 @@ void DataBlock::ShowConfig() {
                                   << std::endl;
   if(haveDust) {
     idfx::cout << "DataBlock: evolving " << dust.size() << " dust species." << std::endl;
+    if(haveDustSharedStorage) {
+      idfx::cout << "DataBlock: dust species are stored in shared arrays";
+      if(haveDustFusedKernels) {
+        idfx::cout << ", their fluxes being computed by the same kernels";
+      }
+      idfx::cout << "." << std::endl;
+    }
+    if(haveCoalescedExchanges) {
+      idfx::cout << "DataBlock: halo exchanges of all of the fluids are coalesced." << std::endl;
+    }
+    if(haveDustSubcycling) {
+      idfx::cout << "DataBlock: dust species are sub-cycled with at most " << dustSubcyclesMax
+                 << " sub-cycles per stage." << std::endl;
+    }
+    if(haveConcurrentFluids) {
+      idfx::cout << "DataBlock: fluids are evolved concurrently on " << 1+dust.size()
+                 << " execution space instances";
+      if constexpr(std::is_same<Kokkos::DefaultExecutionSpace,
+                                Kokkos::DefaultHostExecutionSpace>::value) {
+        idfx::cout << " (host backend: each fluid runs on its share of the threads, "
+                   << "one fluid after the other)";
+      }
+      idfx::cout << "." << std::endl;
+    }
     // Only show the config the first dust specie
     dust[0]->ShowConfig();
+    if(implicitDrag) implicitDrag->ShowConfig();
     /*
     for(int i = 0 ; i < dust.size() ; i++) {
       dust[i]->ShowConfig();
     }*/
   }
+  scratch.ShowConfig();
 }
 
 
@@ -356,13 +442,36 @@ real DataBlock::ComputeTimestep() {
                   dtmin=FMIN(ONE_F/InvDt(k,j,i),dtmin);
               },
           Kokkos::Min<real>(dtDust));
-      dt = std::min(dt,dtDust);
+      if(haveDustSubcycling) {
+        // Sub-cycled species do not constrain the global timestep
+        dustDt[n] = dtDust;
+      } else {
+        dt = std::min(dt,dtDust);
+      }
     }
   }
   Kokkos::fence();
   return(dt);
 }
 
+// Compute the number of sub-cycles required by each dust specie to follow a timestep newDt,
+// given the CFL number cfl. Returns the (possibly reduced) timestep when max_subcycles is
+// not sufficient to reach newDt. dustDt should have been reduced on all the MPI processes
+// so that all of the processes agree on the number of sub-cycles.
+real DataBlock::ComputeDustSubcycles(real newDt, real cfl) {
+  if(!haveDustSubcycling) return(newDt);
+  for(int n = 0 ; n < dust.size() ; n++) {
+    const real dtMax = cfl*dustDt[n];
+    if(newDt > dustSubcyclesMax*dtMax) newDt = dustSubcyclesMax*dtMax;
+  }
+  for(int n = 0 ; n < dust.size() ; n++) {
+    const real dtMax = cfl*dustDt[n];
+    dustSubcycles[n] = std::max(1, static_cast<int>(std::ceil(newDt/dtMax)));
+    dustSubcycles[n] = std::min(dustSubcycles[n], dustSubcyclesMax);
+  }
+  return(newDt);
+}
+
 // Recompute magnetic fields from vector potential in dedicated fluids
 void DataBlock::DeriveVectorPotential() {
   if constexpr(DefaultPhysics::mhd) {
@@ -20,6 +20,8 @@
 #include "planetarySystem.hpp"
 #include "gravity.hpp"
 #include "stateContainer.hpp"
+#include "scratchArena.hpp"
+#include "reconstructionWeights.hpp"
 
 //////////////////////////////////////////////////////////////////////////////////////////////////
 /// The DataBlock class is designed to store the data and child class instances that belongs to the
@@ -41,6 +43,8 @@ class PlanetarySystem;
 template<typename Phys>
 class Fluid;
 class SubGrid;
+class MultiSpeciesDrag;
+class Mpi;
 class Vtk;
 class Dump;
 
@@ -73,6 +77,8 @@ class DataBlock {
                                                   ///< (only defined when coarsening
                                                   ///< is enabled)
   std::array<bool,3> coarseningDirection;  ///< whether a coarsening is used in each direction
+  bool coarseFluxes{false};   ///< Riemann fluxes only computed on the faces of coarsened cells
+  int coarseningLevelsRevision{0}; ///< Incremented each time the coarsening levels are computed
 
   std::array<real,3> xbeg;             ///< Beginning of active domain in datablock
   std::array<real,3> xend;             ///< End of active domain in datablock
@@ -112,10 +118,45 @@ class DataBlock {
                                 ///< conservative state of the datablock
                                 ///< (contains references to dedicated objects)
 
+  ScratchArena scratch;         ///< temporary arrays of the modules, sharing memory when
+                                ///< their lifetimes don't overlap
+
+  ReconstructionWeights reconstructionWeights; ///< weights of the reconstruction schemes on
+                                               ///< non-regular grids, shared by all fluids
+
   std::unique_ptr<Fluid<DefaultPhysics>> hydro;   ///< The Hydro object attached to this datablock
   bool haveDust{false};
   std::vector<std::unique_ptr<Fluid<DustPhysics>>> dust; ///< Holder for zero pressure dust fluid
 
+  bool haveDustSubcycling{false}; ///< Whether dust species are sub-cycled within each stage
+  int dustSubcyclesMax{16};       ///< Maximum number of sub-cycles allowed for each dust specie
+  std::vector<int> dustSubcycles; ///< Current number of sub-cycles of each dust specie
+  std::vector<real> dustDt;       ///< Maximum timestep (without CFL) of each dust specie
+  std::unique_ptr<MultiSpeciesDrag> implicitDrag; ///< Implicit drag of all of the dust species
+  bool haveConcurrentFluids{false}; ///< Fluids are evolved concurrently on their own instances
+
+  bool haveDustSharedStorage{false}; ///< All of the dust species are stored in the same arrays
+  int dustNvar{0};                ///< Number of variables per dust specie in the shared storage
+  IdefixArray4D<real> dustVc;     ///< Primitive variables of all of the dust species (shared)
+  IdefixArray4D<real> dustUc;     ///< Conservative variables of all of the dust species (shared)
+  IdefixArray4D<flux_real> dustFlux; ///< Riemann fluxes of all of the dust species (shared)
+  IdefixArray4D<real> dustInvDt;  ///< Inverse timestep of each dust specie (shared)
+  IdefixArray4D<real> dustCMax;   ///< Maximum signal speed of each dust specie (shared)
+  bool haveDustFusedKernels{false}; ///< Riemann fluxes and right hand sides of all of the dust
+                                    ///< species computed by the same kernels (shared)
+  bool haveCoalescedExchanges{false}; ///< Halo exchanges of all of the fluids share messages
+  #ifdef WITH_MPI
+  std::unique_ptr<Mpi> dustMpi;   ///< Halo exchange of all of the dust species at once (shared)
+  std::unique_ptr<Mpi> fluidsMpi; ///< Coalesced halo exchange of all of the fluids
+  std::vector<IdefixArray4D<real>> fluidsVc; ///< Cell-centered arrays of the coalesced exchange
+  std::vector<IdefixArray4D<real>> fluidsVs; ///< Face-centered arrays of the coalesced exchange
+  #endif
+
+  int nBlocks{1};                 ///< Number of blocks of the active domain ([Grid] blocksPerRank)
+  int blockDir{IDIR};             ///< Direction along which the active domain is split in blocks
+  std::vector<int> blockBeg;      ///< First index of each block along blockDir (+ last end)
+  void SetActiveBlock(int);       ///< Restrict beg/end to a block (whole domain when <0)
+
   std::unique_ptr<Vtk> vtk;
   std::unique_ptr<Dump> dump;
   #ifdef WITH_HDF5
@@ -131,6 +172,7 @@ class DataBlock {
   void DumpToFile(std::string);   ///< Dump current datablock to a file for inspection
   void Validate();                ///< error out early in case problems are found in IC
   int CheckNan();                 ///< Return the number of cells which have Nans
+  int CountNan();                 ///< Same as CheckNan, for this process only (no reduction)
 
   // The Planetary system
   bool haveplanetarySystem{false};
@@ -138,9 +180,13 @@ class DataBlock {
 
 
   bool rklCycle{false};           ///<  // Set to true when we're inside a RKL call
+  bool hallCycle{false};          ///< Set to true when we're inside the Hall sub-cycles
+  int64_t cycle{0};               ///< Current cycle of the time integrator
 
   void EvolveStage();             ///< Evolve this DataBlock by dt
   void EvolveRKLStage();          ///< Evolve this DataBlock by dt for terms impacted by RKL
+  void EvolveImplicitStage();     ///< Evolve this DataBlock by dt for the implicit terms
+  void EvolveHallStage();         ///< Evolve the field by dt for the sub-cycled Hall effect
   void SetBoundaries();       ///< Enforce boundary conditions to this datablock
   void ConsToPrim();       ///< Convert conservative to primitive variables
   void PrimToCons();       ///< Convert primitive to conservative variables
@@ -148,6 +194,7 @@ class DataBlock {
   void Coarsen();             ///< Coarsen this datablock and its objects
   void ShowConfig();              ///< Show the datablock's configuration
   real ComputeTimestep();         ///< compute maximum timestep from current state of affairs
+  real ComputeDustSubcycles(real, real); ///< Compute the number of dust sub-cycles for a new dt
 
   void ResetStage();              ///< Reset the variables needed at each major integration Stage
 
@@ -172,7 +219,19 @@ class DataBlock {
 
  private:
   void WriteVariable(FILE* , int , int *, char *, void*);
+  void EvolveDustSubcycles(int);        ///< Evolve a dust specie with its own sub-cycles
+  void InitDustSharedStorage(Input &);  ///< Allocate the arrays shared by all dust species
+  void InitDustFusedKernels();          ///< Compute all dust species in the same kernels
+  void DustConsToPrim();                ///< ConsToPrim of all dust species (shared storage)
+  void DustPrimToCons();                ///< PrimToCons of all dust species (shared storage)
+  void SetDustBoundaries();             ///< Boundaries of all dust species (shared storage)
+  void InitCoalescedExchanges();        ///< Init the coalesced halo exchanges of all fluids
+  void InitConcurrentFluids();          ///< Partition the execution space between the fluids
+  void SetBoundariesCoalesced();        ///< Boundaries of all fluids with coalesced exchanges
   void ComputeGridCoarseningLevels();   ///< Call user defined function to define Coarsening levels
+  void InitBlocks(Input &);             ///< Split the active domain in blocks
+  BoundaryType domainLbound;            ///< Left boundary of the whole domain along blockDir
+  BoundaryType domainRbound;            ///< Right boundary of the whole domain along blockDir
 
   // User Steps (either before or after the main integration loop)
   bool haveUserStepFirst{false};
@@ -0,0 +1,178 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <memory>
+#include <vector>
+#include "idefix.hpp"
+#include "dataBlock.hpp"
+#include "fluid.hpp"
+#include "convertConsToPrim.hpp"
+#ifdef WITH_MPI
+#include "mpi.hpp"
+#endif
+
+// Allocate the arrays holding all of the dust species at once. Each specie is a contiguous
+// slice of dustNvar variables of these arrays, so that operations which do not depend on the
+// specie (state copies, conversions, halo exchanges) are done once for all of the species.
+void DataBlock::InitDustSharedStorage(Input &input) {
+  idfx::pushRegion("DataBlock::InitDustSharedStorage");
+  haveDustSharedStorage = true;
+  const int nSpecies = input.Get<int>("Dust","nSpecies",0);
+  dustNvar = DustPhysics::nvar;
+  if(input.CheckEntry("Dust","tracer")>=0) {
+    dustNvar += input.Get<int>("Dust","tracer",0);
+  }
+
+  dustVc = IdefixArray4D<real>("Dust_Vc", nSpecies*dustNvar,
+                               np_tot[KDIR], np_tot[JDIR], np_tot[IDIR]);
+  dustUc = IdefixArray4D<real>("Dust_Uc", nSpecies*dustNvar,
+                               np_tot[KDIR], np_tot[JDIR], np_tot[IDIR]);
+
+  dustFlux = IdefixArray4D<flux_real>("Dust_FluxRiemann", nSpecies*dustNvar,
+                                      np_tot[KDIR], np_tot[JDIR], np_tot[IDIR]);
+  dustInvDt = IdefixArray4D<real>("Dust_InvDt", nSpecies,
+                                  np_tot[KDIR], np_tot[JDIR], np_tot[IDIR]);
+  dustCMax = IdefixArray4D<real>("Dust_cMax", nSpecies,
+                                 np_tot[KDIR], np_tot[JDIR], np_tot[IDIR]);
+
+  // The conservative variables of all of the species form a single state
+  states["current"].PushArray(dustUc, State::center, "Dust_Uc");
+
+  #ifdef WITH_MPI
+  // All of the variables of all of the species are exchanged in the same message
+  std::vector<int> mapVars;
+  for(int n = 0 ; n < nSpecies*dustNvar ; n++) {
+    mapVars.push_back(n);
+  }
+  dustMpi = std::make_unique<Mpi>();
+  dustMpi->Init(mygrid, mapVars, nghost, np_int, lbound, rbound);
+  #endif
+  idfx::popRegion();
+}
+
+// Let the first dust specie compute the Riemann fluxes and the right hand sides of all of the
+// species, each kernel looping over the species. The species which are sub-cycled (each with
+// its own timestep), evolved on their own execution space instance, or which require
+// per-specie kernels (coarsened or parabolic fluxes) keep being evolved one by one.
+void DataBlock::InitDustFusedKernels() {
+  if(dust.size() < 2) return;
+  if(haveDustSubcycling || haveConcurrentFluids) return;
+  if(haveGridCoarsening != GridCoarsening::disabled) return;
+  if(dust[0]->haveExplicitParabolicTerms) return;
+
+  haveDustFusedKernels = true;
+  dust[0]->nFusedSpecies = dust.size();
+  for(int s = 1 ; s < dust.size() ; s++) {
+    dust[s]->nFusedSpecies = 0;
+  }
+}
+
+void DataBlock::DustConsToPrim() {
+  idfx::pushRegion("DataBlock::DustConsToPrim");
+  IdefixArray4D<real> Vc = dustVc;
+  IdefixArray4D<real> Uc = dustUc;
+  const int nv = dustNvar;
+  const int nSpecies = dust.size();
+  EquationOfState eos;  // Not used by pressureless fluids
+
+  idfx::annotateKernel("DustConsToPrim", nSpecies*2*DustPhysics::nvar*sizeof(real));
+  idefix_for("DustConsToPrim",
+             0,nSpecies,
+             0,np_tot[KDIR],
+             0,np_tot[JDIR],
+             0,np_tot[IDIR],
+    KOKKOS_LAMBDA (int s, int k, int j, int i) {
+      real U[DustPhysics::nvar];
+      real V[DustPhysics::nvar];
+      const int n0 = s*nv;
+
+#pragma unroll
+      for(int n = 0 ; n < DustPhysics::nvar; n++) {
+        U[n] = Uc(n0+n,k,j,i);
+      }
+
+      K_ConsToPrim<DustPhysics>(V,U,&eos);
+
+#pragma unroll
+      for(int n = 0 ; n < DustPhysics::nvar; n++) {
+        Vc(n0+n,k,j,i) = V[n];
+      }
+    });
+
+  for(int s = 0 ; s < dust.size() ; s++) {
+    if(dust[s]->haveTracer) dust[s]->tracer->ConvertConsToPrim();
+  }
+  idfx::popRegion();
+}
+
+void DataBlock::DustPrimToCons() {
+  idfx::pushRegion("DataBlock::DustPrimToCons");
+  IdefixArray4D<real> Vc = dustVc;
+  IdefixArray4D<real> Uc = dustUc;
+  const int nv = dustNvar;
+  const int nSpecies = dust.size();
+  EquationOfState eos;  // Not used by pressureless fluids
+
+  idfx::annotateKernel("DustPrimToCons", nSpecies*2*DustPhysics::nvar*sizeof(real));
+  idefix_for("DustPrimToCons",
+             0,nSpecies,
+             0,np_tot[KDIR],
+             0,np_tot[JDIR],
+             0,np_tot[IDIR],
+    KOKKOS_LAMBDA (int s, int k, int j, int i) {
+      real U[DustPhysics::nvar];
+      real V[DustPhysics::nvar];
+      const int n0 = s*nv;
+
+#pragma unroll
+      for(int n = 0 ; n < DustPhysics::nvar; n++) {
+        V[n] = Vc(n0+n,k,j,i);
+      }
+
+      K_PrimToCons<DustPhysics>(U,V,&eos);
+
+#pragma unroll
+      for(int n = 0 ; n < DustPhysics::nvar; n++) {
+        Uc(n0+n,k,j,i) = U[n];
+      }
+    });
+
+  for(int s = 0 ; s < dust.size() ; s++) {
+    if(dust[s]->haveTracer) dust[s]->tracer->ConvertPrimToCons();
+  }
+  idfx::popRegion();
+}
+
+// Same sequence as Boundary::SetBoundaries, but the MPI exchanges are done once for all
+// of the dust species
+void DataBlock::SetDustBoundaries() {
+  idfx::pushRegion("DataBlock::SetDustBoundaries");
+  for(int s = 0 ; s < dust.size() ; s++) {
+    dust[s]->boundary->EnforceInternalBoundary(t);
+  }
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    #ifdef WITH_MPI
+    if(mygrid->nproc[dir]>1) {
+      switch(dir) {
+        case 0:
+          dustMpi->ExchangeX1(dustVc);
+          break;
+        case 1:
+          dustMpi->ExchangeX2(dustVc);
+          break;
+        case 2:
+          dustMpi->ExchangeX3(dustVc);
+          break;
+      }
+    }
+    #endif
+    for(int s = 0 ; s < dust.size() ; s++) {
+      dust[s]->boundary->EnforceBoundaryDir(t, dir);
+    }
+  }
+  idfx::popRegion();
+}
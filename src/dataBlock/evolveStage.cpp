@@ -8,36 +8,121 @@
 #include "../idefix.hpp"
 #include "dataBlock.hpp"
 #include "fluid.hpp"
+#include "fargo.hpp"
 
 // Evolve one step forward in time of hydro
 void DataBlock::EvolveStage() {
   idfx::pushRegion("DataBlock::EvolveStage");
+  scratch.Acquire(ScratchArena::stagePhase);
+
+  // With concurrent fluids, the instances of the fluids start from the state prepared on
+  // the default instance
+  if(haveConcurrentFluids) Kokkos::DefaultExecutionSpace().fence("DataBlock::EvolveStage");
 
   hydro->EvolveStage(this->t,this->dt);
 
   if(haveDust) {
     for(int i = 0 ; i < dust.size() ; i++) {
-      dust[i]->EvolveStage(this->t,this->dt);
+      if(haveDustSubcycling) {
+        EvolveDustSubcycles(i);
+      } else {
+        dust[i]->EvolveStage(this->t,this->dt);
+      }
     }
-    // Add implicit term for dust drag
-    if(dust[0]->drag->IsImplicit()) {
+    if(haveConcurrentFluids) {
+      // Join the fluids before the terms which couple them
+      hydro->execSpace.fence("DataBlock::EvolveStage");
       for(int i = 0 ; i < dust.size() ; i++) {
-        dust[i]->drag->AddImplicitBackReaction(this->dt,dust[0]->drag->implicitFactor);
+        dust[i]->execSpace.fence("DataBlock::EvolveStage");
       }
-      dust[0]->drag->NormalizeImplicitBackReaction(this->dt);
+      // Explicit drag with feedback, which updates the gas: deferred by Fluid::EvolveStage
+      // and applied in the order of the species, as in the sequential case
       for(int i = 0 ; i < dust.size() ; i++) {
-        dust[i]->drag->AddImplicitFluidMomentum(this->dt);
+        if(dust[i]->haveDrag && !dust[i]->drag->IsImplicit() && dust[i]->drag->HasFeedback()) {
+          dust[i]->drag->AddDragForce(this->dt);
+        }
       }
     }
+    // Add implicit term for dust drag
+    if(implicitDrag) {
+      implicitDrag->AddImplicitDrag(this->dt);
+    }
   }
 
   idfx::popRegion();
 }
 
+// Give each fluid its own execution space instance, so that the kernels of the different
+// fluids, which are independent until the drag, may overlap on the device. On host backends,
+// the instances are partitions of the threads of the process.
+void DataBlock::InitConcurrentFluids() {
+  std::vector<int> weights(1+dust.size(), 1);
+  auto spaces = Kokkos::Experimental::partition_space(Kokkos::DefaultExecutionSpace(), weights);
+  hydro->execSpace = spaces[0];
+  for(int i = 0 ; i < dust.size() ; i++) {
+    dust[i]->execSpace = spaces[i+1];
+  }
+  haveConcurrentFluids = true;
+}
+
 void DataBlock::EvolveRKLStage() {
   idfx::pushRegion("DataBlock::EvolveRKLStage");
   if(hydro->haveRKLParabolicTerms) {
+    scratch.Acquire(ScratchArena::rklPhase);
     hydro->rkl->Cycle();
   }
   idfx::popRegion();
 }
+
+void DataBlock::EvolveImplicitStage() {
+  idfx::pushRegion("DataBlock::EvolveImplicitStage");
+  if(hydro->haveImplicitParabolicTerms) {
+    // The implicit step needs the ghost zones of the state reached at the end of the stages
+    hydro->boundary->SetBoundaries(this->t);
+    hydro->UpdateDiffusivities(this->t, ImplicitContext);
+    hydro->thermalDiffusion->AddImplicitDiffusion(this->t, this->dt);
+  }
+  idfx::popRegion();
+}
+
+void DataBlock::EvolveHallStage() {
+  idfx::pushRegion("DataBlock::EvolveHallStage");
+  if(hydro->hallStatus.isSubcycled) {
+    // The Hall EMFs use the scratch arrays of the stages
+    scratch.Acquire(ScratchArena::stagePhase);
+    // The sub-cycles start from the state reached at the end of the stages
+    hydro->boundary->SetBoundaries(this->t);
+    hydro->UpdateDiffusivities(this->t, HallContext);
+    hydro->EvolveHallSubcycles(this->t, this->dt);
+  }
+  idfx::popRegion();
+}
+
+// Evolve dust specie n by dt using dustSubcycles[n] sub-cycles of dt/dustSubcycles[n]
+// The gas is frozen during the sub-cycles, the coupling through the (implicit) drag being
+// applied at the end of the stage, once all of the fluids are synchronised.
+void DataBlock::EvolveDustSubcycles(int n) {
+  idfx::pushRegion("DataBlock::EvolveDustSubcycles");
+  Fluid<DustPhysics> *fluid = dust[n].get();
+  // The sub-cycles, boundaries included, run on the instance of the specie
+  idfx::ExecSpaceScope execSpaceScope(fluid->execSpace);
+  const int nSub = dustSubcycles[n];
+  const real dtSub = this->dt/nSub;
+
+  for(int s = 0 ; s < nSub ; s++) {
+    const real tSub = this->t + s*dtSub;
+    if(s>0) {
+      // Update the primitive variables and the boundaries from the previous sub-cycle
+      fluid->ConvertConsToPrim();
+      if(haveFargo) fargo->AddVelocityFluid(tSub, fluid);
+      if(haveGridCoarsening) fluid->CoarsenFlow(fluid->Vc);
+      fluid->boundary->SetBoundaries(tSub);
+      if(haveFargo) fargo->SubstractVelocityFluid(tSub, fluid);
+      fluid->ConvertPrimToCons();
+      // Only keep the timestep constraint of the last sub-cycle
+      fluid->ResetStage();
+    }
+    fluid->EvolveStage(tSub, dtSub);
+  }
+  idfx::popRegion();
+}
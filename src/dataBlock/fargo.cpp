@@ -13,6 +13,7 @@
 #include "fluid.hpp"
 #include "dataBlock.hpp"
 #include "fargo.hpp"
+#include "reductionManager.hpp"
 
 
 
@@ -113,14 +114,17 @@ Fargo::Fargo(Input &input, int nmax, DataBlock *data) {
     }
   }
 
-  this->scrhUc = IdefixArray4D<real>("FargoVcScratchSpace",nvar
+  // The scratch space is only used while the solution is shifted, so that it can share memory
+  // with the scratch arrays of the other phases
+  data->scratch.Request(this->scrhUc, "FargoVcScratchSpace", ScratchArena::fargoPhase, nvar
                                       ,end[KDIR]-beg[KDIR] + 2*nghost[KDIR]
                                       ,end[JDIR]-beg[JDIR] + 2*nghost[JDIR]
                                       ,end[IDIR]-beg[IDIR] + 2*nghost[IDIR]);
 
   #if MHD == YES
     if(haveDomainDecomposition) {
-      this->scrhVs = IdefixArray4D<real>("FargoVsScratchSpace",DIMENSIONS
+      data->scratch.Request(this->scrhVs, "FargoVsScratchSpace", ScratchArena::fargoPhase
+                                          ,DIMENSIONS
                                           ,end[KDIR]-beg[KDIR] + 2*nghost[KDIR]+KOFFSET
                                           ,end[JDIR]-beg[JDIR] + 2*nghost[JDIR]+JOFFSET
                                           ,end[IDIR]-beg[IDIR] + 2*nghost[IDIR]+IOFFSET);
@@ -255,11 +259,7 @@ void Fargo::CheckMaxDisplacement() {
         invDtLoc = FMAX(invDtLoc, FABS(w/dphi));
       },
       Kokkos::Max<real>(invDt));
-  #ifdef WITH_MPI
-    if(idfx::psize>1) {
-          MPI_SAFE_CALL(MPI_Allreduce(MPI_IN_PLACE, &invDt, 1, realMPI, MPI_MAX, MPI_COMM_WORLD));
-        }
-  #endif
+  invDt = idfx::reductions.Reduce(invDt, idfx::ReductionManager::max);
   this->dtMax = this->maxShift / invDt;
 }
 
@@ -291,6 +291,7 @@ void Fargo::SubstractVelocity(const real t) {
 
 void Fargo::ShiftSolution(const real t, const real dt) {
   idfx::pushRegion("Fargo::ShiftFluid");
+  data->scratch.Acquire(ScratchArena::fargoPhase);
 
   this->ShiftFluid(t,dt,data->hydro.get());
   if(data->haveDust) {
@@ -21,6 +21,7 @@ void DataBlock::MakeGeometry() {
   if(mygrid->haveGridCoarsening != GridCoarsening::disabled) {
     this->haveGridCoarsening = mygrid->haveGridCoarsening;
     this->coarseningDirection = mygrid->coarseningDirection;
+    this->coarseFluxes = mygrid->coarseFluxes;
 
     for(int dir = 0 ; dir < 3 ; dir++) {
       if(coarseningDirection[dir]) {
@@ -11,6 +11,7 @@
 #include "dataBlock.hpp"
 #include "planetarySystem.hpp"
 #include "fluid.hpp"
+#include "reductionManager.hpp"
 /*
 Planet::Planet() :
     m_vxp(state.vx),
@@ -251,10 +252,14 @@ void Planet::updateMp(const real t) {
 }
 
 Point Planet::computeAccel(DataBlock& data, bool& isPlanet) {
-  Point acceleration;
-  Force &force = this->m_force;
-//  Force &force = data.planet[0].force;
   computeForce(data,isPlanet);
+  idfx::reductions.Flush();
+  return getAccel();
+}
+
+Point Planet::getAccel() const {
+  Point acceleration;
+  const Force &force = this->m_force;
   bool excludeHill = pSys->excludeHill;
   if (excludeHill) {
     acceleration.x = force.f_ex_inner[0]+force.f_ex_outer[0];
@@ -419,33 +424,9 @@ void Planet::computeForce(DataBlock& data, bool& isPlanet) {
     }
   }
 
-  #ifdef WITH_MPI
-    real forceGlob[12];
-    real forceLoc[12];
-    forceLoc[0] = this->m_force.f_inner[0];
-    forceLoc[1] = this->m_force.f_inner[1];
-    forceLoc[2] = this->m_force.f_inner[2];
-    forceLoc[3] = this->m_force.f_ex_inner[0];
-    forceLoc[4] = this->m_force.f_ex_inner[1];
-    forceLoc[5] = this->m_force.f_ex_inner[2];
-    forceLoc[6] = this->m_force.f_outer[0];
-    forceLoc[7] = this->m_force.f_outer[1];
-    forceLoc[8] = this->m_force.f_outer[2];
-    forceLoc[9] = this->m_force.f_ex_outer[0];
-    forceLoc[10] = this->m_force.f_ex_outer[1];
-    forceLoc[11] = this->m_force.f_ex_outer[2];
-    MPI_SAFE_CALL(MPI_Allreduce(&forceLoc, &forceGlob, 12, realMPI, MPI_SUM, MPI_COMM_WORLD));
-    this->m_force.f_inner[0] = forceGlob[0];
-    this->m_force.f_inner[1] = forceGlob[1];
-    this->m_force.f_inner[2] = forceGlob[2];
-    this->m_force.f_ex_inner[0] = forceGlob[3];
-    this->m_force.f_ex_inner[1] = forceGlob[4];
-    this->m_force.f_ex_inner[2] = forceGlob[5];
-    this->m_force.f_outer[0] = forceGlob[6];
-    this->m_force.f_outer[1] = forceGlob[7];
-    this->m_force.f_outer[2] = forceGlob[8];
-    this->m_force.f_ex_outer[0] = forceGlob[9];
-    this->m_force.f_ex_outer[1] = forceGlob[10];
-    this->m_force.f_ex_outer[2] = forceGlob[11];
-  #endif
+  // The global sum is queued, and completes at the next flush of the reductions
+  idfx::reductions.Add(m_force.f_inner, 3, idfx::ReductionManager::sum);
+  idfx::reductions.Add(m_force.f_ex_inner, 3, idfx::ReductionManager::sum);
+  idfx::reductions.Add(m_force.f_outer, 3, idfx::ReductionManager::sum);
+  idfx::reductions.Add(m_force.f_ex_outer, 3, idfx::ReductionManager::sum);
 }
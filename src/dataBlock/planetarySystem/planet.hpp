@@ -47,7 +47,8 @@ class Planet {
     void activatePlanet(const real);
     // refresh the force
     Point computeAccel(DataBlock&, bool&);
-    void computeForce(DataBlock&, bool&);
+    void computeForce(DataBlock&, bool&);   // global sum queued in idfx::reductions
+    Point getAccel() const;                 // acceleration from the last computed force
 
  protected:
     friend class PlanetarySystem;
@@ -13,6 +13,7 @@
 #include "dataBlock.hpp"
 #include "fluid.hpp"
 #include "gravity.hpp"
+#include "reductionManager.hpp"
 
 
 PlanetarySystem::PlanetarySystem(Input &input, DataBlock *datain) {
@@ -170,21 +171,18 @@ void PlanetarySystem::EvolveSystem(DataBlock& data, const real& dt) {
 
 void PlanetarySystem::AdvancePlanetFromDisk(DataBlock& data, const real& dt) {
   idfx::pushRegion("PlanetarySystem::AdvancePlanetFromDisk");
+  // Compute the forces of all the planets first, so that they are summed over the processes in
+  // a single reduction
   for(int ip=0; ip< this->nbp ; ip++) {
     if (!(planet[ip].m_isActive)) continue;
-    Point gamma;
     bool isp = true;
+    planet[ip].computeForce(data, isp);
+  }
+  idfx::reductions.Flush();
 
-    real qp = planet[ip].m_qp;
-    real xp = planet[ip].m_xp;
-    real yp = planet[ip].m_yp;
-    real zp = planet[ip].m_zp;
-    real vxp = planet[ip].m_vxp;
-    real vyp = planet[ip].m_vyp;
-    real vzp = planet[ip].m_vzp;
-    real r = sqrt(xp*xp + yp*yp + zp*zp);
-
-    gamma = planet[ip].computeAccel (data, isp);
+  for(int ip=0; ip< this->nbp ; ip++) {
+    if (!(planet[ip].m_isActive)) continue;
+    Point gamma = planet[ip].getAccel();
 
     planet[ip].m_vxp += dt * gamma.x*this->torqueNormalization;
     planet[ip].m_vyp += dt * gamma.y*this->torqueNormalization;
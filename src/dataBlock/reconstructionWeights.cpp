@@ -0,0 +1,157 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <string>
+
+#include "reconstructionWeights.hpp"
+#include "dataBlock.hpp"
+
+// Coefficients c[j] of the interpolation at x of the polynomial of degree n-1 whose averages
+// over the n cells delimited by the edges e[0..n] are the cell averages (Shu 1998, eq. 2.20)
+template<int n>
+KOKKOS_INLINE_FUNCTION void InterpolationWeights(const real e[], const real x, real c[]) {
+  for(int j = 0 ; j < n ; j++) {
+    c[j] = 0;
+    for(int m = j+1 ; m <= n ; m++) {
+      // Derivative at x of the m-th Lagrange polynomial of the edges
+      real num = 0;
+      real den = 1;
+      for(int l = 0 ; l <= n ; l++) {
+        if(l == m) continue;
+        real prod = 1;
+        for(int q = 0 ; q <= n ; q++) {
+          if(q != m && q != l) prod *= x - e[q];
+        }
+        num += prod;
+        den *= e[m] - e[l];
+      }
+      c[j] += num/den;
+    }
+    c[j] *= e[j+1] - e[j];
+  }
+}
+
+void ReconstructionWeights::Init(DataBlock *datain) {
+  this->data = datain;
+}
+
+const ReconstructionWeights::PLM &ReconstructionWeights::GetPLM(int dir) {
+  if(!havePLM[dir]) ComputePLM(dir);
+  return(plm[dir]);
+}
+
+IdefixArray2D<real> ReconstructionWeights::GetPPM(int dir) {
+  if(!havePPM[dir]) ComputePPM(dir);
+  return(ppm[dir]);
+}
+
+IdefixArray2D<real> ReconstructionWeights::GetHighOrder(int dir) {
+  if(!haveHighOrder[dir]) ComputeHighOrder(dir);
+  return(highOrder[dir]);
+}
+
+void ReconstructionWeights::ComputePLM(int dir) {
+  idfx::pushRegion("ReconstructionWeights::ComputePLM");
+  const std::string suffix = std::to_string(dir);
+  const int n = data->np_tot[dir];
+  plm[dir].cp = IdefixArray1D<real>("ReconstructionWeights_cp"+suffix,n);
+  plm[dir].cm = IdefixArray1D<real>("ReconstructionWeights_cm"+suffix,n);
+  plm[dir].dp = IdefixArray1D<real>("ReconstructionWeights_dp"+suffix,n);
+  plm[dir].dm = IdefixArray1D<real>("ReconstructionWeights_dm"+suffix,n);
+  plm[dir].wp = IdefixArray1D<real>("ReconstructionWeights_wp"+suffix,n);
+  plm[dir].wm = IdefixArray1D<real>("ReconstructionWeights_wm"+suffix,n);
+
+  auto dx = data->dx[dir];
+  auto xgc = data->xgc[dir];
+  auto xr = data->xr[dir];
+  auto wp = plm[dir].wp;
+  auto wm = plm[dir].wm;
+  auto cp = plm[dir].cp;
+  auto cm = plm[dir].cm;
+  auto dp = plm[dir].dp;
+  auto dm = plm[dir].dm;
+
+  idefix_for("ComputePLMweights",1,n-1,
+              KOKKOS_LAMBDA(const int i) {
+                wp(i) = dx(i) / (xgc(i+1) - xgc(i));
+                wm(i) = dx(i) / (xgc(i) - xgc(i-1));
+                cp(i) = (xgc(i+1) - xgc(i)) / (xr(i) - xgc(i));
+                cm(i) = (xgc(i) - xgc(i-1)) / (xgc(i) - xr(i-1));
+                dp(i) = (xr(i) - xgc(i)) / dx(i);
+                dm(i) = (xgc(i) - xr(i-1)) / dx(i);
+              });
+  havePLM[dir] = true;
+  idfx::popRegion();
+}
+
+void ReconstructionWeights::ComputePPM(int dir) {
+  idfx::pushRegion("ReconstructionWeights::ComputePPM");
+  const int n = data->np_tot[dir];
+  ppm[dir] = IdefixArray2D<real>("ReconstructionWeights_ppm"+std::to_string(dir),
+                                 n, nPPMWeights);
+
+  auto xl = data->xl[dir];
+  auto xr = data->xr[dir];
+  auto w = ppm[dir];
+
+  idefix_for("ComputePPMweights",1,n-2,
+              KOKKOS_LAMBDA(const int i) {
+                // Edges of the cells i-1 to i+2
+                real e[5];
+                for(int m = 0 ; m < 4 ; m++) e[m] = xl(i-1+m);
+                e[4] = xr(i+2);
+
+                real c[nPPMWeights];
+                InterpolationWeights<4>(e, xr(i), c);
+                for(int m = 0 ; m < nPPMWeights ; m++) w(i,m) = c[m];
+              });
+  havePPM[dir] = true;
+  idfx::popRegion();
+}
+
+void ReconstructionWeights::ComputeHighOrder(int dir) {
+  idfx::pushRegion("ReconstructionWeights::ComputeHighOrder");
+  const int n = data->np_tot[dir];
+  highOrder[dir] = IdefixArray2D<real>("ReconstructionWeights_ho"+std::to_string(dir),
+                                       n, 2*nFaceWeights);
+
+  auto xl = data->xl[dir];
+  auto xr = data->xr[dir];
+  auto w = highOrder[dir];
+
+  idefix_for("ComputeHighOrderWeights",2,n-2,
+              KOKKOS_LAMBDA(const int i) {
+                // Edges of the cells i-2 to i+2
+                real e[6];
+                for(int m = 0 ; m < 5 ; m++) e[m] = xl(i-2+m);
+                e[5] = xr(i+2);
+
+                // Right face, then left face
+                for(int face = 0 ; face < 2 ; face++) {
+                  const real x = (face == 0) ? xr(i) : xl(i);
+                  const int offset = face*nFaceWeights;
+                  real c[9];
+                  real c5[5];
+                  for(int st = 0 ; st < 3 ; st++) {
+                    InterpolationWeights<3>(e+st, x, c+3*st);
+                  }
+                  InterpolationWeights<5>(e, x, c5);
+
+                  // Linear weights: the 5th order interpolation is recovered from the
+                  // outermost coefficients, which belong to a single stencil
+                  const real d0 = c5[0]/c[0];
+                  const real d2 = c5[4]/c[8];
+                  for(int m = 0 ; m < 9 ; m++) w(i,offset+m) = c[m];
+                  w(i,offset+9) = d0;
+                  w(i,offset+10) = ONE_F - d0 - d2;
+                  w(i,offset+11) = d2;
+                  for(int m = 0 ; m < 5 ; m++) w(i,offset+12+m) = c5[m];
+                }
+              });
+  haveHighOrder[dir] = true;
+  idfx::popRegion();
+}
@@ -0,0 +1,65 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef DATABLOCK_RECONSTRUCTIONWEIGHTS_HPP_
+#define DATABLOCK_RECONSTRUCTIONWEIGHTS_HPP_
+
+#include <array>
+
+#include "idefix.hpp"
+
+class DataBlock;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+/// The ReconstructionWeights class holds the weights of the reconstruction schemes on grids
+/// which are not regular cartesian grids (stretched grids or curvilinear coordinates).
+/// These weights only depend on the grid, so they are computed once per direction, when first
+/// requested, and shared by the extrapolators of all of the fluids (gas and dust species)
+/// attached to the DataBlock.
+//////////////////////////////////////////////////////////////////////////////////////////////////
+class ReconstructionWeights {
+ public:
+  // PLM weights (Mignone 2014, eqs. 29-33)
+  struct PLM {
+    IdefixArray1D<real> cp;
+    IdefixArray1D<real> cm;
+    IdefixArray1D<real> dp;
+    IdefixArray1D<real> dm;
+    IdefixArray1D<real> wp;
+    IdefixArray1D<real> wm;
+  };
+
+  // PPM: 4th order interpolation of the right face of cell i from the cells i-1..i+2
+  static constexpr int nPPMWeights = 4;
+
+  // 5th order schemes, for each face (right, then left) of cell i: the interpolations of the
+  // 3rd order stencils (-2,-1,0), (-1,0,1) and (0,1,2), their linear weights, and the 5th order
+  // interpolation on (-2..2)
+  static constexpr int nFaceWeights = 17;
+
+  void Init(DataBlock *);
+  const PLM &GetPLM(int);                   ///< PLM weights in direction dir
+  IdefixArray2D<real> GetPPM(int);          ///< PPM weights (np_tot[dir], nPPMWeights)
+  IdefixArray2D<real> GetHighOrder(int);    ///< 5th order weights (np_tot[dir], 2*nFaceWeights)
+
+ private:
+  void ComputePLM(int);
+  void ComputePPM(int);
+  void ComputeHighOrder(int);
+
+  DataBlock *data{nullptr};
+
+  std::array<PLM,3> plm;
+  std::array<IdefixArray2D<real>,3> ppm;
+  std::array<IdefixArray2D<real>,3> highOrder;
+
+  std::array<bool,3> havePLM{false, false, false};
+  std::array<bool,3> havePPM{false, false, false};
+  std::array<bool,3> haveHighOrder{false, false, false};
+};
+
+#endif // DATABLOCK_RECONSTRUCTIONWEIGHTS_HPP_
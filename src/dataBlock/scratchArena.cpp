@@ -0,0 +1,182 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <vector>
+#include "scratchArena.hpp"
+
+void ScratchArena::Request(IdefixArray3D<real> &array, const std::string &name, int lifetime,
+                           int n0, int n1, int n2) {
+  Entry entry;
+  entry.name = name;
+  entry.lifetime = lifetime;
+  entry.rank = 3;
+  entry.extent = {n0, n1, n2, 1};
+  entry.size = static_cast<size_t>(n0)*n1*n2;
+  entry.array3D = &array;
+  if(lifetime == 0) {
+    IDEFIX_ERROR("ScratchArena: the scratch array "+name+" has an empty lifetime");
+  }
+  if(isAllocated) {
+    // Late request: the array gets its own allocation
+    array = IdefixArray3D<real>(name, n0, n1, n2);
+  }
+  entries.push_back(entry);
+}
+
+void ScratchArena::Request(IdefixArray4D<real> &array, const std::string &name, int lifetime,
+                           int n0, int n1, int n2, int n3) {
+  Entry entry;
+  entry.name = name;
+  entry.lifetime = lifetime;
+  entry.rank = 4;
+  entry.extent = {n0, n1, n2, n3};
+  entry.size = static_cast<size_t>(n0)*n1*n2*n3;
+  entry.array4D = &array;
+  if(lifetime == 0) {
+    IDEFIX_ERROR("ScratchArena: the scratch array "+name+" has an empty lifetime");
+  }
+  if(isAllocated) {
+    // Late request: the array gets its own allocation
+    array = IdefixArray4D<real>(name, n0, n1, n2, n3);
+  }
+  entries.push_back(entry);
+}
+
+// First-fit placement of the entries, largest first. An entry only has to avoid the address
+// ranges of the entries it shares at least one phase with.
+void ScratchArena::PlaceEntries() {
+  std::vector<int> order(entries.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [this](int a, int b) { return entries[a].size > entries[b].size; });
+
+  std::vector<int> placed;
+  poolSize = 0;
+  for(int n : order) {
+    Entry &entry = entries[n];
+    // Entries which can't share memory with this one
+    std::vector<int> conflicts;
+    for(int m : placed) {
+      if(!aliasing || (entries[m].lifetime & entry.lifetime)) conflicts.push_back(m);
+    }
+    // Candidate offsets: the start of the pool, and the (aligned) end of each conflict
+    std::vector<size_t> candidates(1, 0);
+    for(int m : conflicts) {
+      const size_t end = entries[m].offset + entries[m].size;
+      candidates.push_back(((end + alignment - 1)/alignment)*alignment);
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    for(size_t offset : candidates) {
+      bool fits = true;
+      for(int m : conflicts) {
+        if(offset < entries[m].offset + entries[m].size &&
+           entries[m].offset < offset + entry.size) {
+          fits = false;
+          break;
+        }
+      }
+      if(fits) {
+        entry.offset = offset;
+        break;
+      }
+    }
+    poolSize = std::max(poolSize, entry.offset + entry.size);
+    placed.push_back(n);
+  }
+
+  // Entries sharing memory (which, by construction, never share a phase)
+  for(int n = 0 ; n < entries.size() ; n++) {
+    for(int m = 0 ; m < entries.size() ; m++) {
+      if(m != n && entries[n].offset < entries[m].offset + entries[m].size &&
+                   entries[m].offset < entries[n].offset + entries[n].size) {
+        entries[n].overlaps.push_back(m);
+      }
+    }
+  }
+}
+
+void ScratchArena::Bind(Entry &entry) {
+  real *ptr = pool.data() + entry.offset;
+  entry.pooled = true;
+  // Views built from a pointer are unmanaged: the pool keeps ownership of the memory
+  if(entry.rank == 3) {
+    *entry.array3D = IdefixArray3D<real>(ptr, entry.extent[0], entry.extent[1],
+                                              entry.extent[2]);
+  } else {
+    *entry.array4D = IdefixArray4D<real>(ptr, entry.extent[0], entry.extent[1],
+                                              entry.extent[2], entry.extent[3]);
+  }
+}
+
+void ScratchArena::Zero(Entry &entry) {
+  if(entry.rank == 3) {
+    Kokkos::deep_copy(*entry.array3D, ZERO_F);
+  } else {
+    Kokkos::deep_copy(*entry.array4D, ZERO_F);
+  }
+}
+
+// Zero the arrays of this phase whose memory was written by another phase since they were
+// last used, and flag the arrays of other phases which share memory with this one.
+void ScratchArena::Acquire(Phase phase) {
+  for(Entry &entry : entries) {
+    if(!entry.pooled || !(entry.lifetime & phase)) continue;
+    if(entry.clobbered) {
+      Zero(entry);
+      entry.clobbered = false;
+    }
+    for(int m : entry.overlaps) {
+      entries[m].clobbered = true;
+    }
+  }
+}
+
+void ScratchArena::Allocate(Input &input) {
+  idfx::pushRegion("ScratchArena::Allocate");
+  aliasing = input.GetOrSet<bool>("TimeIntegrator","scratch_arena",0,true);
+  PlaceEntries();
+  if(poolSize > 0) {
+    pool = IdefixArray1D<real>("ScratchArena", poolSize);
+    for(Entry &entry : entries) {
+      Bind(entry);
+    }
+  }
+  isAllocated = true;
+  idfx::prof.RegisterScratch(GetRequestedSize(), GetAllocatedSize());
+  idfx::popRegion();
+}
+
+int64_t ScratchArena::GetRequestedSize() const {
+  int64_t size = 0;
+  for(const Entry &entry : entries) {
+    size += entry.size;
+  }
+  return size*sizeof(real);
+}
+
+int64_t ScratchArena::GetAllocatedSize() const {
+  int64_t size = poolSize;
+  // Late requests have their own allocation
+  for(const Entry &entry : entries) {
+    if(!entry.pooled) size += entry.size;
+  }
+  return size*sizeof(real);
+}
+
+void ScratchArena::ShowConfig() {
+  if(entries.size() == 0) return;
+  const double requested = static_cast<double>(GetRequestedSize())/(1024.0*1024.0);
+  const double allocated = static_cast<double>(GetAllocatedSize())/(1024.0*1024.0);
+  idfx::cout << "ScratchArena: " << entries.size() << " scratch arrays, "
+             << allocated << " MB allocated for " << requested << " MB requested";
+  if(!aliasing) idfx::cout << " (aliasing disabled)";
+  idfx::cout << "." << std::endl;
+}
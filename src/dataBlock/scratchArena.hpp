@@ -0,0 +1,79 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef DATABLOCK_SCRATCHARENA_HPP_
+#define DATABLOCK_SCRATCHARENA_HPP_
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "idefix.hpp"
+#include "input.hpp"
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+/// The ScratchArena holds the temporary arrays of the modules attached to a DataBlock.
+/// Each module requests its scratch arrays in its constructor, together with the phases of the
+/// integration step during which the content of these arrays has to be preserved (their
+/// lifetime). Once all of the modules are built, the arena allocates a single pool, in which
+/// arrays with disjoint lifetimes are placed at overlapping addresses. The arrays are then
+/// assigned to the references given in the requests, so that modules keep using plain
+/// IdefixArrays.
+/// Each phase should be entered with Acquire(), which zeroes the arrays of this phase whose
+/// memory was used by another phase in between, so that the arrays behave as separate
+/// allocations: they are zero before their first use and keep their content otherwise.
+//////////////////////////////////////////////////////////////////////////////////////////////////
+class ScratchArena {
+ public:
+  // Phases of an integration step, used to describe the lifetime of scratch arrays
+  enum Phase : int {
+    stagePhase = 1 << 0,  ///< Hydro and dust stages (fluxes, EMFs, right hand sides)
+    rklPhase = 1 << 1,    ///< Runge-Kutta-Legendre cycles of the parabolic terms
+    fargoPhase = 1 << 2   ///< Fargo advection of the solution
+  };
+
+  void Request(IdefixArray3D<real> &, const std::string &, int,
+               int, int, int);                ///< request a 3D scratch array
+  void Request(IdefixArray4D<real> &, const std::string &, int,
+               int, int, int, int);           ///< request a 4D scratch array
+  void Allocate(Input &);                    ///< allocate the pool and assign the arrays
+  void Acquire(Phase);                       ///< enter a phase of the integration step
+  void ShowConfig();
+
+  int64_t GetRequestedSize() const;          ///< sum of the sizes of all requests (bytes)
+  int64_t GetAllocatedSize() const;          ///< size actually allocated (bytes)
+
+ private:
+  struct Entry {
+    std::string name;
+    int lifetime;                             // bitmask of Phase
+    int rank;                                 // 3 or 4
+    std::array<int,4> extent;
+    size_t size;                              // number of elements
+    size_t offset{0};                         // offset in the pool
+    bool pooled{false};                       // whether the array lives in the pool
+    bool clobbered{false};                    // whether another phase wrote in its memory
+    std::vector<int> overlaps;                // entries placed at overlapping addresses
+    IdefixArray3D<real> *array3D{nullptr};
+    IdefixArray4D<real> *array4D{nullptr};
+  };
+
+  void Bind(Entry &);                         // assign the array of an entry from the pool
+  void Zero(Entry &);                         // zero the array of an entry
+  void PlaceEntries();                        // compute the offsets of all of the entries
+
+  std::vector<Entry> entries;
+  IdefixArray1D<real> pool;
+  size_t poolSize{0};                         // number of elements of the pool
+  bool isAllocated{false};
+  bool aliasing{true};                        // whether disjoint lifetimes share memory
+
+  // Arrays start on a 128 byte boundary
+  static constexpr size_t alignment = 128/sizeof(real);
+};
+
+#endif // DATABLOCK_SCRATCHARENA_HPP_
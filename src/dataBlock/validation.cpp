@@ -20,6 +20,16 @@ int DataBlock::CheckNan() {
   return(nNans);
 }
 
+int DataBlock::CountNan() {
+  int nNans = hydro->CountNan();
+  if(haveDust) {
+    for(int n = 0 ; n < dust.size() ; n++) {
+      nNans += dust[n]->CountNan();
+    }
+  }
+  return(nNans);
+}
+
 void DataBlock::Validate() {
   idfx::pushRegion("DataBlock::Validate");
 
@@ -14,91 +14,110 @@
 #include "flux.hpp"
 #include "convertConsToPrim.hpp"
 
-// Compute Riemann fluxes from states using HLL solver
-template <typename Phys>
-template<const int DIR>
-void RiemannSolver<Phys>::HllDust(IdefixArray4D<real> &Flux) {
-  idfx::pushRegion("RiemannSolver::HLL_Dust");
-
-  constexpr int ioffset = (DIR==IDIR) ? 1 : 0;
-  constexpr int joffset = (DIR==JDIR) ? 1 : 0;
-  constexpr int koffset = (DIR==KDIR) ? 1 : 0;
+// HLL flux of the dust fluid whose variables start at n0 in Vc and Flux, at the interface
+// (k,j,i). Returns the maximum wave speed.
+template <typename Phys, int DIR>
+KOKKOS_FORCEINLINE_FUNCTION real K_HllDust(const ExtrapolateToFaces<Phys,DIR> &extrapol,
+                                           const IdefixArray4D<flux_real> &Flux,
+                                           const int n0, const int k, const int j, const int i) {
+  // Init the directions (should be in the kernel for proper optimisation by the compilers)
+  constexpr int Xn = DIR+MX1;
 
-  IdefixArray4D<real> Vc = this->Vc;
-  IdefixArray3D<real> cMax = this->cMax;
+  // Primitive variables
+  real vL[Phys::nvar];
+  real vR[Phys::nvar];
 
-  // Required for high order interpolations
-  IdefixArray1D<real> dx = this->data->dx[DIR];
+  // Conservative variables
+  real uL[Phys::nvar];
+  real uR[Phys::nvar];
 
+  // Flux (left and right)
+  real fluxL[Phys::nvar];
+  real fluxR[Phys::nvar];
 
-  ExtrapolateToFaces<Phys,DIR> extrapol = *this->GetExtrapolator<DIR>();
 
-  idefix_for("HLL_Kernel",
-             data->beg[KDIR],data->end[KDIR]+koffset,
-             data->beg[JDIR],data->end[JDIR]+joffset,
-             data->beg[IDIR],data->end[IDIR]+ioffset,
-    KOKKOS_LAMBDA (int k, int j, int i) {
-      // Init the directions (should be in the kernel for proper optimisation by the compilers)
-      constexpr int Xn = DIR+MX1;
+  // 1-- Store the primitive variables on the left, right, and averaged states
+  extrapol.ExtrapolatePrimVar(i, j, k, vL, vR, n0);
 
-      // Primitive variables
-      real vL[Phys::nvar];
-      real vR[Phys::nvar];
+  // 2-- Get the wave speed
 
-      // Conservative variables
-      real uL[Phys::nvar];
-      real uR[Phys::nvar];
+  real SL = vL[Xn];
+  real SR = vR[Xn];
 
-      // Flux (left and right)
-      real fluxL[Phys::nvar];
-      real fluxR[Phys::nvar];
+  real cmax  = FMAX(FABS(SL), FABS(SR));
 
+  // 3-- Compute the conservative variables: do this by extrapolation
+  K_PrimToCons<Phys>(uL, vL, NULL); // Set gamma to 0 implicitly
+  K_PrimToCons<Phys>(uR, vR, NULL);
 
-      // 1-- Store the primitive variables on the left, right, and averaged states
-      extrapol.ExtrapolatePrimVar(i, j, k, vL, vR);
+  // 4-- Compute the left and right fluxes (wave speed is null)
+  K_Flux<Phys,DIR>(fluxL, vL, uL, 0);
+  K_Flux<Phys,DIR>(fluxR, vR, uR, 0);
 
-      // 2-- Get the wave speed
+  // 5-- Compute the flux from the left and right states
+  if (SL > 0) {
+#pragma unroll
+    for (int nv = 0 ; nv < Phys::nvar; nv++) {
+      Flux(n0+nv,k,j,i) = fluxL[nv];
+    }
+  } else if (SR < 0) {
+#pragma unroll
+    for (int nv = 0 ; nv < Phys::nvar; nv++) {
+      Flux(n0+nv,k,j,i) = fluxR[nv];
+    }
+  } else {
+    real dS = SR-SL;
+    if(std::abs(dS) < SMALL_NUMBER) {
+      dS = SMALL_NUMBER;
+    }
+#pragma unroll
+    for(int nv = 0 ; nv < Phys::nvar; nv++) {
+      Flux(n0+nv,k,j,i) = SL*SR*uR[nv] - SL*SR*uL[nv] + SR*fluxL[nv] - SL*fluxR[nv];
+      Flux(n0+nv,k,j,i) /= dS;
+    }
+  }
+  return(cmax);
+}
 
-      real SL = vL[Xn];
-      real SR = vR[Xn];
+// Compute Riemann fluxes from states using HLL solver
+template <typename Phys>
+template<const int DIR>
+void RiemannSolver<Phys>::HllDust(IdefixArray4D<flux_real> &Flux) {
+  idfx::pushRegion("RiemannSolver::HLL_Dust");
 
-      real cmax  = FMAX(FABS(SL), FABS(SR));
+  constexpr int ioffset = (DIR==IDIR) ? 1 : 0;
+  constexpr int joffset = (DIR==JDIR) ? 1 : 0;
+  constexpr int koffset = (DIR==KDIR) ? 1 : 0;
 
-      // 3-- Compute the conservative variables: do this by extrapolation
-      K_PrimToCons<Phys>(uL, vL, NULL); // Set gamma to 0 implicitly
-      K_PrimToCons<Phys>(uR, vR, NULL);
+  IdefixArray3D<real> cMax = this->cMax;
 
-      // 4-- Compute the left and right fluxes (wave speed is null)
-      K_Flux<Phys,DIR>(fluxL, vL, uL, 0);
-      K_Flux<Phys,DIR>(fluxR, vR, uR, 0);
+  ExtrapolateToFaces<Phys,DIR> extrapol = *this->GetExtrapolator<DIR>();
 
-      // 5-- Compute the flux from the left and right states
-      if (SL > 0) {
-#pragma unroll
-        for (int nv = 0 ; nv < Phys::nvar; nv++) {
-          Flux(nv,k,j,i) = fluxL[nv];
-        }
-      } else if (SR < 0) {
-#pragma unroll
-        for (int nv = 0 ; nv < Phys::nvar; nv++) {
-          Flux(nv,k,j,i) = fluxR[nv];
-        }
-      } else {
-        real dS = SR-SL;
-        if(std::abs(dS) < SMALL_NUMBER) {
-          dS = SMALL_NUMBER;
-        }
-#pragma unroll
-        for(int nv = 0 ; nv < Phys::nvar; nv++) {
-          Flux(nv,k,j,i) = SL*SR*uR[nv] - SL*SR*uL[nv] + SR*fluxL[nv] - SL*fluxR[nv];
-          Flux(nv,k,j,i) /= dS;
-        }
-      }
-
-      //6-- Compute maximum wave speed for this sweep
-      cMax(k,j,i) = cmax;
-    }
-  );
+  if(hydro->nFusedSpecies > 1) {
+    // Shared storage: the fluxes of all of the dust species are computed by the same kernel,
+    // the specie being the slowest index
+    extrapol.Vc = data->dustVc;
+    IdefixArray4D<flux_real> dustFlux = data->dustFlux;
+    IdefixArray4D<real> dustCMax = data->dustCMax;
+    const int nv = data->dustNvar;
+    idefix_for("HLL_Kernel_Species",
+               0, hydro->nFusedSpecies,
+               data->beg[KDIR],data->end[KDIR]+koffset,
+               data->beg[JDIR],data->end[JDIR]+joffset,
+               data->beg[IDIR],data->end[IDIR]+ioffset,
+      KOKKOS_LAMBDA (int s, int k, int j, int i) {
+        dustCMax(s,k,j,i) = K_HllDust<Phys,DIR>(extrapol, dustFlux, s*nv, k, j, i);
+      });
+  } else {
+    ForEachInterface<DIR>("HLL_Kernel",
+                          data->beg[KDIR],data->end[KDIR]+koffset,
+                          data->beg[JDIR],data->end[JDIR]+joffset,
+                          data->beg[IDIR],data->end[IDIR]+ioffset,
+      KOKKOS_LAMBDA (int k, int j, int i) {
+        //6-- Compute maximum wave speed for this sweep
+        cMax(k,j,i) = K_HllDust<Phys,DIR>(extrapol, Flux, 0, k, j, i);
+      });
+  }
 
   idfx::popRegion();
 }
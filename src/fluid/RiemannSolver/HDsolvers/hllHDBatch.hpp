@@ -0,0 +1,122 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef FLUID_RIEMANNSOLVER_HDSOLVERS_HLLHDBATCH_HPP_
+#define FLUID_RIEMANNSOLVER_HDSOLVERS_HLLHDBATCH_HPP_
+
+#include "../idefix.hpp"
+#include "fluid.hpp"
+#include "extrapolateToFaces.hpp"
+#include "flux.hpp"
+#include "convertConsToPrim.hpp"
+#include "simdBatch.hpp"
+
+// Compute Riemann fluxes from states using HLL solver, simdWidth interfaces at a time
+// (Idefix_SIMD_WIDTH). Same arithmetic as HllHD.
+template <typename Phys>
+template<const int DIR>
+void RiemannSolver<Phys>::HllHDBatch(IdefixArray4D<flux_real> &Flux) {
+  // Batches are made of consecutive interfaces along i, which do not fit the compacted lists
+  // of interfaces of coarsened grids: use the scalar kernel instead
+  if(HaveCoarseInterfaces(DIR)) {
+    HllHD<DIR>(Flux);
+    return;
+  }
+  idfx::pushRegion("RiemannSolver::HLL_Solver_Batch");
+
+  constexpr int W = simdWidth;
+  using Batch = idfx::Batch<W>;
+
+  constexpr int ioffset = (DIR==IDIR) ? 1 : 0;
+  constexpr int joffset = (DIR==JDIR) ? 1 : 0;
+  constexpr int koffset = (DIR==KDIR) ? 1 : 0;
+
+  IdefixArray3D<real> cMax = this->cMax;
+  EquationOfState eos = *(hydro->eos.get());
+
+  ExtrapolateToFaces<Phys,DIR> extrapol = *this->GetExtrapolator<DIR>();
+
+  // The i loop is split in batches of W interfaces
+  const int ibeg = data->beg[IDIR];
+  const int iend = data->end[IDIR]+ioffset;
+  const int nBatch = (iend - ibeg + W - 1)/W;
+
+  idefix_for("HLL_Kernel_Batch",
+             data->beg[KDIR],data->end[KDIR]+koffset,
+             data->beg[JDIR],data->end[JDIR]+joffset,
+             0,nBatch,
+    KOKKOS_LAMBDA (int k, int j, int b) {
+      constexpr int Xn = DIR+MX1;
+      const int i0 = ibeg + b*W;
+
+      // Primitive variables
+      Batch vL[Phys::nvar];
+      Batch vR[Phys::nvar];
+
+      // Conservative variables
+      Batch uL[Phys::nvar];
+      Batch uR[Phys::nvar];
+
+      // Flux (left and right)
+      Batch fluxL[Phys::nvar];
+      Batch fluxR[Phys::nvar];
+
+      // Signal speeds
+      Batch cL, cR, cmax;
+
+      // 1-- Store the primitive variables on the left, right, and averaged states
+      extrapol.ExtrapolatePrimVar(i0, iend, j, k, vL, vR);
+
+      // 2-- Get the wave speed
+      #if HAVE_ENERGY
+        cL = sqrt(idfx::GetGamma(eos,vL[PRS],vL[RHO])*(vL[PRS]/vL[RHO]));
+        cR = sqrt(idfx::GetGamma(eos,vR[PRS],vR[RHO])*(vR[PRS]/vR[RHO]));
+      #else
+        for(int w = 0 ; w < W ; w++) {
+          const int i = idfx::BatchIndex(i0,w,iend);
+          cL[w] = HALF_F*(eos.GetWaveSpeed(k,j,i)
+                         +eos.GetWaveSpeed(k-koffset,j-joffset,i-ioffset));
+        }
+        cR = cL;
+      #endif
+
+      Batch SL = fmin(vL[Xn] - cL, vR[Xn] - cR);
+      Batch SR = fmax(vL[Xn] + cL, vR[Xn] + cR);
+
+      cmax  = fmax(fabs(SL), fabs(SR));
+
+      // 3-- Compute the conservative variables
+      K_PrimToCons<Phys>(uL, vL, &eos);
+      K_PrimToCons<Phys>(uR, vR, &eos);
+
+      // 4-- Compute the left and right fluxes
+      K_Flux<Phys,DIR>(fluxL, vL, uL, cL*cL);
+      K_Flux<Phys,DIR>(fluxR, vR, uR, cR*cR);
+
+      // 5-- Compute the flux from the left and right states
+      Batch F[Phys::nvar];
+#pragma unroll
+      for(int nv = 0 ; nv < Phys::nvar; nv++) {
+        F[nv] = (SL*SR*uR[nv] - SL*SR*uL[nv] + SR*fluxL[nv] - SL*fluxR[nv])/(SR - SL);
+        F[nv] = idfx::select(SR < 0, fluxR[nv], F[nv]);
+        F[nv] = idfx::select(SL > 0, fluxL[nv], F[nv]);
+      }
+
+      // 6-- Store the fluxes and the maximum wave speed of the valid lanes
+      for(int w = 0 ; w < W && i0+w < iend ; w++) {
+        for(int nv = 0 ; nv < Phys::nvar; nv++) {
+          Flux(nv,k,j,i0+w) = F[nv][w];
+        }
+        cMax(k,j,i0+w) = cmax[w];
+      }
+    }
+  );
+
+  idfx::popRegion();
+}
+
+#endif // FLUID_RIEMANNSOLVER_HDSOLVERS_HLLHDBATCH_HPP_
@@ -17,7 +17,7 @@
 // Compute Riemann fluxes from states using HLLC solver
 template <typename Phys>
 template<const int DIR>
-void RiemannSolver<Phys>::HllcHD(IdefixArray4D<real> &Flux) {
+void RiemannSolver<Phys>::HllcHD(IdefixArray4D<flux_real> &Flux) {
   idfx::pushRegion("RiemannSolver::HLLC_Solver");
 
   constexpr int ioffset = (DIR==IDIR) ? 1 : 0;
@@ -32,10 +32,10 @@ void RiemannSolver<Phys>::HllcHD(IdefixArray4D<real> &Flux) {
 
   ExtrapolateToFaces<Phys,DIR> extrapol = *this->GetExtrapolator<DIR>();
 
-  idefix_for("HLLC_Kernel",
-             data->beg[KDIR],data->end[KDIR]+koffset,
-             data->beg[JDIR],data->end[JDIR]+joffset,
-             data->beg[IDIR],data->end[IDIR]+ioffset,
+  ForEachInterface<DIR>("HLLC_Kernel",
+                        data->beg[KDIR],data->end[KDIR]+koffset,
+                        data->beg[JDIR],data->end[JDIR]+joffset,
+                        data->beg[IDIR],data->end[IDIR]+ioffset,
     KOKKOS_LAMBDA (int k, int j, int i) {
       // Init the directions (should be in the kernel for proper optimisation by the compilers)
       EXPAND( constexpr int Xn = DIR+MX1;                    ,
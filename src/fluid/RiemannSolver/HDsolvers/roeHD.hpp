@@ -38,7 +38,7 @@
 // Compute Riemann fluxes from states using ROE solver
 template <typename Phys>
 template<const int DIR>
-void RiemannSolver<Phys>::RoeHD(IdefixArray4D<real> &Flux) {
+void RiemannSolver<Phys>::RoeHD(IdefixArray4D<flux_real> &Flux) {
   idfx::pushRegion("RiemannSolver::ROE_Solver");
 
   constexpr int ioffset = (DIR==IDIR) ? 1 : 0;
@@ -53,10 +53,10 @@ void RiemannSolver<Phys>::RoeHD(IdefixArray4D<real> &Flux) {
 
   ExtrapolateToFaces<Phys,DIR> extrapol = *this->GetExtrapolator<DIR>();
 
-  idefix_for("ROE_Kernel",
-             data->beg[KDIR],data->end[KDIR]+koffset,
-             data->beg[JDIR],data->end[JDIR]+joffset,
-             data->beg[IDIR],data->end[IDIR]+ioffset,
+  ForEachInterface<DIR>("ROE_Kernel",
+                        data->beg[KDIR],data->end[KDIR]+koffset,
+                        data->beg[JDIR],data->end[JDIR]+joffset,
+                        data->beg[IDIR],data->end[IDIR]+ioffset,
     KOKKOS_LAMBDA (int k, int j, int i) {
       // Init the directions (should be in the kernel for proper optimisation by the compilers)
       EXPAND( const int Xn = DIR+MX1;                    ,
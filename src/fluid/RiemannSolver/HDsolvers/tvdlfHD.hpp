@@ -17,7 +17,7 @@
 // Compute Riemann fluxes from states using TVDLF solver
 template <typename Phys>
 template<const int DIR>
-void RiemannSolver<Phys>::TvdlfHD(IdefixArray4D<real> &Flux) {
+void RiemannSolver<Phys>::TvdlfHD(IdefixArray4D<flux_real> &Flux) {
   idfx::pushRegion("RiemannSolver::TVDLF_Solver");
 
   constexpr int ioffset = (DIR==IDIR) ? 1 : 0;
@@ -34,10 +34,10 @@ void RiemannSolver<Phys>::TvdlfHD(IdefixArray4D<real> &Flux) {
 
   ExtrapolateToFaces<Phys,DIR> extrapol = *this->GetExtrapolator<DIR>();
 
-  idefix_for("TVDLF_Kernel",
-             data->beg[KDIR],data->end[KDIR]+koffset,
-             data->beg[JDIR],data->end[JDIR]+joffset,
-             data->beg[IDIR],data->end[IDIR]+ioffset,
+  ForEachInterface<DIR>("TVDLF_Kernel",
+                        data->beg[KDIR],data->end[KDIR]+koffset,
+                        data->beg[JDIR],data->end[JDIR]+joffset,
+                        data->beg[IDIR],data->end[IDIR]+ioffset,
     KOKKOS_LAMBDA (int k, int j, int i) {
       // Init the directions (should be in the kernel for proper optimisation by the compilers)
       constexpr int Xn = DIR+MX1;
@@ -18,7 +18,7 @@
 // Compute Riemann fluxes from states using HLL solver
 template <typename Phys>
 template<const int DIR>
-void RiemannSolver<Phys>::HllMHD(IdefixArray4D<real> &Flux) {
+void RiemannSolver<Phys>::HllMHD(IdefixArray4D<flux_real> &Flux) {
   idfx::pushRegion("RiemannSolver::HLL_MHD");
 
   using EMF = ConstrainedTransport<Phys>;
@@ -50,7 +50,8 @@ void RiemannSolver<Phys>::HllMHD(IdefixArray4D<real> &Flux) {
   IdefixArray4D<real> Vs = this->Vs;
   IdefixArray3D<real> cMax = this->cMax;
 
-  HydroModuleStatus haveHall = hydro->hallStatus.status;
+  // A sub-cycled Hall effect is integrated out of the Riemann solver
+  HydroModuleStatus haveHall = hydro->hallStatus.isExplicit ? hydro->hallStatus.status : Disabled;
   IdefixArray4D<real> J = hydro->J;
   IdefixArray3D<real> xHallArr = hydro->xHall;
   IdefixArray1D<real> dx = data->dx[DIR];
@@ -63,7 +64,12 @@ void RiemannSolver<Phys>::HllMHD(IdefixArray4D<real> &Flux) {
   IdefixArray3D<real> Eb;
   IdefixArray3D<real> Et;
 
+  #ifdef FIXED_EMF
+  // Averaging scheme fixed at compile time: unused store paths are removed from the kernel
+  constexpr typename EMF::AveragingType emfAverage = EMF::FIXED_EMF;
+  #else
   const typename EMF::AveragingType emfAverage = hydro->emf->averaging;
+  #endif
 
   // Required by UCT_Contact
   IdefixArray3D<real> SV;
@@ -151,10 +157,10 @@ void RiemannSolver<Phys>::HllMHD(IdefixArray4D<real> &Flux) {
   }
 
 
-  idefix_for("CalcRiemannFlux",
-             data->beg[KDIR]-kextend,data->end[KDIR]+koffset+kextend,
-             data->beg[JDIR]-jextend,data->end[JDIR]+joffset+jextend,
-             data->beg[IDIR]-iextend,data->end[IDIR]+ioffset+iextend,
+  ForEachInterface<DIR>("CalcRiemannFlux",
+                        data->beg[KDIR]-kextend,data->end[KDIR]+koffset+kextend,
+                        data->beg[JDIR]-jextend,data->end[JDIR]+joffset+jextend,
+                        data->beg[IDIR]-iextend,data->end[IDIR]+ioffset+iextend,
     KOKKOS_LAMBDA (int k, int j, int i) {
       // Init the directions (should be in the kernel for proper optimisation by the compilers)
       const int Xn = DIR+MX1;
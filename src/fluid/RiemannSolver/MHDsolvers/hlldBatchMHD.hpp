@@ -0,0 +1,314 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef FLUID_RIEMANNSOLVER_MHDSOLVERS_HLLDBATCHMHD_HPP_
+#define FLUID_RIEMANNSOLVER_MHDSOLVERS_HLLDBATCHMHD_HPP_
+
+#include "../idefix.hpp"
+#include "extrapolateToFaces.hpp"
+#include "flux.hpp"
+#include "convertConsToPrim.hpp"
+#include "storeFlux.hpp"
+#include "constrainedTransport.hpp"
+#include "hlldMaskedMHD.hpp"
+#include "simdBatch.hpp"
+
+// Compute Riemann fluxes from states using HLLD solver, simdWidth interfaces at a time
+// (Idefix_SIMD_WIDTH). The flux is computed by K_HlldMaskedFlux on batches, hence it is
+// identical to the one of HlldMaskedMHD.
+template <typename Phys>
+template<const int DIR>
+void RiemannSolver<Phys>::HlldBatchMHD(IdefixArray4D<flux_real> &Flux) {
+  // Batches are made of consecutive interfaces along i, which do not fit the compacted lists
+  // of interfaces of coarsened grids: use the scalar (masked) kernel instead
+  if(HaveCoarseInterfaces(DIR)) {
+    HlldMaskedMHD<DIR>(Flux);
+    return;
+  }
+  idfx::pushRegion("RiemannSolver::HLLD_MHD_Batch");
+
+  constexpr int W = simdWidth;
+  using Batch = idfx::Batch<W>;
+
+  using EMF = ConstrainedTransport<Phys>;
+
+  constexpr int ioffset = (DIR==IDIR) ? 1 : 0;
+  constexpr int joffset = (DIR==JDIR) ? 1 : 0;
+  constexpr int koffset = (DIR==KDIR) ? 1 : 0;
+
+  int perpExtension=1;
+  if (hydro->emf->averaging == EMF::uct_hll
+      || hydro->emf->averaging == EMF::uct_hlld) {
+        // Need two cells in the perp direction for these schemes
+        perpExtension= data->nghost[DIR];
+  }
+  // extension in perp to the direction of integration, as required by CT.
+  const int iextend = (DIR==IDIR) ? 0 : perpExtension;
+  #if DIMENSIONS > 1
+    const int jextend = (DIR==JDIR) ? 0 : perpExtension;
+  #else
+    const int jextend = 0;
+  #endif
+  #if DIMENSIONS > 2
+    const int kextend = (DIR==KDIR) ? 0 : perpExtension;
+  #else
+    const int kextend = 0;
+  #endif
+
+  IdefixArray4D<real> Vc = this->Vc;
+  IdefixArray4D<real> Vs = this->Vs;
+  IdefixArray3D<real> cMax = this->cMax;
+
+  // Required for high order interpolations
+  IdefixArray1D<real> dx = this->data->dx[DIR];
+
+  // References to required emf components
+  IdefixArray3D<real> Eb;
+  IdefixArray3D<real> Et;
+
+
+  #ifdef FIXED_EMF
+  // Averaging scheme fixed at compile time: unused store paths are removed from the kernel
+  constexpr typename EMF::AveragingType emfAverage = EMF::FIXED_EMF;
+  #else
+  const typename EMF::AveragingType emfAverage = hydro->emf->averaging;
+  #endif
+
+  // Required by UCT_Contact
+  IdefixArray3D<real> SV;
+
+  // Required by UCT_HLLX
+  IdefixArray3D<real> aL;
+  IdefixArray3D<real> aR;
+  IdefixArray3D<real> dL;
+  IdefixArray3D<real> dR;
+
+  EquationOfState eos = *(hydro->eos.get());
+
+  ExtrapolateToFaces<Phys,DIR> extrapol = *this->GetExtrapolator<DIR>();
+
+  // st and sb will be useful only when Hall is included
+  real st = ONE_F, sb = ONE_F;
+
+  switch(DIR) {
+    case(IDIR):
+      D_EXPAND(
+                st = -ONE_F;  ,
+                  ,
+
+                sb = +ONE_F;  )
+
+      Et = hydro->emf->ezi;
+      Eb = hydro->emf->eyi;
+
+      SV = hydro->emf->svx;
+
+      aL = hydro->emf->axL;
+      aR = hydro->emf->axR;
+
+      dL = hydro->emf->dxL;
+      dR = hydro->emf->dxR;
+
+      break;
+#if DIMENSIONS >= 2
+    case(JDIR):
+      D_EXPAND(
+                st = +ONE_F;  ,
+                              ,
+
+                sb = -ONE_F;  )
+
+      Et = hydro->emf->ezj;
+      Eb = hydro->emf->exj;
+
+      SV = hydro->emf->svy;
+
+      aL = hydro->emf->ayL;
+      aR = hydro->emf->ayR;
+
+      dL = hydro->emf->dyL;
+      dR = hydro->emf->dyR;
+
+      break;
+#endif
+#if DIMENSIONS == 3
+    case(KDIR):
+
+      D_EXPAND(
+
+                st = -ONE_F;  ,
+                  ,
+                sb = +ONE_F;  )
+
+      Et = hydro->emf->eyk;
+      Eb = hydro->emf->exk;
+
+      SV = hydro->emf->svz;
+
+      aL = hydro->emf->azL;
+      aR = hydro->emf->azR;
+
+      dL = hydro->emf->dzL;
+      dR = hydro->emf->dzR;
+      break;
+#endif
+    default:
+      IDEFIX_ERROR("Wrong direction");
+  }
+
+  // The i loop is split in batches of W interfaces
+  const int ibeg = data->beg[IDIR]-iextend;
+  const int iend = data->end[IDIR]+ioffset+iextend;
+  const int nBatch = (iend - ibeg + W - 1)/W;
+
+  idefix_for("CalcRiemannFluxBatch",
+             data->beg[KDIR]-kextend,data->end[KDIR]+koffset+kextend,
+             data->beg[JDIR]-jextend,data->end[JDIR]+joffset+jextend,
+             0,nBatch,
+    KOKKOS_LAMBDA (int k, int j, int b) {
+      // Init the directions (should be in the kernel for proper optimisation by the compilers)
+      EXPAND( constexpr int Xn = DIR+MX1;                    ,
+              constexpr int Xt = (DIR == IDIR ? MX2 : MX1);  ,
+              constexpr int Xb = (DIR == KDIR ? MX2 : MX3);  )
+
+      EXPAND( constexpr int BXn = DIR+BX1;                    ,
+              constexpr int BXt = (DIR == IDIR ? BX2 : BX1);  ,
+              constexpr int BXb = (DIR == KDIR ? BX2 : BX3);   )
+      const int i0 = ibeg + b*W;
+
+      // Primitive variables
+      Batch vL[Phys::nvar];
+      Batch vR[Phys::nvar];
+
+      extrapol.ExtrapolatePrimVar(i0, iend, j, k, vL, vR);
+      for(int w = 0 ; w < W ; w++) {
+        vL[BXn][w] = Vs(DIR,k,j,idfx::BatchIndex(i0,w,iend));
+      }
+      vR[BXn] = vL[BXn];
+
+      // Conservative variables
+      Batch uL[Phys::nvar];
+      Batch uR[Phys::nvar];
+
+      // Flux (left and right)
+      Batch fluxL[Phys::nvar];
+      Batch fluxR[Phys::nvar];
+
+      // Signal speeds
+      Batch cL, cR, cmax, c2Iso;
+
+      // Init c2Isothermal (used only when isothermal approx is set)
+      c2Iso = ZERO_F;
+
+      // 2-- Get the wave speed
+      Batch gpr, b1, b2, b3, Btmag2, Bmag2;
+#if HAVE_ENERGY
+      Batch gamma = idfx::GetGamma(eos,0.5*(vL[PRS]+vR[PRS]),0.5*(vL[RHO]+vR[RHO]));
+      gpr = gamma*vL[PRS];
+#else
+      for(int w = 0 ; w < W ; w++) {
+        const int i = idfx::BatchIndex(i0,w,iend);
+        c2Iso[w] = HALF_F*(eos.GetWaveSpeed(k,j,i)
+                          +eos.GetWaveSpeed(k-koffset,j-joffset,i-ioffset));
+      }
+      c2Iso *= c2Iso;
+
+      gpr = c2Iso*vL[RHO];
+#endif
+
+      // -- get total field
+      b1 = b2 = b3 = ZERO_F;
+      EXPAND ( b1 = vL[BXn];  ,
+               b2 = vL[BXt];  ,
+               b3 = vL[BXb];  )
+
+      Btmag2 = b2*b2 + b3*b3;
+      Bmag2  = b1*b1 + Btmag2;
+
+      cL = gpr - Bmag2;
+      cL = gpr + Bmag2 + sqrt(cL*cL + FOUR_F*gpr*Btmag2);
+      cL = sqrt(HALF_F*cL/vL[RHO]);
+
+#if HAVE_ENERGY
+      gpr = gamma*vR[PRS];
+#else
+      gpr = c2Iso*vR[RHO];
+#endif
+
+      // -- get total field
+      b1 = b2 = b3 = ZERO_F;
+      EXPAND ( b1 = vR[BXn];  ,
+               b2 = vR[BXt];  ,
+               b3 = vR[BXb];  )
+
+      Btmag2 = b2*b2 + b3*b3;
+      Bmag2  = b1*b1 + Btmag2;
+
+      cR = gpr - Bmag2;
+      cR = gpr + Bmag2 + sqrt(cR*cR + FOUR_F*gpr*Btmag2);
+      cR = sqrt(HALF_F*cR/vR[RHO]);
+
+      // 4.1
+      Batch sl = fmin(vL[Xn] - cL, vR[Xn] - cR);
+      Batch sr = fmax(vL[Xn] + cL, vR[Xn] + cR);
+
+      cmax  = fmax(fabs(sl), fabs(sr));
+
+      // 2-- Compute the conservative variables
+      K_PrimToCons<Phys>(uL, vL, &eos);
+      K_PrimToCons<Phys>(uR, vR, &eos);
+
+      // 3-- Compute the left and right fluxes
+#pragma unroll
+      for(int nv = 0 ; nv < Phys::nvar; nv++) {
+        fluxL[nv] = uL[nv];
+        fluxR[nv] = uR[nv];
+      }
+
+      K_Flux<Phys,DIR>(fluxL, vL, fluxL, c2Iso);
+      K_Flux<Phys,DIR>(fluxR, vR, fluxR, c2Iso);
+
+      // 5-- Compute the flux from the left and right states
+      Batch F[Phys::nvar];
+      K_HlldMaskedFlux<Phys,DIR>(vL, vR, uL, uR, fluxL, fluxR, sl, sr, F);
+
+      // 6-- Store the fluxes and the maximum wave speed of the valid lanes
+      for(int w = 0 ; w < W && i0+w < iend ; w++) {
+        const int i = i0+w;
+        for(int nv = 0 ; nv < Phys::nvar; nv++) {
+          Flux(nv,k,j,i) = F[nv][w];
+        }
+        cMax(k,j,i) = cmax[w];
+
+        // 7-- Store the flux in the emf components
+        if (emfAverage==EMF::arithmetic
+                  || emfAverage==EMF::uct0) {
+          K_StoreEMF<DIR>(i,j,k,st,sb,Flux,Et,Eb);
+        } else if (emfAverage==EMF::uct_contact) {
+          K_StoreContact<DIR>(i,j,k,st,sb,Flux,Et,Eb,SV);
+        } else {
+          // The 2D Riemann solvers of the emf need the states of this lane
+          real vLw[Phys::nvar], vRw[Phys::nvar], uLw[Phys::nvar], uRw[Phys::nvar];
+          for(int nv = 0 ; nv < Phys::nvar; nv++) {
+            vLw[nv] = vL[nv][w];
+            vRw[nv] = vR[nv][w];
+            uLw[nv] = uL[nv][w];
+            uRw[nv] = uR[nv][w];
+          }
+          if (emfAverage==EMF::uct_hll) {
+            K_StoreHLL<DIR>(i,j,k,st,sb,sl[w],sr[w],vLw,vRw,Et,Eb,aL,aR,dL,dR);
+          } else if (emfAverage==EMF::uct_hlld) {
+            K_StoreHLLD<DIR>(i,j,k,st,sb,c2Iso[w],sl[w],sr[w],vLw,vRw,uLw,uRw,
+                             Et,Eb,aL,aR,dL,dR);
+          }
+        }
+      }
+  });
+  idfx::popRegion();
+}
+
+#endif // FLUID_RIEMANNSOLVER_MHDSOLVERS_HLLDBATCHMHD_HPP_
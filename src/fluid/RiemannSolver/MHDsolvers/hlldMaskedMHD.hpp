@@ -0,0 +1,550 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef FLUID_RIEMANNSOLVER_MHDSOLVERS_HLLDMASKEDMHD_HPP_
+#define FLUID_RIEMANNSOLVER_MHDSOLVERS_HLLDMASKEDMHD_HPP_
+
+#include "../idefix.hpp"
+#include "extrapolateToFaces.hpp"
+#include "flux.hpp"
+#include "convertConsToPrim.hpp"
+#include "storeFlux.hpp"
+#include "constrainedTransport.hpp"
+
+// HLLD flux at one interface (T=real) or at a batch of interfaces (T=idfx::Batch), computed
+// from the left and right states without data-dependent branches.
+// All of the intermediate states of the Riemann fan are computed, and the flux of the region
+// containing the interface is then picked with selects. Candidate states which do not match
+// the actual wave pattern may hold meaningless (or non finite) values: they are never
+// selected, and should never be combined arithmetically with the selected ones.
+template<typename Phys, int DIR, typename T>
+KOKKOS_FORCEINLINE_FUNCTION void K_HlldMaskedFlux(const T vL[], const T vR[],
+                                                  const T uL[], const T uR[],
+                                                  const T fluxL[], const T fluxR[],
+                                                  const T sl, const T sr, T flux[]) {
+  using idfx::select;
+  using std::sqrt;
+  using std::fabs;
+
+  EXPAND( constexpr int Xn = DIR+MX1;                    ,
+          constexpr int Xt = (DIR == IDIR ? MX2 : MX1);  ,
+          constexpr int Xb = (DIR == KDIR ? MX2 : MX3);  )
+
+  EXPAND( constexpr int BXn = DIR+BX1;                    ,
+          constexpr int BXt = (DIR == IDIR ? BX2 : BX1);  ,
+          constexpr int BXb = (DIR == KDIR ? BX2 : BX3);   )
+
+  T usL[Phys::nvar];
+  T usR[Phys::nvar];
+
+  T scrh, scrhL, scrhR, duL, duR, sBx, Bx, SM, S1L, S1R;
+
+#if HAVE_ENERGY
+  T ptL  = vL[PRS] + HALF_F* ( EXPAND(vL[BX1]*vL[BX1]     ,
+                                    + vL[BX2]*vL[BX2]   ,
+                                    + vL[BX3]*vL[BX3])  );
+  T ptR  = vR[PRS] + HALF_F* ( EXPAND(vR[BX1]*vR[BX1]     ,
+                                    + vR[BX2]*vR[BX2]   ,
+                                    + vR[BX3]*vR[BX3])  );
+
+  T ussl[Phys::nvar];
+  T ussr[Phys::nvar];
+  T Uhll[Phys::nvar];
+  T pts, sqrL, sqrR;
+  [[maybe_unused]] T vsL, vsR, wsL, wsR, vss, wss;
+
+  // 1-- Compute U*(L), U*(R)
+  scrh = ONE_F/(sr - sl);
+  Bx = (sr*vR[BXn] - sl*vL[BXn])*scrh;
+  sBx  = select(Bx > 0.0, T(ONE_F), T(-ONE_F));
+
+  duL  = sl - vL[Xn];
+  duR  = sr - vR[Xn];
+
+  scrh = ONE_F/(duR*uR[RHO] - duL*uL[RHO]);
+  SM   = (duR*uR[Xn] - duL*uL[Xn] - ptR + ptL)*scrh;
+
+  pts  = duR*uR[RHO]*ptL - duL*uL[RHO]*ptR +
+         vL[RHO]*vR[RHO]*duR*duL*(vR[Xn]- vL[Xn]);
+  pts *= scrh;
+
+  usL[RHO] = uL[RHO]*duL/(sl - SM);
+  usR[RHO] = uR[RHO]*duR/(sr - SM);
+
+  sqrL = sqrt(usL[RHO]);
+  sqrR = sqrt(usR[RHO]);
+
+  S1L = SM - fabs(Bx)/sqrL;
+  S1R = SM + fabs(Bx)/sqrR;
+
+  // Degeneracy when S1L -> sl or S1R -> sr: the transverse field of the * states is
+  // replaced by the HLL one, and the ** states are discarded (see HlldMHD)
+  const auto revert_to_hllc = ( (S1L - sl) <  1.e-4*(SM - sl) )
+                           || ( (S1R - sr) > -1.e-4*(sr - SM) );
+
+  scrh = ONE_F/(sr - sl);
+  EXPAND( Uhll[BXn] = (sr*uR[BXn] - sl*uL[BXn] + fluxL[BXn] - fluxR[BXn])*scrh;  ,
+          Uhll[BXt] = (sr*uR[BXt] - sl*uL[BXt] + fluxL[BXt] - fluxR[BXt])*scrh;  ,
+          Uhll[BXb] = (sr*uR[BXb] - sl*uL[BXb] + fluxL[BXb] - fluxR[BXb])*scrh;  )
+
+  scrhL = (uL[RHO]*duL*duL - Bx*Bx)/(uL[RHO]*duL*(sl - SM) - Bx*Bx);
+  scrhR = (uR[RHO]*duR*duR - Bx*Bx)/(uR[RHO]*duR*(sr - SM) - Bx*Bx);
+
+  EXPAND( usL[BXn] = select(revert_to_hllc, Uhll[BXn], Bx);
+          usR[BXn] = select(revert_to_hllc, Uhll[BXn], Bx);                ,
+          usL[BXt] = select(revert_to_hllc, Uhll[BXt], uL[BXt]*scrhL);
+          usR[BXt] = select(revert_to_hllc, Uhll[BXt], uR[BXt]*scrhR);     ,
+          usL[BXb] = select(revert_to_hllc, Uhll[BXb], uL[BXb]*scrhL);
+          usR[BXb] = select(revert_to_hllc, Uhll[BXb], uR[BXb]*scrhR);     )
+
+  // With S1L = S1R = SM, the ** regions are never selected
+  S1L = select(revert_to_hllc, SM, S1L);
+  S1R = select(revert_to_hllc, SM, S1R);
+
+  scrhL = Bx/(uL[RHO]*duL);
+  scrhR = Bx/(uR[RHO]*duR);
+
+  EXPAND(                                          ;  ,
+          vsL = vL[Xt] - scrhL*(usL[BXt] - uL[BXt]);
+          vsR = vR[Xt] - scrhR*(usR[BXt] - uR[BXt]);  ,
+
+          wsL = vL[Xb] - scrhL*(usL[BXb] - uL[BXb]);
+          wsR = vR[Xb] - scrhR*(usR[BXb] - uR[BXb]);  )
+
+  EXPAND( usL[Xn] = usL[RHO]*SM;
+          usR[Xn] = usR[RHO]*SM;   ,
+
+          usL[Xt] = usL[RHO]*vsL;
+          usR[Xt] = usR[RHO]*vsR;  ,
+
+          usL[Xb] = usL[RHO]*wsL;
+          usR[Xb] = usR[RHO]*wsR;  )
+
+  scrhL  = EXPAND( vL[Xn]*Bx, + vL[Xt]*uL[BXt], + vL[Xb]*uL[BXb]);
+  scrhL -= EXPAND( SM*Bx,     + vsL*usL[BXt],   + wsL*usL[BXb]);
+  usL[ENG]  = duL*uL[ENG] - ptL*vL[Xn] + pts*SM + Bx*scrhL;
+  usL[ENG] /= sl - SM;
+
+  scrhR  = EXPAND(vR[Xn]*Bx, + vR[Xt]*uR[BXt], + vR[Xb]*uR[BXb]);
+  scrhR -= EXPAND(     SM*Bx, +    vsR*usR[BXt], +    wsR*usR[BXb]);
+  usR[ENG] = duR*uR[ENG] - ptR*vR[Xn] + pts*SM + Bx*scrhR;
+  usR[ENG] /= sr - SM;
+
+  // 2-- Compute U**(L), U**(R)
+  ussl[RHO] = usL[RHO];
+  ussr[RHO] = usR[RHO];
+
+  EXPAND(                      ,
+          vss  = sqrL*vsL + sqrR*vsR + (usR[BXt] - usL[BXt])*sBx;
+          vss /= sqrL + sqrR;  ,
+
+          wss  = sqrL*wsL + sqrR*wsR + (usR[BXb] - usL[BXb])*sBx;
+          wss /= sqrL + sqrR;  )
+
+  EXPAND( ussl[Xn] = ussl[RHO]*SM;
+          ussr[Xn] = ussr[RHO]*SM;   ,
+
+          ussl[Xt] = ussl[RHO]*vss;
+          ussr[Xt] = ussr[RHO]*vss;  ,
+
+          ussl[Xb] = ussl[RHO]*wss;
+          ussr[Xb] = ussr[RHO]*wss;  )
+
+  EXPAND( ussl[BXn] = ussr[BXn] = Bx;  ,
+
+          ussl[BXt]  = sqrL*usR[BXt] + sqrR*usL[BXt] + sqrL*sqrR*(vsR - vsL)*sBx;
+          ussl[BXt] /= sqrL + sqrR;
+          ussr[BXt]  = ussl[BXt];       ,
+
+          ussl[BXb]  = sqrL*usR[BXb] + sqrR*usL[BXb] + sqrL*sqrR*(wsR - wsL)*sBx;
+          ussl[BXb] /= sqrL + sqrR;
+          ussr[BXb]  = ussl[BXb];      )
+
+  scrhL  = EXPAND(SM*Bx, +  vsL*usL[BXt], +  wsL*usL[BXb]);
+  scrhL -= EXPAND(SM*Bx, +  vss*ussl[BXt], +  wss*ussl[BXb]);
+
+  scrhR  = EXPAND(SM*Bx, +  vsR*usR[BXt], +  wsR*usR[BXb]);
+  scrhR -= EXPAND(SM*Bx, +  vss*ussr[BXt], +  wss*ussr[BXb]);
+
+  ussl[ENG] = usL[ENG] - sqrL*scrhL*sBx;
+  ussr[ENG] = usR[ENG] + sqrR*scrhR*sBx;
+
+  // 3-- Select the flux of the region containing the interface. The selects are ordered
+  // by increasing priority, which reproduces the if/else cascade of HlldMHD
+#pragma unroll
+  for(int nv = 0 ; nv < Phys::nvar; nv++) {
+    const T fsL = fluxL[nv] + sl*(usL[nv] - uL[nv]);
+    const T fsR = fluxR[nv] + sr*(usR[nv] - uR[nv]);
+    const T fssL = fluxL[nv] + S1L*(ussl[nv]  - usL[nv]) + sl*(usL[nv] - uL[nv]);
+    const T fssR = fluxR[nv] + S1R*(ussr[nv]  - usR[nv]) + sr*(usR[nv] - uR[nv]);
+
+    T f = select(SM >= 0.0, fssL, fssR);      // Regions L** and R**
+    f = select(S1R <= 0.0, fsR, f);           // Region R*
+    f = select(S1L >= 0.0, fsL, f);           // Region L*
+    f = select(sr < 0, fluxR[nv], f);
+    f = select(sl > 0, fluxL[nv], f);
+    flux[nv] = f;
+  }
+#else // No ENERGY
+  T F[Phys::nvar];
+  T usc[Phys::nvar];
+  T rho, sqrho;
+
+  // 1-- Compute the HLLD fluxes of the normal components
+  scrh = ONE_F/(sr - sl);
+  duL = sl - vL[Xn];
+  duR = sr - vR[Xn];
+
+  Bx = (sr*vR[BXn] - sl*vL[BXn])*scrh;
+
+  rho    = (uR[RHO]*duR - uL[RHO]*duL)*scrh;
+  F[RHO] = (sl*uR[RHO]*duR - sr*uL[RHO]*duL)*scrh;
+
+  sqrho = sqrt(rho);
+
+  SM  = F[RHO]/rho;
+  S1L = SM - fabs(Bx)/sqrho;
+  S1R = SM + fabs(Bx)/sqrho;
+
+  // Degeneracy when S1L -> sl or S1R -> sr: revert to HLL
+  const auto revert_to_hll = ( (S1L - sl) <  1.e-4*(sr - sl) )
+                          || ( (S1R - sr) > -1.e-4*(sr - sl) );
+
+  F[Xn] = (sr*fluxL[Xn] - sl*fluxR[Xn]
+          + sr*sl*(uR[Xn] - uL[Xn]))*scrh;
+
+  F[BXn] = sr*sl*(uR[BXn] - uL[BXn])*scrh;
+
+  // 2-- Compute U* and the central state U** = Uc
+  scrhL = ONE_F/((sl - S1L)*(sl - S1R));
+  scrhR = ONE_F/((sr - S1L)*(sr - S1R));
+
+  EXPAND(                                                      ;  ,
+          usL[Xt] = rho*vL[Xt] - Bx*uL[BXt]*(SM - vL[Xn])*scrhL;
+          usR[Xt] = rho*vR[Xt] - Bx*uR[BXt]*(SM - vR[Xn])*scrhR;  ,
+
+          usL[Xb] = rho*vL[Xb] - Bx*uL[BXb]*(SM - vL[Xn])*scrhL;
+          usR[Xb] = rho*vR[Xb] - Bx*uR[BXb]*(SM - vR[Xn])*scrhR;  )
+
+  EXPAND(                                                       ;  ,
+          usL[BXt] = uL[BXt]/rho*(uL[RHO]*duL*duL - Bx*Bx)*scrhL;
+          usR[BXt] = uR[BXt]/rho*(uR[RHO]*duR*duR - Bx*Bx)*scrhR;  ,
+
+          usL[BXb] = uL[BXb]/rho*(uL[RHO]*duL*duL - Bx*Bx)*scrhL;
+          usR[BXb] = uR[BXb]/rho*(uR[RHO]*duR*duR - Bx*Bx)*scrhR;  )
+
+  sBx = select(Bx > 0.0, T(ONE_F), T(-ONE_F));
+
+  EXPAND(                                               ,
+          usc[Xt] = HALF_F*(usR[Xt] + usL[Xt]
+                   + (usR[BXt] - usL[BXt])*sBx*sqrho);  ,
+          usc[Xb] = HALF_F*(   usR[Xb] + usL[Xb]
+                   + (usR[BXb] - usL[BXb])*sBx*sqrho);  )
+
+  EXPAND(                                              ,
+          usc[BXt] = HALF_F*(   usR[BXt] + usL[BXt]
+                    + (usR[Xt] - usL[Xt])*sBx/sqrho);  ,
+          usc[BXb] = HALF_F*(   usR[BXb] + usL[BXb]
+                    + (usR[Xb] - usL[Xb])*sBx/sqrho);  )
+
+  EXPAND(                                             ,
+          F[Xt] = usc[Xt]*SM - Bx*usc[BXt];  ,
+          F[Xb] = usc[Xb]*SM - Bx*usc[BXb];  )
+
+  EXPAND(                                                  ,
+          F[BXt] = usc[BXt]*SM - Bx*usc[Xt]/rho;  ,
+          F[BXb] = usc[BXb]*SM - Bx*usc[Xb]/rho;  )
+
+  // 3-- Select the flux of the region containing the interface. The selects are ordered
+  // by increasing priority, which reproduces the if/else cascade of HlldMHD
+  scrh = ONE_F/(sr - sl);
+#pragma unroll
+  for(int nv = 0 ; nv < Phys::nvar; nv++) {
+    T f = F[nv];
+    // The test on nv is resolved at compile time once the loop is unrolled
+    if(nv != RHO && nv != Xn && nv != BXn) {
+      f = select(S1R <= 0.0, fluxR[nv] + sr*(usR[nv] - uR[nv]), f);  // Region R*
+      f = select(S1L >= 0.0, fluxL[nv] + sl*(usL[nv] - uL[nv]), f);  // Region L*
+    }
+    const T fhll = (sl*sr*(uR[nv] - uL[nv])
+                    + sr*fluxL[nv] - sl*fluxR[nv])*scrh;
+    f = select(revert_to_hll, fhll, f);
+    f = select(sr < 0, fluxR[nv], f);
+    f = select(sl > 0, fluxL[nv], f);
+    flux[nv] = f;
+  }
+#endif
+}
+
+// Compute Riemann fluxes from states using HLLD solver, without data-dependent branches
+// (see K_HlldMaskedFlux). This trades a few useless flops for a kernel body which vectorises
+// along i (see [Hydro] hlld_masked).
+template <typename Phys>
+template<const int DIR>
+void RiemannSolver<Phys>::HlldMaskedMHD(IdefixArray4D<flux_real> &Flux) {
+  idfx::pushRegion("RiemannSolver::HLLD_MHD_Masked");
+
+  using EMF = ConstrainedTransport<Phys>;
+
+  constexpr int ioffset = (DIR==IDIR) ? 1 : 0;
+  constexpr int joffset = (DIR==JDIR) ? 1 : 0;
+  constexpr int koffset = (DIR==KDIR) ? 1 : 0;
+
+  int perpExtension=1;
+  if (hydro->emf->averaging == EMF::uct_hll
+      || hydro->emf->averaging == EMF::uct_hlld) {
+        // Need two cells in the perp direction for these schemes
+        perpExtension= data->nghost[DIR];
+  }
+  // extension in perp to the direction of integration, as required by CT.
+  const int iextend = (DIR==IDIR) ? 0 : perpExtension;
+  #if DIMENSIONS > 1
+    const int jextend = (DIR==JDIR) ? 0 : perpExtension;
+  #else
+    const int jextend = 0;
+  #endif
+  #if DIMENSIONS > 2
+    const int kextend = (DIR==KDIR) ? 0 : perpExtension;
+  #else
+    const int kextend = 0;
+  #endif
+
+  IdefixArray4D<real> Vc = this->Vc;
+  IdefixArray4D<real> Vs = this->Vs;
+  IdefixArray3D<real> cMax = this->cMax;
+
+  // Required for high order interpolations
+  IdefixArray1D<real> dx = this->data->dx[DIR];
+
+  // References to required emf components
+  IdefixArray3D<real> Eb;
+  IdefixArray3D<real> Et;
+
+
+  #ifdef FIXED_EMF
+  // Averaging scheme fixed at compile time: unused store paths are removed from the kernel
+  constexpr typename EMF::AveragingType emfAverage = EMF::FIXED_EMF;
+  #else
+  const typename EMF::AveragingType emfAverage = hydro->emf->averaging;
+  #endif
+
+  // Required by UCT_Contact
+  IdefixArray3D<real> SV;
+
+  // Required by UCT_HLLX
+  IdefixArray3D<real> aL;
+  IdefixArray3D<real> aR;
+  IdefixArray3D<real> dL;
+  IdefixArray3D<real> dR;
+
+  EquationOfState eos = *(hydro->eos.get());
+
+  ExtrapolateToFaces<Phys,DIR> extrapol = *this->GetExtrapolator<DIR>();
+
+  // st and sb will be useful only when Hall is included
+  real st = ONE_F, sb = ONE_F;
+
+  switch(DIR) {
+    case(IDIR):
+      D_EXPAND(
+                st = -ONE_F;  ,
+                  ,
+
+                sb = +ONE_F;  )
+
+      Et = hydro->emf->ezi;
+      Eb = hydro->emf->eyi;
+
+      SV = hydro->emf->svx;
+
+      aL = hydro->emf->axL;
+      aR = hydro->emf->axR;
+
+      dL = hydro->emf->dxL;
+      dR = hydro->emf->dxR;
+
+      break;
+#if DIMENSIONS >= 2
+    case(JDIR):
+      D_EXPAND(
+                st = +ONE_F;  ,
+                              ,
+
+                sb = -ONE_F;  )
+
+      Et = hydro->emf->ezj;
+      Eb = hydro->emf->exj;
+
+      SV = hydro->emf->svy;
+
+      aL = hydro->emf->ayL;
+      aR = hydro->emf->ayR;
+
+      dL = hydro->emf->dyL;
+      dR = hydro->emf->dyR;
+
+      break;
+#endif
+#if DIMENSIONS == 3
+    case(KDIR):
+
+      D_EXPAND(
+
+                st = -ONE_F;  ,
+                  ,
+                sb = +ONE_F;  )
+
+      Et = hydro->emf->eyk;
+      Eb = hydro->emf->exk;
+
+      SV = hydro->emf->svz;
+
+      aL = hydro->emf->azL;
+      aR = hydro->emf->azR;
+
+      dL = hydro->emf->dzL;
+      dR = hydro->emf->dzR;
+      break;
+#endif
+    default:
+      IDEFIX_ERROR("Wrong direction");
+  }
+
+  ForEachInterface<DIR>("CalcRiemannFluxMasked",
+                        data->beg[KDIR]-kextend,data->end[KDIR]+koffset+kextend,
+                        data->beg[JDIR]-jextend,data->end[JDIR]+joffset+jextend,
+                        data->beg[IDIR]-iextend,data->end[IDIR]+ioffset+iextend,
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      // Init the directions (should be in the kernel for proper optimisation by the compilers)
+      EXPAND( constexpr int Xn = DIR+MX1;                    ,
+              constexpr int Xt = (DIR == IDIR ? MX2 : MX1);  ,
+              constexpr int Xb = (DIR == KDIR ? MX2 : MX3);  )
+
+      EXPAND( constexpr int BXn = DIR+BX1;                    ,
+              constexpr int BXt = (DIR == IDIR ? BX2 : BX1);  ,
+              constexpr int BXb = (DIR == KDIR ? BX2 : BX3);   )
+
+      // Primitive variables
+      real vL[Phys::nvar];
+      real vR[Phys::nvar];
+
+      extrapol.ExtrapolatePrimVar(i, j, k, vL, vR);
+      vL[BXn] = Vs(DIR,k,j,i);
+      vR[BXn] = vL[BXn];
+
+      // Conservative variables
+      real uL[Phys::nvar];
+      real uR[Phys::nvar];
+
+      // Flux (left and right)
+      real fluxL[Phys::nvar];
+      real fluxR[Phys::nvar];
+
+      // Signal speeds
+      real cL, cR, cmax, c2Iso;
+
+      // Init c2Isothermal (used only when isothermal approx is set)
+      c2Iso = ZERO_F;
+
+      // 2-- Get the wave speed
+      real gpr, b1, b2, b3, Btmag2, Bmag2;
+#if HAVE_ENERGY
+      real gamma = eos.GetGamma(0.5*(vL[PRS]+vR[PRS]),0.5*(vL[RHO]+vR[RHO]));
+      gpr = gamma*vL[PRS];
+#else
+      c2Iso = HALF_F*(eos.GetWaveSpeed(k,j,i)
+                    +eos.GetWaveSpeed(k-koffset,j-joffset,i-ioffset));
+      c2Iso *= c2Iso;
+
+      gpr = c2Iso*vL[RHO];
+#endif
+
+      // -- get total field
+      b1 = b2 = b3 = ZERO_F;
+      EXPAND ( b1 = vL[BXn];  ,
+               b2 = vL[BXt];  ,
+               b3 = vL[BXb];  )
+
+      Btmag2 = b2*b2 + b3*b3;
+      Bmag2  = b1*b1 + Btmag2;
+
+      cL = gpr - Bmag2;
+      cL = gpr + Bmag2 + std::sqrt(cL*cL + FOUR_F*gpr*Btmag2);
+      cL = std::sqrt(HALF_F*cL/vL[RHO]);
+
+#if HAVE_ENERGY
+      gpr = gamma*vR[PRS];
+#else
+      gpr = c2Iso*vR[RHO];
+#endif
+
+      // -- get total field
+      b1 = b2 = b3 = ZERO_F;
+      EXPAND ( b1 = vR[BXn];  ,
+               b2 = vR[BXt];  ,
+               b3 = vR[BXb];  )
+
+      Btmag2 = b2*b2 + b3*b3;
+      Bmag2  = b1*b1 + Btmag2;
+
+      cR = gpr - Bmag2;
+      cR = gpr + Bmag2 + std::sqrt(cR*cR + FOUR_F*gpr*Btmag2);
+      cR = std::sqrt(HALF_F*cR/vR[RHO]);
+
+      // 4.1
+      real cminL = vL[Xn] - cL;
+      real cmaxL = vL[Xn] + cL;
+
+      real cminR = vR[Xn] - cR;
+      real cmaxR = vR[Xn] + cR;
+
+      real sl = FMIN(cminL, cminR);
+      real sr = FMAX(cmaxL, cmaxR);
+
+      cmax  = std::fmax(FABS(sl), FABS(sr));
+
+      // 2-- Compute the conservative variables
+      K_PrimToCons<Phys>(uL, vL, &eos);
+      K_PrimToCons<Phys>(uR, vR, &eos);
+
+      // 3-- Compute the left and right fluxes
+#pragma unroll
+      for(int nv = 0 ; nv < Phys::nvar; nv++) {
+        fluxL[nv] = uL[nv];
+        fluxR[nv] = uR[nv];
+      }
+
+      K_Flux<Phys,DIR>(fluxL, vL, fluxL, c2Iso);
+      K_Flux<Phys,DIR>(fluxR, vR, fluxR, c2Iso);
+
+      // 5-- Compute the flux from the left and right states
+      real F[Phys::nvar];
+      K_HlldMaskedFlux<Phys,DIR>(vL, vR, uL, uR, fluxL, fluxR, sl, sr, F);
+#pragma unroll
+      for(int nv = 0 ; nv < Phys::nvar; nv++) {
+        Flux(nv,k,j,i) = F[nv];
+      }
+
+      // 6-- Compute maximum wave speed for this sweep
+      cMax(k,j,i) = cmax;
+
+      // 7-- Store the flux in the emf components
+      if (emfAverage==EMF::arithmetic
+                || emfAverage==EMF::uct0) {
+        K_StoreEMF<DIR>(i,j,k,st,sb,Flux,Et,Eb);
+      } else if (emfAverage==EMF::uct_contact) {
+        K_StoreContact<DIR>(i,j,k,st,sb,Flux,Et,Eb,SV);
+      } else if (emfAverage==EMF::uct_hll) {
+        K_StoreHLL<DIR>(i,j,k,st,sb,sl,sr,vL,vR,Et,Eb,aL,aR,dL,dR);
+      } else if (emfAverage==EMF::uct_hlld) {
+        K_StoreHLLD<DIR>(i,j,k,st,sb,c2Iso,sl,sr,vL,vR,uL,uR,Et,Eb,aL,aR,dL,dR);
+      }
+  });
+  idfx::popRegion();
+}
+
+#endif // FLUID_RIEMANNSOLVER_MHDSOLVERS_HLLDMASKEDMHD_HPP_
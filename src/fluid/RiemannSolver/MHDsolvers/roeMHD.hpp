@@ -50,7 +50,7 @@
 // Compute Riemann fluxes from states using ROE solver
 template <typename Phys>
 template<const int DIR>
-void RiemannSolver<Phys>::RoeMHD(IdefixArray4D<real> &Flux) {
+void RiemannSolver<Phys>::RoeMHD(IdefixArray4D<flux_real> &Flux) {
   idfx::pushRegion("RiemannSolver::ROE_MHD");
 
   using EMF = ConstrainedTransport<Phys>;
@@ -83,7 +83,12 @@ void RiemannSolver<Phys>::RoeMHD(IdefixArray4D<real> &Flux) {
   IdefixArray3D<real> Eb;
   IdefixArray3D<real> Et;
 
+  #ifdef FIXED_EMF
+  // Averaging scheme fixed at compile time: unused store paths are removed from the kernel
+  constexpr typename EMF::AveragingType emfAverage = EMF::FIXED_EMF;
+  #else
   const typename EMF::AveragingType emfAverage = hydro->emf->averaging;
+  #endif
 
 
   // Required by UCT_Contact
@@ -172,10 +177,10 @@ void RiemannSolver<Phys>::RoeMHD(IdefixArray4D<real> &Flux) {
       IDEFIX_ERROR("Wrong direction");
   }
 
-  idefix_for("CalcRiemannFlux",
-             data->beg[KDIR]-kextend,data->end[KDIR]+koffset+kextend,
-             data->beg[JDIR]-jextend,data->end[JDIR]+joffset+jextend,
-             data->beg[IDIR]-iextend,data->end[IDIR]+ioffset+iextend,
+  ForEachInterface<DIR>("CalcRiemannFlux",
+                        data->beg[KDIR]-kextend,data->end[KDIR]+koffset+kextend,
+                        data->beg[JDIR]-jextend,data->end[JDIR]+joffset+jextend,
+                        data->beg[IDIR]-iextend,data->end[IDIR]+ioffset+iextend,
     KOKKOS_LAMBDA (int k, int j, int i) {
       // Init the directions (should be in the kernel for proper optimisation by the compilers)
       EXPAND( const int Xn = DIR+MX1;                    ,
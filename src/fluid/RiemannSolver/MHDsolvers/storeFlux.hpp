@@ -14,7 +14,7 @@
 template <const int DIR>
 KOKKOS_FORCEINLINE_FUNCTION void K_StoreEMF( const int i, const int j, const int k,
                                         const real st, const real sb,
-                                        const IdefixArray4D<real> &Flux,
+                                        const IdefixArray4D<flux_real> &Flux,
                                         const IdefixArray3D<real> &Et,
                                         const IdefixArray3D<real> &Eb ) {
   EXPAND(                                           ,
@@ -31,7 +31,7 @@ KOKKOS_FORCEINLINE_FUNCTION void K_StoreEMF( const int i, const int j, const int
 template <const int DIR>
 KOKKOS_FORCEINLINE_FUNCTION void K_StoreContact( const int i, const int j, const int k,
                                         const real st, const real sb,
-                                        const IdefixArray4D<real> &Flux,
+                                        const IdefixArray4D<flux_real> &Flux,
                                         const IdefixArray3D<real> &Et,
                                         const IdefixArray3D<real> &Eb,
                                         const IdefixArray3D<real> &SV) {
@@ -18,7 +18,7 @@
 // Compute Riemann fluxes from states using TVDLF solver
 template <typename Phys>
 template<const int DIR>
-void RiemannSolver<Phys>::TvdlfMHD(IdefixArray4D<real> &Flux) {
+void RiemannSolver<Phys>::TvdlfMHD(IdefixArray4D<flux_real> &Flux) {
   idfx::pushRegion("RiemannSolver::TVDLF_MHD");
 
   using EMF = ConstrainedTransport<Phys>;
@@ -51,7 +51,12 @@ void RiemannSolver<Phys>::TvdlfMHD(IdefixArray4D<real> &Flux) {
   IdefixArray3D<real> Eb;
   IdefixArray3D<real> Et;
 
+  #ifdef FIXED_EMF
+  // Averaging scheme fixed at compile time: unused store paths are removed from the kernel
+  constexpr typename EMF::AveragingType emfAverage = EMF::FIXED_EMF;
+  #else
   const typename EMF::AveragingType emfAverage = hydro->emf->averaging;
+  #endif
 
   // Required by UCT_Contact
   IdefixArray3D<real> SV;
@@ -135,10 +140,10 @@ void RiemannSolver<Phys>::TvdlfMHD(IdefixArray4D<real> &Flux) {
       IDEFIX_ERROR("Wrong direction");
   }
 
-  idefix_for("CalcRiemannFlux",
-             data->beg[KDIR]-kextend,data->end[KDIR]+koffset+kextend,
-             data->beg[JDIR]-jextend,data->end[JDIR]+joffset+jextend,
-             data->beg[IDIR]-iextend,data->end[IDIR]+ioffset+iextend,
+  ForEachInterface<DIR>("CalcRiemannFlux",
+                        data->beg[KDIR]-kextend,data->end[KDIR]+koffset+kextend,
+                        data->beg[JDIR]-jextend,data->end[JDIR]+joffset+jextend,
+                        data->beg[IDIR]-iextend,data->end[IDIR]+ioffset+iextend,
     KOKKOS_LAMBDA (int k, int j, int i) {
       // Init the directions (should be in the kernel for proper optimisation by the compilers)
       const int Xn = DIR+MX1;
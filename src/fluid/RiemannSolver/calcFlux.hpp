@@ -10,13 +10,17 @@
 
 #if MHD == YES
 #include "hlldMHD.hpp"
+#include "hlldMaskedMHD.hpp"
+#include "hlldBatchMHD.hpp"
 #include "hllMHD.hpp"
 #include "roeMHD.hpp"
 #include "tvdlfMHD.hpp"
 #endif
 
 #include "hllcHD.hpp"
+#include "hllcHDBatch.hpp"
 #include "hllHD.hpp"
+#include "hllHDBatch.hpp"
 #include "tvdlfHD.hpp"
 #include "roeHD.hpp"
 #include "hllDust.hpp"
@@ -26,7 +30,7 @@
 // Compute Riemann fluxes from states
 template <typename Phys>
 template <int dir>
-void RiemannSolver<Phys>::CalcFlux(IdefixArray4D<real> &flux) {
+void RiemannSolver<Phys>::CalcFlux(IdefixArray4D<flux_real> &flux) {
   idfx::pushRegion("RiemannSolver::CalcFlux");
   if constexpr(dir == IDIR) {
     // enable shock flattening
@@ -34,21 +38,43 @@ void RiemannSolver<Phys>::CalcFlux(IdefixArray4D<real> &flux) {
   }
 
   if constexpr(Phys::mhd) {
-    switch (mySolver) {
-      case TVDLF_MHD:
-        TvdlfMHD<dir>(flux);
-        break;
-      case HLL_MHD:
-        HllMHD<dir>(flux);
-        break;
-      case HLLD_MHD:
+    if constexpr(fixedSolver == FixedSolver::tvdlf) {
+      TvdlfMHD<dir>(flux);
+    } else if constexpr(fixedSolver == FixedSolver::hll) {
+      HllMHD<dir>(flux);
+    } else if constexpr(fixedSolver == FixedSolver::hlld) {
+      if constexpr(simdWidth > 0) {
+        HlldBatchMHD<dir>(flux);
+      } else if(haveMaskedHlld) {
+        HlldMaskedMHD<dir>(flux);
+      } else {
         HlldMHD<dir>(flux);
-        break;
-      case ROE_MHD:
-        RoeMHD<dir>(flux);
-        break;
-      default:
-        break;
+      }
+    } else if constexpr(fixedSolver == FixedSolver::roe) {
+      RoeMHD<dir>(flux);
+    } else {
+      switch (mySolver) {
+        case TVDLF_MHD:
+          TvdlfMHD<dir>(flux);
+          break;
+        case HLL_MHD:
+          HllMHD<dir>(flux);
+          break;
+        case HLLD_MHD:
+          if constexpr(simdWidth > 0) {
+            HlldBatchMHD<dir>(flux);
+          } else if(haveMaskedHlld) {
+            HlldMaskedMHD<dir>(flux);
+          } else {
+            HlldMHD<dir>(flux);
+          }
+          break;
+        case ROE_MHD:
+          RoeMHD<dir>(flux);
+          break;
+        default:
+          break;
+      }
     }
   } else {
     if constexpr(Phys::dust) {
@@ -62,25 +88,192 @@ void RiemannSolver<Phys>::CalcFlux(IdefixArray4D<real> &flux) {
       }
     } else {
       // Default hydro solvers
-      switch (mySolver) {
-        case TVDLF:
-          TvdlfHD<dir>(flux);
-          break;
-        case HLL:
+      if constexpr(fixedSolver == FixedSolver::tvdlf) {
+        TvdlfHD<dir>(flux);
+      } else if constexpr(fixedSolver == FixedSolver::hll) {
+        if constexpr(simdWidth > 0) {
+          HllHDBatch<dir>(flux);
+        } else {
           HllHD<dir>(flux);
-          break;
-        case HLLC:
+        }
+      } else if constexpr(fixedSolver == FixedSolver::hllc) {
+        if constexpr(simdWidth > 0) {
+          HllcHDBatch<dir>(flux);
+        } else {
           HllcHD<dir>(flux);
-          break;
-        case ROE:
-          RoeHD<dir>(flux);
-          break;
-        default: // do nothing
-          IDEFIX_ERROR("Internal error: Unknown solver");
-          break;
+        }
+      } else if constexpr(fixedSolver == FixedSolver::roe) {
+        RoeHD<dir>(flux);
+      } else {
+        switch (mySolver) {
+          case TVDLF:
+            TvdlfHD<dir>(flux);
+            break;
+          case HLL:
+            if constexpr(simdWidth > 0) {
+              HllHDBatch<dir>(flux);
+            } else {
+              HllHD<dir>(flux);
+            }
+            break;
+          case HLLC:
+            if constexpr(simdWidth > 0) {
+              HllcHDBatch<dir>(flux);
+            } else {
+              HllcHD<dir>(flux);
+            }
+            break;
+          case ROE:
+            RoeHD<dir>(flux);
+            break;
+          default: // do nothing
+            IDEFIX_ERROR("Internal error: Unknown solver");
+            break;
+        }
       }
     }// Dust
   }
+  if(HaveCoarseInterfaces(dir)) FillCoarseInterfaces<dir>(flux);
+  idfx::popRegion();
+}
+
+// Interpolation of a face quantity between the faces of a coarsened cell
+KOKKOS_FORCEINLINE_FUNCTION real K_CoarseInterpolate(const IdefixArray3D<real> &q, const real w,
+                                                    const int kl, const int jl, const int il,
+                                                    const int kr, const int jr, const int ir) {
+  return q(kl,jl,il) + w*(q(kr,jr,ir) - q(kl,jl,il));
+}
+
+// Fluxes at the interfaces internal to the coarsened cells, which have been skipped by the
+// Riemann solver. The area-weighted fluxes are interpolated linearly in volume between the faces
+// of each coarsened cell, so that all of the cells of a group receive the update of the coarse
+// cell. The signal speed is the largest one of the faces.
+// In MHD, the face EMFs (and the upwinding weights of the UCT schemes) are interpolated in the
+// same way, so that CalcCornerEMF never reads values left in these scratch arrays by a previous
+// stage or another phase. They only enter the corner EMFs of edges internal to the coarsened
+// cells, whose contributions cancel out when DataBlock::Coarsen averages the transverse field
+// components and rebuilds the normal one.
+template <typename Phys>
+template <int dir>
+void RiemannSolver<Phys>::FillCoarseInterfaces(IdefixArray4D<flux_real> &flux) {
+  idfx::pushRegion("RiemannSolver::FillCoarseInterfaces");
+  constexpr int ioffset = (dir==IDIR) ? 1 : 0;
+  constexpr int joffset = (dir==JDIR) ? 1 : 0;
+  constexpr int koffset = (dir==KDIR) ? 1 : 0;
+
+  const CoarseInterfaces &list = coarseInterfaces[dir];
+  IdefixArray3D<real> cMax = this->cMax;
+  IdefixArray3D<real> A = data->A[dir];
+  IdefixArray3D<real> dV = data->dV;
+  IdefixArray2D<int> coarseningLevel = data->coarseningLevel[dir];
+  const int begDir = data->beg[dir];
+
+  // Face EMFs stored by the MHD solvers
+  [[maybe_unused]] IdefixArray3D<real> Et, Eb, SV, aL, aR, dL, dR;
+  [[maybe_unused]] bool haveContact = false;
+  [[maybe_unused]] bool haveHLL = false;
+  if constexpr(Phys::mhd) {
+    using EMF = ConstrainedTransport<Phys>;
+    auto emf = hydro->emf.get();
+    haveContact = (emf->averaging == EMF::uct_contact);
+    haveHLL = (emf->averaging == EMF::uct_hll || emf->averaging == EMF::uct_hlld);
+    if constexpr(dir == IDIR) {
+      Et = emf->ezi;
+      Eb = emf->eyi;
+      SV = emf->svx;
+      aL = emf->axL;
+      aR = emf->axR;
+      dL = emf->dxL;
+      dR = emf->dxR;
+    }
+    if constexpr(dir == JDIR) {
+      Et = emf->ezj;
+      Eb = emf->exj;
+      SV = emf->svy;
+      aL = emf->ayL;
+      aR = emf->ayR;
+      dL = emf->dyL;
+      dR = emf->dyR;
+    }
+    if constexpr(dir == KDIR) {
+      Et = emf->eyk;
+      Eb = emf->exk;
+      SV = emf->svz;
+      aL = emf->azL;
+      aR = emf->azR;
+      dL = emf->dzL;
+      dR = emf->dzR;
+    }
+  }
+
+  idefix_for("FillCoarseInterfaces",
+             list.beg[KDIR], list.end[KDIR],
+             list.beg[JDIR], list.end[JDIR],
+             list.beg[IDIR], list.end[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      int level, index;
+      if constexpr(dir == IDIR) {
+        level = coarseningLevel(k,j);
+        index = i;
+      }
+      if constexpr(dir == JDIR) {
+        level = coarseningLevel(k,i);
+        index = j;
+      }
+      if constexpr(dir == KDIR) {
+        level = coarseningLevel(j,i);
+        index = k;
+      }
+      const int factor = 1 << (level - 1);
+      const int shift = (index - begDir) % factor;
+      if(shift == 0) return;
+
+      // Left and right faces of the coarsened cell
+      const int kl = k - shift*koffset;
+      const int jl = j - shift*joffset;
+      const int il = i - shift*ioffset;
+      const int kr = kl + factor*koffset;
+      const int jr = jl + factor*joffset;
+      const int ir = il + factor*ioffset;
+
+      // Fraction of the volume of the coarsened cell on the left of the interface
+      real V = ZERO_F;
+      real Vl = ZERO_F;
+      for(int s = 0 ; s < factor ; s++) {
+        const real dv = dV(kl + s*koffset, jl + s*joffset, il + s*ioffset);
+        if(s < shift) Vl += dv;
+        V += dv;
+      }
+      const real w = Vl/V;
+      const real Al = A(kl,jl,il);
+      const real Ar = A(kr,jr,ir);
+      const real invA = ONE_F/A(k,j,i);
+
+#pragma unroll
+      for(int nv = 0 ; nv < Phys::nvar ; nv++) {
+        const real Fl = Al*flux(nv,kl,jl,il);
+        const real Fr = Ar*flux(nv,kr,jr,ir);
+        flux(nv,k,j,i) = (Fl + w*(Fr - Fl))*invA;
+      }
+      cMax(k,j,i) = FMAX(cMax(kl,jl,il), cMax(kr,jr,ir));
+
+      if constexpr(Phys::mhd) {
+        #if COMPONENTS > 1
+          D_EXPAND( Et(k,j,i) = K_CoarseInterpolate(Et, w, kl, jl, il, kr, jr, ir);  ,
+                                                                                      ,
+                    Eb(k,j,i) = K_CoarseInterpolate(Eb, w, kl, jl, il, kr, jr, ir);  )
+        #endif
+        if(haveContact) {
+          SV(k,j,i) = K_CoarseInterpolate(SV, w, kl, jl, il, kr, jr, ir);
+        }
+        if(haveHLL) {
+          aL(k,j,i) = K_CoarseInterpolate(aL, w, kl, jl, il, kr, jr, ir);
+          aR(k,j,i) = K_CoarseInterpolate(aR, w, kl, jl, il, kr, jr, ir);
+          dL(k,j,i) = K_CoarseInterpolate(dL, w, kl, jl, il, kr, jr, ir);
+          dR(k,j,i) = K_CoarseInterpolate(dR, w, kl, jl, il, kr, jr, ir);
+        }
+      }
+    });
   idfx::popRegion();
 }
 #endif // FLUID_RIEMANNSOLVER_CALCFLUX_HPP_
@@ -0,0 +1,101 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include "coarseInterfaces.hpp"
+#include "dataBlock.hpp"
+
+void CoarseInterfaces::Update(DataBlock *data, const int dir,
+                              const std::array<int,3> &boxBeg,
+                              const std::array<int,3> &boxEnd) {
+  const bool sameBox = (boxBeg == beg) && (boxEnd == end);
+  if(sameBox && revision == data->coarseningLevelsRevision) return;
+
+  idfx::pushRegion("CoarseInterfaces::Update");
+  // Coarsening levels are indexed by the two directions normal to dir
+  const int Xt = (dir == IDIR ? JDIR : IDIR);
+  const int Xb = (dir == KDIR ? JDIR : KDIR);
+
+  // NB: a new copy of the levels, which is kept for the next comparison
+  IdefixHostArray2D<int> levelsHost = Kokkos::create_mirror(Kokkos::HostSpace(),
+                                                            data->coarseningLevel[dir]);
+  Kokkos::deep_copy(levelsHost, data->coarseningLevel[dir]);
+  revision = data->coarseningLevelsRevision;
+
+  // The levels have been recomputed (dynamic coarsening), but may not have changed
+  if(sameBox && levels.extent(0) == levelsHost.extent(0)
+             && levels.extent(1) == levelsHost.extent(1)) {
+    bool sameLevels = true;
+    for(int b = beg[Xb] ; b < end[Xb] && sameLevels ; b++) {
+      for(int t = beg[Xt] ; t < end[Xt] ; t++) {
+        if(levels(b,t) != levelsHost(b,t)) {
+          sameLevels = false;
+          break;
+        }
+      }
+    }
+    if(sameLevels) {
+      idfx::popRegion();
+      return;
+    }
+  }
+  levels = levelsHost;
+  beg = boxBeg;
+  end = boxEnd;
+
+  // Offset of each line of interfaces along dir in the list. On a line with a coarsening
+  // factor f, only one interface every f is kept, starting from the beginning of the active
+  // domain, as in Fluid::CoarsenFlow.
+  const int nb = end[Xb] - beg[Xb];
+  const int nt = end[Xt] - beg[Xt];
+  const int nf = end[dir] - beg[dir];
+  IdefixHostArray1D<int> offsetHost("CoarseInterfaces_offsetHost", nb*nt+1);
+  offsetHost(0) = 0;
+  for(int b = 0 ; b < nb ; b++) {
+    for(int t = 0 ; t < nt ; t++) {
+      const int line = b*nt + t;
+      const int factor = 1 << (levelsHost(b+beg[Xb], t+beg[Xt]) - 1);
+      offsetHost(line+1) = offsetHost(line) + (nf - 1)/factor + 1;
+    }
+  }
+  size = offsetHost(nb*nt);
+
+  if(index[IDIR].extent(0) < size) {
+    for(int d = 0 ; d < 3 ; d++) {
+      index[d] = IdefixArray1D<int>("CoarseInterfaces_index", size);
+    }
+  }
+
+  IdefixArray1D<int> offset("CoarseInterfaces_offset", nb*nt+1);
+  Kokkos::deep_copy(offset, offsetHost);
+
+  IdefixArray2D<int> coarseningLevel = data->coarseningLevel[dir];
+  IdefixArray1D<int> iList = index[IDIR];
+  IdefixArray1D<int> jList = index[JDIR];
+  IdefixArray1D<int> kList = index[KDIR];
+  const int begDir = beg[dir];
+  const int endDir = end[dir];
+  const int begT = beg[Xt];
+  const int begB = beg[Xb];
+
+  idefix_for("CoarseInterfaces_Fill", 0, nb, 0, nt,
+    KOKKOS_LAMBDA (int b, int t) {
+      const int factor = 1 << (coarseningLevel(b+begB, t+begT) - 1);
+      int n = offset(b*nt + t);
+      int idx[3];
+      idx[Xt] = t + begT;
+      idx[Xb] = b + begB;
+      for(int f = begDir ; f < endDir ; f += factor) {
+        idx[dir] = f;
+        iList(n) = idx[IDIR];
+        jList(n) = idx[JDIR];
+        kList(n) = idx[KDIR];
+        n++;
+      }
+    });
+
+  idfx::popRegion();
+}
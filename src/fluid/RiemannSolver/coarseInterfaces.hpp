@@ -0,0 +1,41 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef FLUID_RIEMANNSOLVER_COARSEINTERFACES_HPP_
+#define FLUID_RIEMANNSOLVER_COARSEINTERFACES_HPP_
+
+#include <array>
+
+#include "idefix.hpp"
+
+class DataBlock;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+/// The CoarseInterfaces class holds the compacted list of the interfaces normal to one direction
+/// at which the Riemann solver is called when grid coarsening only requires the fluxes on the
+/// faces of the coarsened cells ([Grid] coarseningFluxes coarse). The interfaces internal to a
+/// group of cells averaged by DataBlock::Coarsen are left out of the list.
+/// The list is only rebuilt when the loop bounds or the coarsening levels have changed.
+//////////////////////////////////////////////////////////////////////////////////////////////////
+class CoarseInterfaces {
+ public:
+  // Build the list of the interfaces normal to dir in the box [boxBeg,boxEnd[
+  void Update(DataBlock *, int dir, const std::array<int,3> &boxBeg,
+                                    const std::array<int,3> &boxEnd);
+
+  int size{0};                               ///< number of interfaces in the list
+  std::array<IdefixArray1D<int>,3> index;    ///< (i,j,k) indices of the interfaces
+
+  std::array<int,3> beg{0, 0, 0};            ///< box of the last update (first index)
+  std::array<int,3> end{0, 0, 0};            ///< box of the last update (last index+1)
+
+ private:
+  int revision{-1};                          ///< revision of the coarsening levels in use
+  IdefixHostArray2D<int> levels;             ///< coarsening levels in use
+};
+
+#endif // FLUID_RIEMANNSOLVER_COARSEINTERFACES_HPP_
@@ -11,6 +11,7 @@
 #include "dataBlock.hpp"
 #include "shockFlattening.hpp"
 #include "slopeLimiter.hpp"
+#include "simdBatch.hpp"
 
 // Build a left and right extrapolation of the primitive variables along direction dir
 
@@ -36,46 +37,88 @@ class ExtrapolateToFaces {
               flags = rSolver->shockFlattening->flagArray;
             }
             if(!isRegularGrid) {
-              ComputePLMweights(rSolver->hydro->data);
+              // Weights shared by all of the fluids of the datablock
+              ReconstructionWeights &weights = rSolver->hydro->data->reconstructionWeights;
+              if constexpr(order == 2) {
+                const ReconstructionWeights::PLM &plm = weights.GetPLM(dir);
+                cpArray = plm.cp;
+                cmArray = plm.cm;
+                dpArray = plm.dp;
+                dmArray = plm.dm;
+                wpArray = plm.wp;
+                wmArray = plm.wm;
+              } else if constexpr(order == 4) {
+                ppmWeights = weights.GetPPM(dir);
+              } else if constexpr(order == 5) {
+                hoWeights = weights.GetHighOrder(dir);
+              }
             }
   }
 
-  void ComputePLMweights(DataBlock *data) {
-    // Allocate weight arrays
-    cpArray = IdefixArray1D<real>("ExtrapolateToFaces_cp",data->np_tot[dir]);
-    cmArray = IdefixArray1D<real>("ExtrapolateToFaces_cm",data->np_tot[dir]);
-    dpArray = IdefixArray1D<real>("ExtrapolateToFaces_dp",data->np_tot[dir]);
-    dmArray = IdefixArray1D<real>("ExtrapolateToFaces_dm",data->np_tot[dir]);
-    wpArray = IdefixArray1D<real>("ExtrapolateToFaces_wp",data->np_tot[dir]);
-    wmArray = IdefixArray1D<real>("ExtrapolateToFaces_wm",data->np_tot[dir]);
-
-    auto dx = data->dx[dir];
-    auto xgc = data->xgc[dir];
-    auto xr = data->xr[dir];
-    auto wp = wpArray;
-    auto wm = wmArray;
-    auto cp = cpArray;
-    auto cm = cmArray;
-    auto dp = dpArray;
-    auto dm = dmArray;
-
-    idefix_for("ComputePLMweights",1,data->np_tot[dir]-1,
-                KOKKOS_LAMBDA(const int i) {
-                  wp(i) = dx(i) / (xgc(i+1) - xgc(i));
-                  wm(i) = dx(i) / (xgc(i) - xgc(i-1));
-                  cp(i) = (xgc(i+1) - xgc(i)) / (xr(i) - xgc(i));
-                  cm(i) = (xgc(i) - xgc(i-1)) / (xgc(i) - xr(i-1));
-                  dp(i) = (xr(i) - xgc(i)) / dx(i);
-                  dm(i) = (xgc(i) - xr(i-1)) / dx(i);
-                });
+  // PPM states of the cell index, from the cells index-2..index+2
+  KOKKOS_FORCEINLINE_FUNCTION void GetPPMStates(const real vm2, const real vm1, const real v0,
+                                                const real vp1, const real vp2, const int index,
+                                                real &vl, real &vr) const {
+    if(isRegularGrid) {
+      SL::getPPMStates(vm2, vm1, v0, vp1, vp2, vl, vr);
+    } else {
+      // The left face of the cell is the right face of the previous one
+      vl = ppmWeights(index-1,0)*vm2 + ppmWeights(index-1,1)*vm1
+          + ppmWeights(index-1,2)*v0 + ppmWeights(index-1,3)*vp1;
+      vr = ppmWeights(index,0)*vm1 + ppmWeights(index,1)*v0
+          + ppmWeights(index,2)*vp1 + ppmWeights(index,3)*vp2;
+      SL::limitPPMStates(vm2, vm1, v0, vp1, vp2, vl, vr);
+    }
+  }
+
+  static constexpr int nFaceWeights = ReconstructionWeights::nFaceWeights;
+
+  // 5th order reconstruction (WENO5-Z, or MP5 with Idefix_RECONSTRUCTION=MP5) of the right
+  // (face=0) or left (face=1) face value of the cell index, from the cells index-2..index+2
+  template<int face>
+  KOKKOS_FORCEINLINE_FUNCTION real GetHighOrderState(const real v[], const int index) const {
+    real c[nFaceWeights];
+    if(isRegularGrid) {
+      // Uniform grid weights, the left face being the mirror of the right face
+      constexpr real r[nFaceWeights] = {2.0/6.0, -7.0/6.0, 11.0/6.0,
+                                        -1.0/6.0, 5.0/6.0, 2.0/6.0,
+                                        2.0/6.0, 5.0/6.0, -1.0/6.0,
+                                        0.1, 0.6, 0.3,
+                                        2.0/60.0, -13.0/60.0, 47.0/60.0, 27.0/60.0, -3.0/60.0};
+      constexpr real l[nFaceWeights] = {-1.0/6.0, 5.0/6.0, 2.0/6.0,
+                                        2.0/6.0, 5.0/6.0, -1.0/6.0,
+                                        11.0/6.0, -7.0/6.0, 2.0/6.0,
+                                        0.3, 0.6, 0.1,
+                                        -3.0/60.0, 27.0/60.0, 47.0/60.0, -13.0/60.0, 2.0/60.0};
+      for(int n = 0 ; n < nFaceWeights ; n++) c[n] = (face == 0) ? r[n] : l[n];
+    } else {
+      for(int n = 0 ; n < nFaceWeights ; n++) c[n] = hoWeights(index,face*nFaceWeights+n);
+    }
+
+    #ifdef RECONSTRUCTION_MP5
+      const real vor = c[12]*v[0] + c[13]*v[1] + c[14]*v[2] + c[15]*v[3] + c[16]*v[4];
+      if constexpr(face == 0) {
+        return(SL::getMP5State(v[0], v[1], v[2], v[3], v[4], vor));
+      } else {
+        return(SL::getMP5State(v[4], v[3], v[2], v[1], v[0], vor));
+      }
+    #else
+      const real q0 = c[0]*v[0] + c[1]*v[1] + c[2]*v[2];
+      const real q1 = c[3]*v[1] + c[4]*v[2] + c[5]*v[3];
+      const real q2 = c[6]*v[2] + c[7]*v[3] + c[8]*v[4];
+      return(SL::getWENOZState(v[0], v[1], v[2], v[3], v[4], q0, q1, q2, c[9], c[10], c[11]));
+    #endif
   }
 
 
 
+  // n0 is the first variable of the fluid in Vc (non zero for the dust species of the shared
+  // storage, whose fluxes are all computed in the same kernel)
   KOKKOS_FORCEINLINE_FUNCTION void ExtrapolatePrimVar(const int i,
                                                     const int j,
                                                     const int k,
-                                                    real vL[], real vR[]) const {
+                                                    real vL[], real vR[],
+                                                    const int n0 = 0) const {
     // 1-- Store the primitive variables on the left, right, and averaged states
     constexpr int ioffset = (dir==IDIR ? 1 : 0);
     constexpr int joffset = (dir==JDIR ? 1 : 0);
@@ -83,16 +126,16 @@ class ExtrapolateToFaces {
 
     for(int nv = 0 ; nv < Phys::nvar ; nv++) {
       if constexpr(order == 1) {
-        vL[nv] = Vc(nv,k-koffset,j-joffset,i-ioffset);
-        vR[nv] = Vc(nv,k,j,i);
+        vL[nv] = Vc(n0+nv,k-koffset,j-joffset,i-ioffset);
+        vR[nv] = Vc(n0+nv,k,j,i);
       } else if constexpr(order == 2) {
         if(isRegularGrid) {
           /////////////////////////////////////
           // Regular Grid, PLM reconstruction
           /////////////////////////////////////
-          real dvm = Vc(nv,k-koffset,j-joffset,i-ioffset)
-                    -Vc(nv,k-2*koffset,j-2*joffset,i-2*ioffset);
-          real dvp = Vc(nv,k,j,i)-Vc(nv,k-koffset,j-joffset,i-ioffset);
+          real dvm = Vc(n0+nv,k-koffset,j-joffset,i-ioffset)
+                    -Vc(n0+nv,k-2*koffset,j-2*joffset,i-2*ioffset);
+          real dvp = Vc(n0+nv,k,j,i)-Vc(n0+nv,k-koffset,j-joffset,i-ioffset);
 
           real dv;
           if(shockFlattening) {
@@ -106,10 +149,10 @@ class ExtrapolateToFaces {
             dv = SL::PLMLim(dvp,dvm);
           }
 
-          vL[nv] = Vc(nv,k-koffset,j-joffset,i-ioffset) + HALF_F*dv;
+          vL[nv] = Vc(n0+nv,k-koffset,j-joffset,i-ioffset) + HALF_F*dv;
 
           dvm = dvp;
-          dvp = Vc(nv,k+koffset,j+joffset,i+ioffset) - Vc(nv,k,j,i);
+          dvp = Vc(n0+nv,k+koffset,j+joffset,i+ioffset) - Vc(n0+nv,k,j,i);
 
           if(shockFlattening) {
             if(flags(k,j,i) == FlagShock::Shock) {
@@ -121,16 +164,16 @@ class ExtrapolateToFaces {
             dv = SL::PLMLim(dvp,dvm);
           }
 
-          vR[nv] = Vc(nv,k,j,i) - HALF_F*dv;
+          vR[nv] = Vc(n0+nv,k,j,i) - HALF_F*dv;
         } else {
           /////////////////////////////////////
           // Irregular Grid, PLM reconstruction
           /////////////////////////////////////
           const int index = ioffset*i + joffset*j + koffset*k;
 
-          real dvm = Vc(nv,k-koffset,j-joffset,i-ioffset)
-                    -Vc(nv,k-2*koffset,j-2*joffset,i-2*ioffset);
-          real dvp = Vc(nv,k,j,i)-Vc(nv,k-koffset,j-joffset,i-ioffset);
+          real dvm = Vc(n0+nv,k-koffset,j-joffset,i-ioffset)
+                    -Vc(n0+nv,k-2*koffset,j-2*joffset,i-2*ioffset);
+          real dvp = Vc(n0+nv,k,j,i)-Vc(n0+nv,k-koffset,j-joffset,i-ioffset);
 
           dvm *= wmArray(index-1);
           dvp *= wpArray(index-1);
@@ -149,10 +192,10 @@ class ExtrapolateToFaces {
             dv = SL::PLMLim(dvp,dvm,cp,cm);
           }
 
-          vL[nv] = Vc(nv,k-koffset,j-joffset,i-ioffset) + dpArray(index-1)*dv;
+          vL[nv] = Vc(n0+nv,k-koffset,j-joffset,i-ioffset) + dpArray(index-1)*dv;
 
-          dvm = Vc(nv,k,j,i)-Vc(nv,k-koffset,j-joffset,i-ioffset);
-          dvp = Vc(nv,k+koffset,j+joffset,i+ioffset) - Vc(nv,k,j,i);
+          dvm = Vc(n0+nv,k,j,i)-Vc(n0+nv,k-koffset,j-joffset,i-ioffset);
+          dvp = Vc(n0+nv,k+koffset,j+joffset,i+ioffset) - Vc(n0+nv,k,j,i);
           dvm *= wmArray(index);
           dvp *= wpArray(index);
           cp = cpArray(index);
@@ -167,15 +210,15 @@ class ExtrapolateToFaces {
           } else { // No shock flattening
             dv = SL::PLMLim(dvp,dvm,cp,cm);
           }
-          vR[nv] = Vc(nv,k,j,i) - dmArray(index)*dv;
+          vR[nv] = Vc(n0+nv,k,j,i) - dmArray(index)*dv;
         } // Regular grid
 
       } else if constexpr(order == 3) {
           // 1D index along the chosen direction
           const int index = ioffset*i + joffset*j + koffset*k;
-          real dvm = Vc(nv,k-koffset,j-joffset,i-ioffset)
-                    -Vc(nv,k-2*koffset,j-2*joffset,i-2*ioffset);
-          real dvp = Vc(nv,k,j,i)-Vc(nv,k-koffset,j-joffset,i-ioffset);
+          real dvm = Vc(n0+nv,k-koffset,j-joffset,i-ioffset)
+                    -Vc(n0+nv,k-2*koffset,j-2*joffset,i-2*ioffset);
+          real dvp = Vc(n0+nv,k,j,i)-Vc(n0+nv,k-koffset,j-joffset,i-ioffset);
 
           // Limo3 limiter
           real dv;
@@ -190,14 +233,14 @@ class ExtrapolateToFaces {
               dv = dvp * SL::LimO3Lim(dvp, dvm, dx(index-1));
           }
 
-          vL[nv] = Vc(nv,k-koffset,j-joffset,i-ioffset) + HALF_F*dv;
+          vL[nv] = Vc(n0+nv,k-koffset,j-joffset,i-ioffset) + HALF_F*dv;
 
           // Check positivity
           if(nv==RHO) {
             // If face element is negative, revert to minmod
             if(vL[nv] <= 0.0) {
               dv = SL::MinModLim(dvp,dvm);
-              vL[nv] = Vc(nv,k-koffset,j-joffset,i-ioffset) + HALF_F*dv;
+              vL[nv] = Vc(n0+nv,k-koffset,j-joffset,i-ioffset) + HALF_F*dv;
             }
           }
           if constexpr(Phys::pressure) {
@@ -205,13 +248,13 @@ class ExtrapolateToFaces {
               // If face element is negative, revert to minmod
               if(vL[nv] <= 0.0) {
                 dv = SL::MinModLim(dvp,dvm);
-                vL[nv] = Vc(nv,k-koffset,j-joffset,i-ioffset) + HALF_F*dv;
+                vL[nv] = Vc(n0+nv,k-koffset,j-joffset,i-ioffset) + HALF_F*dv;
               }
             }
           }
 
           dvm = dvp;
-          dvp = Vc(nv,k+koffset,j+joffset,i+ioffset) - Vc(nv,k,j,i);
+          dvp = Vc(n0+nv,k+koffset,j+joffset,i+ioffset) - Vc(n0+nv,k,j,i);
 
           // Limo3 limiter
           if(shockFlattening) {
@@ -225,14 +268,14 @@ class ExtrapolateToFaces {
             dv = dvm * SL::LimO3Lim(dvm, dvp, dx(index));
           }
 
-          vR[nv] = Vc(nv,k,j,i) - HALF_F*dv;
+          vR[nv] = Vc(n0+nv,k,j,i) - HALF_F*dv;
 
           // Check positivity
           if(nv==RHO) {
             // If face element is negative, revert to vanleer
             if(vR[nv] <= 0.0) {
               dv = SL::MinModLim(dvp,dvm);
-              vR[nv] = Vc(nv,k,j,i) - HALF_F*dv;
+              vR[nv] = Vc(n0+nv,k,j,i) - HALF_F*dv;
             }
           }
           if constexpr(Phys::pressure) {
@@ -240,20 +283,23 @@ class ExtrapolateToFaces {
               // If face element is negative, revert to vanleer
               if(vR[nv] <= 0.0) {
                 dv = SL::MinModLim(dvp,dvm);
-                vR[nv] = Vc(nv,k,j,i) - HALF_F*dv;
+                vR[nv] = Vc(n0+nv,k,j,i) - HALF_F*dv;
               }
             }
           }
       } else if constexpr(order == 4) {
           // Reconstruction in cell i-1
-          real vm2 = Vc(nv,k-3*koffset,j-3*joffset,i-3*ioffset);;
-          real vm1 = Vc(nv,k-2*koffset,j-2*joffset,i-2*ioffset);
-          real v0 = Vc(nv,k-koffset,j-joffset,i-ioffset);
-          real vp1 = Vc(nv,k,j,i);
-          real vp2 = Vc(nv,k+koffset,j+joffset,i+ioffset);
+          real vm2 = Vc(n0+nv,k-3*koffset,j-3*joffset,i-3*ioffset);;
+          real vm1 = Vc(n0+nv,k-2*koffset,j-2*joffset,i-2*ioffset);
+          real v0 = Vc(n0+nv,k-koffset,j-joffset,i-ioffset);
+          real vp1 = Vc(n0+nv,k,j,i);
+          real vp2 = Vc(n0+nv,k+koffset,j+joffset,i+ioffset);
+
+          // 1D index along the chosen direction
+          const int index = ioffset*i + joffset*j + koffset*k;
 
           real vr,vl;
-          SL::getPPMStates(vm2, vm1, v0, vp1, vp2, vl, vr);
+          GetPPMStates(vm2, vm1, v0, vp1, vp2, index-1, vl, vr);
           // vL= left side of current interface (i-1/2)= right side of cell i-1
 
           // Check positivity
@@ -281,9 +327,9 @@ class ExtrapolateToFaces {
           vm1 = v0;
           v0 = vp1;
           vp1 = vp2;
-          vp2 = Vc(nv,k+2*koffset,j+2*joffset,i+2*ioffset);
+          vp2 = Vc(n0+nv,k+2*koffset,j+2*joffset,i+2*ioffset);
 
-          SL::getPPMStates(vm2, vm1, v0, vp1, vp2, vl, vr);
+          GetPPMStates(vm2, vm1, v0, vp1, vp2, index, vl, vr);
 
           // Check positivity
           if(nv==RHO) {
@@ -304,6 +350,61 @@ class ExtrapolateToFaces {
           }
 
           vR[nv] = vl;
+      } else if constexpr(order == 5) {
+          // 1D index along the chosen direction
+          const int index = ioffset*i + joffset*j + koffset*k;
+
+          // Cells i-3 to i+2 along dir
+          real v[6];
+          for(int m = 0 ; m < 6 ; m++) {
+            v[m] = Vc(n0+nv,k+(m-3)*koffset,j+(m-3)*joffset,i+(m-3)*ioffset);
+          }
+
+          // vL= right face of cell i-1, vR= left face of cell i
+          vL[nv] = GetHighOrderState<0>(v, index-1);
+          vR[nv] = GetHighOrderState<1>(v+1, index);
+
+          if(shockFlattening) {
+            if(flags(k-koffset,j-joffset,i-ioffset) == FlagShock::Shock) {
+              // Force slope limiter to minmod
+              vL[nv] = v[2] + HALF_F*SL::MinModLim(v[3]-v[2],v[2]-v[1]);
+            }
+            if(flags(k,j,i) == FlagShock::Shock) {
+              vR[nv] = v[3] - HALF_F*SL::MinModLim(v[4]-v[3],v[3]-v[2]);
+            }
+          }
+
+          // Check positivity
+          if(nv==RHO || (Phys::pressure && nv==PRS)) {
+            // If face element is negative, revert to vanleer
+            if(vL[nv] <= 0.0) {
+              vL[nv] = v[2] + HALF_F*SL::PLMLim(v[3]-v[2],v[2]-v[1]);
+            }
+            if(vR[nv] <= 0.0) {
+              vR[nv] = v[3] - HALF_F*SL::PLMLim(v[4]-v[3],v[3]-v[2]);
+            }
+          }
+      }
+    }
+  }
+
+  // Batched version: lane w holds the states of interface i+w (along the i index whatever dir),
+  // lanes past iend duplicate the last interface (see idfx::BatchIndex). The reconstruction
+  // itself remains scalar: only the states are gathered in batches.
+  template<int W>
+  KOKKOS_FORCEINLINE_FUNCTION void ExtrapolatePrimVar(const int i,
+                                                    const int iend,
+                                                    const int j,
+                                                    const int k,
+                                                    idfx::Batch<W> vL[],
+                                                    idfx::Batch<W> vR[]) const {
+    for(int w = 0 ; w < W ; w++) {
+      real sL[Phys::nvar];
+      real sR[Phys::nvar];
+      ExtrapolatePrimVar(idfx::BatchIndex(i,w,iend), j, k, sL, sR);
+      for(int nv = 0 ; nv < Phys::nvar ; nv++) {
+        vL[nv][w] = sL[nv];
+        vR[nv][w] = sR[nv];
       }
     }
   }
@@ -318,6 +419,8 @@ class ExtrapolateToFaces {
   IdefixArray1D<real> dmArray;
   IdefixArray1D<real> wpArray;
   IdefixArray1D<real> wmArray;
+  IdefixArray2D<real> ppmWeights;
+  IdefixArray2D<real> hoWeights;
 
   bool isRegularGrid{true};
   bool shockFlattening{false};
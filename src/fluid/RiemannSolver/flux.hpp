@@ -9,6 +9,7 @@
 #define FLUID_RIEMANNSOLVER_FLUX_HPP_
 #include "idefix.hpp"
 #include "fluid.hpp"
+#include "simdBatch.hpp"
 
 
 // Local Kokkos Inlined functions
@@ -24,10 +25,11 @@
  * @param Xn    Index of the normal velocity component
  *
  *  This routine computes the MHD out of V and U variables and stores it in F
+ *  T is either real or a batch of reals (idfx::Batch)
  ********************************************************************************************/
-template<typename Phys, int DIR>
-KOKKOS_INLINE_FUNCTION void K_Flux(real *KOKKOS_RESTRICT F, const real *KOKKOS_RESTRICT V,
-                                   const real *KOKKOS_RESTRICT U, real Cs2Iso) {
+template<typename Phys, int DIR, typename T = real>
+KOKKOS_INLINE_FUNCTION void K_Flux(T *KOKKOS_RESTRICT F, const T *KOKKOS_RESTRICT V,
+                                   const T *KOKKOS_RESTRICT U, T Cs2Iso) {
   constexpr int Xn = DIR+MX1;
   [[maybe_unused]] constexpr int BXn = DIR+BX1;
 
@@ -62,12 +64,12 @@ KOKKOS_INLINE_FUNCTION void K_Flux(real *KOKKOS_RESTRICT F, const real *KOKKOS_R
 
   if constexpr(Phys::pressure || Phys::isothermal) {
     // Pressure-related term
-    real ptot;
+    T ptot;
     if constexpr(Phys::mhd) {
       ////////////////
       // MHD VERSION
       ///////////////
-      real Bmag2 = EXPAND(V[BX1]*V[BX1] , + V[BX2]*V[BX2], + V[BX3]*V[BX3]);
+      T Bmag2 = EXPAND(V[BX1]*V[BX1] , + V[BX2]*V[BX2], + V[BX3]*V[BX3]);
       if constexpr(Phys::pressure) {
         ptot  = V[PRS] + HALF_F*Bmag2;
         // Energy flux
@@ -10,6 +10,7 @@
 
 #include <string>
 #include <memory>
+#include <array>
 
 #include "fluid.hpp"
 #include "input.hpp"
@@ -19,6 +20,24 @@ template<typename Phys>
 class ShockFlattening;
 
 #include "extrapolateToFaces.hpp"
+#include "coarseInterfaces.hpp"
+
+// Riemann solver fixed at compile time with the Idefix_SOLVER cmake option.
+// When set, only this solver is instantiated in CalcFlux.
+enum class FixedSolver {runtime, tvdlf, hll, hlld, hllc, roe};
+#ifdef FIXED_SOLVER
+inline constexpr FixedSolver fixedSolver = FixedSolver::FIXED_SOLVER;
+#else
+inline constexpr FixedSolver fixedSolver = FixedSolver::runtime;
+#endif
+
+// Width of the explicit SIMD batches of the hll, hllc and hlld solvers, set at compile time
+// with the Idefix_SIMD_WIDTH cmake option (0 when batches are disabled).
+#ifdef SIMD_WIDTH
+inline constexpr int simdWidth = SIMD_WIDTH;
+#else
+inline constexpr int simdWidth = 0;
+#endif
 
 template <typename Phys>
 class RiemannSolver {
@@ -29,7 +48,7 @@ class RiemannSolver {
 
   RiemannSolver(Input &input, Fluid<Phys>* hydro);
 
-  template <int> void CalcFlux(IdefixArray4D<real> &);
+  template <int> void CalcFlux(IdefixArray4D<flux_real> &);
 
   Solver GetSolver() {
     return(mySolver);
@@ -39,25 +58,33 @@ class RiemannSolver {
 
   // Riemann Solvers
   template<const int>
-    void HlldMHD(IdefixArray4D<real> &);
+    void HlldMHD(IdefixArray4D<flux_real> &);
   template<const int>
-    void HllMHD(IdefixArray4D<real> &);
+    void HlldMaskedMHD(IdefixArray4D<flux_real> &);
   template<const int>
-    void RoeMHD(IdefixArray4D<real> &);
+    void HlldBatchMHD(IdefixArray4D<flux_real> &);
   template<const int>
-    void TvdlfMHD(IdefixArray4D<real> &);
+    void HllMHD(IdefixArray4D<flux_real> &);
+  template<const int>
+    void RoeMHD(IdefixArray4D<flux_real> &);
+  template<const int>
+    void TvdlfMHD(IdefixArray4D<flux_real> &);
 
   template<const int>
-    void HllcHD(IdefixArray4D<real> &);
+    void HllcHD(IdefixArray4D<flux_real> &);
+  template<const int>
+    void HllcHDBatch(IdefixArray4D<flux_real> &);
   template<const int>
-    void HllHD(IdefixArray4D<real> &);
+    void HllHD(IdefixArray4D<flux_real> &);
   template<const int>
-    void RoeHD(IdefixArray4D<real> &);
+    void HllHDBatch(IdefixArray4D<flux_real> &);
   template<const int>
-    void TvdlfHD(IdefixArray4D<real> &);
+    void RoeHD(IdefixArray4D<flux_real> &);
+  template<const int>
+    void TvdlfHD(IdefixArray4D<flux_real> &);
 
   template<const int>
-    void HllDust(IdefixArray4D<real> &);
+    void HllDust(IdefixArray4D<flux_real> &);
   // Get the right slope limiter
   template<int dir>
   ExtrapolateToFaces<Phys, dir>* GetExtrapolator();
@@ -70,12 +97,13 @@ class RiemannSolver {
 
   IdefixArray4D<real> Vc;
   IdefixArray4D<real> Vs;
-  IdefixArray4D<real> Flux;
+  IdefixArray4D<flux_real> Flux;
   IdefixArray3D<real> cMax;
   Fluid<Phys>* hydro;
   DataBlock *data;
 
   Solver mySolver;
+  bool haveMaskedHlld{false};     // Use the branch-free implementation of the HLLD solver
 
   // Because each direction is a different template, we can't use
   std::unique_ptr<ExtrapolateToFaces<Phys,IDIR>> slopeLimIDIR;
@@ -83,6 +111,39 @@ class RiemannSolver {
   std::unique_ptr<ExtrapolateToFaces<Phys,KDIR>> slopeLimKDIR;
 
   bool haveShockFlattening;
+
+  // Grid coarsening: Riemann fluxes only computed on the faces of the coarsened cells
+  bool haveCoarseInterfaces{false};
+  std::array<CoarseInterfaces,3> coarseInterfaces;
+
+  bool HaveCoarseInterfaces(const int dir) const {
+    return(haveCoarseInterfaces && data->coarseningDirection[dir]);
+  }
+  // Launch the kernel of a Riemann solver on the interfaces normal to dir in a box
+  template<int dir, typename Function>
+    void ForEachInterface(const std::string &, const int, const int, const int, const int,
+                                               const int, const int, Function);
+  // Interpolate the fluxes at the interfaces skipped in coarsened cells
+  template<int dir>
+    void FillCoarseInterfaces(IdefixArray4D<flux_real> &);
+
+  // Solver type corresponding to the compile-time choice for this physics
+  static constexpr Solver GetFixedSolver() {
+    switch(fixedSolver) {
+      case FixedSolver::tvdlf:
+        return(Phys::mhd ? TVDLF_MHD : TVDLF);
+      case FixedSolver::hll:
+        return(Phys::mhd ? HLL_MHD : HLL);
+      case FixedSolver::hlld:
+        return(HLLD_MHD);
+      case FixedSolver::hllc:
+        return(HLLC);
+      case FixedSolver::roe:
+        return(Phys::mhd ? ROE_MHD : ROE);
+      default:
+        return(HLL_DUST);
+    }
+  }
 };
 
 #include "shockFlattening.hpp"
@@ -137,12 +198,26 @@ RiemannSolver<Phys>::RiemannSolver(Input &input, Fluid<Phys>* hydro) : Vc{hydro-
       }
       IDEFIX_ERROR(msg);
     }
-    // Check if Hall is enabled
-    if(input.CheckEntry(std::string(Phys::prefix),"hall")>=0) {
+    if(mySolver == HLLD_MHD) {
+      haveMaskedHlld = input.GetOrSet<bool>(std::string(Phys::prefix),"hlld_masked",0,false);
+    }
+    // Check if Hall is enabled (a sub-cycled Hall effect does not go through the solver)
+    if(input.CheckEntry(std::string(Phys::prefix),"hall")>=0
+       && input.Get<std::string>(std::string(Phys::prefix),"hall",0).compare("subcycle") != 0) {
         // Check consistency
         if(mySolver != HLL_MHD )
           IDEFIX_ERROR("Hall effect is only compatible with HLL Riemann solver.");
     }
+    if constexpr(fixedSolver != FixedSolver::runtime) {
+      if(mySolver != GetFixedSolver()) {
+        std::stringstream msg;
+        msg << "The Riemann solver requested in the input file (" << solverString
+            << ") differs from the one set at compile time with Idefix_SOLVER." << std::endl
+            << "Reconfigure with -DIdefix_SOLVER=" << solverString
+            << " or -DIdefix_SOLVER=Runtime.";
+        IDEFIX_ERROR(msg);
+      }
+    }
   } else {
     // We're dealing with dust grains
     mySolver = HLL_DUST;
@@ -158,6 +233,11 @@ RiemannSolver<Phys>::RiemannSolver(Input &input, Fluid<Phys>* hydro) : Vc{hydro-
                               hydro,input.Get<real>(std::string(Phys::prefix),"shockFlattening",0));
   }
 
+  // Grid coarsening
+  if(data->haveGridCoarsening && data->coarseFluxes) {
+    haveCoarseInterfaces = true;
+  }
+
   // init slope limiters
   slopeLimIDIR = std::make_unique<ExtrapolateToFaces<Phys,IDIR>>(this);
   #if DIMENSIONS >= 2
@@ -185,7 +265,9 @@ void RiemannSolver<Phys>::ShowConfig() {
       idfx::cout << "hll (MHD)." << std::endl;
       break;
     case HLLD_MHD:
-        idfx::cout << "hlld (MHD)." << std::endl;
+        idfx::cout << "hlld (MHD)";
+        if(haveMaskedHlld) idfx::cout << ", branch-free (masked) kernel";
+        idfx::cout << "." << std::endl;
         break;
     case HLLC:
       idfx::cout << "hllc (HD)." << std::endl;
@@ -202,6 +284,9 @@ void RiemannSolver<Phys>::ShowConfig() {
     default:
       IDEFIX_ERROR("Unknown Riemann solver");
   }
+  if(!Phys::dust && fixedSolver != FixedSolver::runtime) {
+    idfx::cout << Phys::prefix << ": Riemann solver fixed at compile time." << std::endl;
+  }
 
   if(haveShockFlattening) {
     idfx::cout << Phys::prefix << ": Shock Flattening ENABLED." << std::endl;
@@ -220,6 +305,30 @@ ExtrapolateToFaces<Phys, dir>* RiemannSolver<Phys>::GetExtrapolator() {
   }
 }
 
+// Launch function(k,j,i) on the interfaces normal to dir of the box [kb,ke[x[jb,je[x[ib,ie[.
+// When the fluxes are only required on the faces of the coarsened cells, the kernel is launched
+// on the compacted list of these faces instead.
+template <typename Phys>
+template<int dir, typename Function>
+void RiemannSolver<Phys>::ForEachInterface(const std::string &name,
+                                           const int kb, const int ke,
+                                           const int jb, const int je,
+                                           const int ib, const int ie,
+                                           Function function) {
+  if(HaveCoarseInterfaces(dir)) {
+    CoarseInterfaces &list = coarseInterfaces[dir];
+    list.Update(data, dir, {ib, jb, kb}, {ie, je, ke});
+    IdefixArray1D<int> iList = list.index[IDIR];
+    IdefixArray1D<int> jList = list.index[JDIR];
+    IdefixArray1D<int> kList = list.index[KDIR];
+    idefix_for(name+"_Coarse", 0, list.size,
+      KOKKOS_LAMBDA (int n) {
+        function(kList(n), jList(n), iList(n));
+      });
+  } else {
+    idefix_for(name, kb, ke, jb, je, ib, ie, function);
+  }
+}
 
 #include "calcFlux.hpp"
 
@@ -142,12 +142,20 @@ class SlopeLimiter {
   KOKKOS_FORCEINLINE_FUNCTION static void getPPMStates(const real vm2, const real vm1,
                                                       const real v0, const real vp1, const real vp2,
                                                       real &vl, real &vr) {
-    const int n = 2;
-
     // 1: unlimited left and right interpolant (PH13 3.26-3.27)
     vr = 7.0/12.0*(v0+vp1) - 1.0/12.0*(vm1+vp2);
     vl = 7.0/12.0*(vm1+v0) - 1.0/12.0*(vm2+vp1);
 
+    limitPPMStates(vm2, vm1, v0, vp1, vp2, vl, vr);
+  }
+
+  // Limit the unlimited interpolants vl and vr of the faces of cell 0 (computed either by
+  // getPPMStates on uniform grids or with the weights of ReconstructionWeights otherwise)
+  KOKKOS_FORCEINLINE_FUNCTION static void limitPPMStates(const real vm2, const real vm1,
+                                                      const real v0, const real vp1, const real vp2,
+                                                      real &vl, real &vr) {
+    const int n = 2;
+
     // 2: limit interpolated face values (CD11 4.3.1)
     limitPPMFaceValues(vm2,vm1,v0,vp1,vl);
     limitPPMFaceValues(vm1,v0,vp1,vp2,vr);
@@ -189,6 +197,79 @@ class SlopeLimiter {
       }
     }
   }
+
+  // WENO5-Z reconstruction (Borges, R., Carmona, M., Costa, B. & Don, W. S. An improved
+  // weighted essentially non-oscillatory scheme for hyperbolic conservation laws. Journal of
+  // Computational Physics 227, 3191–3211 (2008)) of one face value of cell 0.
+  // q0, q1 and q2 are the third order interpolations of the face value on the stencils
+  // (-2,-1,0), (-1,0,1) and (0,1,2), and d0, d1, d2 their linear weights.
+  KOKKOS_FORCEINLINE_FUNCTION static real getWENOZState(const real vm2, const real vm1,
+                                                      const real v0, const real vp1, const real vp2,
+                                                      const real q0, const real q1, const real q2,
+                                                      const real d0, const real d1, const real d2) {
+    // Smoothness indicators of Jiang & Shu (1996)
+    const real b0 = 13.0/12.0*(vm2-2*vm1+v0)*(vm2-2*vm1+v0)
+                    + 0.25*(vm2-4*vm1+3*v0)*(vm2-4*vm1+3*v0);
+    const real b1 = 13.0/12.0*(vm1-2*v0+vp1)*(vm1-2*v0+vp1)
+                    + 0.25*(vm1-vp1)*(vm1-vp1);
+    const real b2 = 13.0/12.0*(v0-2*vp1+vp2)*(v0-2*vp1+vp2)
+                    + 0.25*(3*v0-4*vp1+vp2)*(3*v0-4*vp1+vp2);
+
+    // Global smoothness indicator of WENO-Z, and small number avoiding divisions by zero in
+    // uniform regions (kept within the range of single precision)
+    const real tau5 = FABS(b0-b2);
+    const real eps = 1e-30;
+
+    const real a0 = d0*(1.0 + tau5/(b0+eps));
+    const real a1 = d1*(1.0 + tau5/(b1+eps));
+    const real a2 = d2*(1.0 + tau5/(b2+eps));
+
+    return((a0*q0 + a1*q1 + a2*q2)/(a0 + a1 + a2));
+  }
+
+  // minmod functions of 2 and 4 arguments used by the MP5 limiter
+  KOKKOS_FORCEINLINE_FUNCTION static real MP5MinMod(const real a, const real b) {
+    return(HALF_F*(sign(a)+sign(b))*FMIN(FABS(a),FABS(b)));
+  }
+
+  KOKKOS_FORCEINLINE_FUNCTION static real MP5MinMod4(const real a, const real b,
+                                                     const real c, const real d) {
+    return(0.125*(sign(a)+sign(b))*FABS((sign(a)+sign(c))*(sign(a)+sign(d)))
+           *FMIN(FMIN(FABS(a),FABS(b)),FMIN(FABS(c),FABS(d))));
+  }
+
+  // MP5 limiter (Suresh, A. & Huynh, H. T. Accurate monotonicity-preserving schemes with
+  // Runge–Kutta time stepping. Journal of Computational Physics 136, 83–99 (1997)) of the
+  // fifth order interpolation vor of the face value of cell 0 which is located between cells
+  // 0 and p1 (the left face is obtained by mirroring the stencil).
+  KOKKOS_FORCEINLINE_FUNCTION static real getMP5State(const real vm2, const real vm1,
+                                                      const real v0, const real vp1, const real vp2,
+                                                      const real vor) {
+    const real alpha = 4.0;
+
+    // Monotonicity-preserving bound: no limiting is needed when vor lies within it
+    const real vmp = v0 + MP5MinMod(vp1-v0, alpha*(v0-vm1));
+    if((vor-v0)*(vor-vmp) <= 0.0) return(vor);
+
+    // Curvatures
+    const real dm1 = vm2 - 2*vm1 + v0;
+    const real d0 = vm1 - 2*v0 + vp1;
+    const real dp1 = v0 - 2*vp1 + vp2;
+
+    const real dph = MP5MinMod4(4*d0-dp1, 4*dp1-d0, d0, dp1);
+    const real dmh = MP5MinMod4(4*d0-dm1, 4*dm1-d0, d0, dm1);
+
+    const real vul = v0 + alpha*(v0-vm1);
+    const real vav = HALF_F*(v0+vp1);
+    const real vmd = vav - HALF_F*dph;
+    const real vlc = v0 + HALF_F*(v0-vm1) + 4.0/3.0*dmh;
+
+    const real vmin = FMAX(FMIN(FMIN(v0,vp1),vmd), FMIN(FMIN(v0,vul),vlc));
+    const real vmax = FMIN(FMAX(FMAX(v0,vp1),vmd), FMAX(FMAX(v0,vul),vlc));
+
+    // Median of (vor, vmin, vmax)
+    return(vor + MP5MinMod(vmin-vor, vmax-vor));
+  }
 };
 
 #endif // FLUID_RIEMANNSOLVER_SLOPELIMITER_HPP_
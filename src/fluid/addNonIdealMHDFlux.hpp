@@ -20,7 +20,7 @@ void Fluid<Phys>::AddNonIdealMHDFlux(const real t) {
   if constexpr(Phys::mhd) {
     int ioffset,joffset,koffset;
 
-    IdefixArray4D<real> Flux = this->FluxRiemann;
+    IdefixArray4D<flux_real> Flux = this->FluxRiemann;
     IdefixArray4D<real> Vc   = this->Vc;
     IdefixArray4D<real> Vs   = this->Vs;
     IdefixArray3D<real> dMax = this->dMax;
@@ -62,20 +62,7 @@ void Fluid<Phys>::AddNonIdealMHDFlux(const real t) {
         IDEFIX_ERROR("Wrong direction");
     }
 
-    // Load the diffusivity array when required
-    if(resistivity == UserDefFunction && dir == IDIR) {
-      if(ohmicDiffusivityFunc)
-        ohmicDiffusivityFunc(*data, t, etaArr);
-      else
-        IDEFIX_ERROR("No user-defined Ohmic diffusivity function has been enrolled");
-    }
-
-    if(ambipolar == UserDefFunction && dir == IDIR) {
-      if(ambipolarDiffusivityFunc)
-        ambipolarDiffusivityFunc(*data, t, xAmbiArr);
-      else
-        IDEFIX_ERROR("No user-defined ambipolar diffusivity function has been enrolled");
-    }
+    // The user-defined diffusivity arrays are filled by UpdateDiffusivities
 
     // Note the flux follows the same sign convention as the hyperbolic flux
     // HEnce signs are reversed compared to the parabolic fluxes found in Pluto 4.3
@@ -41,6 +41,7 @@ class Boundary {
  public:
   explicit Boundary(Fluid<Phys>*);
   void SetBoundaries(real);                         ///< Set the ghost zones in all directions
+  void EnforceInternalBoundary(real);             ///< Call the user-defined internal boundary
   void EnforceBoundaryDir(real, int);             ///< write in the ghost zone in specific direction
   void ReconstructVcField(IdefixArray4D<real> &);  ///< reconstruct cell-centered magnetic field
   void ReconstructNormalField(int dir);           ///< reconstruct normal field using divB=0
@@ -61,6 +62,7 @@ class Boundary {
 
   #ifdef WITH_MPI
   Mpi mpi;                     ///< Mpi object when WITH_MPI is set
+  ExchangeFieldSet mpiFieldSet;  ///< Variables exchanged by mpi (used for coalesced exchanges)
   #endif
 
     // User defined Boundary conditions
@@ -244,8 +246,13 @@ Boundary<Phys>::Boundary(Fluid<Phys>* fluid) {
     }
   }
 
-  mpi.Init(data->mygrid, mapVars, data->nghost, data->np_int,
-           data->lbound, data->rbound, Phys::mhd);
+  // With shared storage, all of the dust species are exchanged by the DataBlock exchanger
+  if(!(Phys::dust && data->haveDustSharedStorage)) {
+    mpi.Init(data->mygrid, mapVars, data->nghost, data->np_int,
+             data->lbound, data->rbound, Phys::mhd);
+  }
+  mpiFieldSet.mapVars = mapVars;
+  mpiFieldSet.haveVs = Phys::mhd;
 
 #endif // MPI
   idfx::popRegion();
@@ -300,19 +307,25 @@ template<typename Phys>
 void Boundary<Phys>::SetBoundaries(real t) {
   idfx::pushRegion("Boundary::SetBoundaries");
   // set internal boundary conditions
-  if(haveInternalBoundary) {
-    idfx::pushRegion("Boundary::UserDefInternalBoundary");
-    if(internalBoundaryFunc != NULL) {
-      internalBoundaryFunc(fluid, t);
-    } else {
-      internalBoundaryFuncOld(*data, t);
-    }
-    idfx::popRegion();
-  }
+  EnforceInternalBoundary(t);
   for(int dir=0 ; dir < DIMENSIONS ; dir++ ) {
       // MPI Exchange data when needed
     #ifdef WITH_MPI
-    if(data->mygrid->nproc[dir]>1) {
+    if(data->mygrid->nproc[dir]>1 && Phys::dust && data->haveDustSharedStorage) {
+      // This specie is a slice of the shared dust arrays: the other species are exchanged
+      // along with it, which leaves their (already consistent) ghost zones unchanged
+      switch(dir) {
+        case 0:
+          data->dustMpi->ExchangeX1(data->dustVc);
+          break;
+        case 1:
+          data->dustMpi->ExchangeX2(data->dustVc);
+          break;
+        case 2:
+          data->dustMpi->ExchangeX3(data->dustVc);
+          break;
+      }
+    } else if(data->mygrid->nproc[dir]>1) {
       switch(dir) {
         case 0:
           mpi.ExchangeX1(this->Vc, this->Vs);
@@ -341,6 +354,18 @@ void Boundary<Phys>::SetBoundaries(real t) {
   idfx::popRegion();
 }
 
+template<typename Phys>
+void Boundary<Phys>::EnforceInternalBoundary(real t) {
+  if(haveInternalBoundary) {
+    idfx::pushRegion("Boundary::UserDefInternalBoundary");
+    if(internalBoundaryFunc != NULL) {
+      internalBoundaryFunc(fluid, t);
+    } else {
+      internalBoundaryFuncOld(*data, t);
+    }
+    idfx::popRegion();
+  }
+}
 
 // Enforce boundary conditions by writing into ghost zones
 template<typename Phys>
@@ -26,7 +26,7 @@ void BragThermalDiffusion::ShowConfig() {
   } else if (status.status==UserDefFunction) {
     idfx::cout << "Braginskii Thermal Diffusion: ENABLED with user-defined diffusivity function."
                    << std::endl;
-    if(!bragDiffusivityFunc) {
+    if(!bragDiffusivityFunc && !status.isShared) {
       IDEFIX_ERROR("No braginskii thermal diffusion function has been enrolled");
     }
   } else {
@@ -64,8 +64,31 @@ void BragThermalDiffusion::EnrollBragThermalDiffusivity(BragDiffusivityFunc myFu
   this->bragDiffusivityFunc = myFunc;
 }
 
+void BragThermalDiffusion::UpdateDiffusivity(const real t) {
+  if(!includeCollisionlessTD) {
+    if(bragDiffusivityFunc) {
+      idfx::pushRegion("UserDef::BragThermalDiffusivityFunction");
+      std::vector<IdefixArray3D<real>> userdefArr = {kparArr, knorArr};
+      bragDiffusivityFunc(*this->data, t, userdefArr);
+      idfx::popRegion();
+    } else {
+      IDEFIX_ERROR("No user-defined Braginskii thermal diffusion function has been enrolled");
+    }
+  } else {
+    if (bragDiffusivityFunc) {
+      idfx::pushRegion("UserDef::ClessThermalDiffusivityFunction");
+      std::vector<IdefixArray3D<real>> userdefArr = {kparArr, knorArr, clessAlphaArr, clessBetaArr};
+      bragDiffusivityFunc(*this->data, t, userdefArr);
+      idfx::popRegion();
+    } else {
+      IDEFIX_ERROR("No user-defined Braginskii/collisionless "
+                    "thermal diffusion function has been enrolled");
+    }
+  }
+}
+
 void BragThermalDiffusion::AddBragDiffusiveFlux(int dir, const real t,
-                                                const IdefixArray4D<real> &Flux) {
+                                                const IdefixArray4D<flux_real> &Flux) {
   idfx::pushRegion("BragThermalDiffusion::AddBragDiffusiveFlux");
   switch(limiter) {
     case PLMLimiter::VanLeer:
@@ -30,13 +30,14 @@ class BragThermalDiffusion {
 
   void ShowConfig(); // display configuration
 
-  void AddBragDiffusiveFlux(int, const real, const IdefixArray4D<real> &);
+  void AddBragDiffusiveFlux(int, const real, const IdefixArray4D<flux_real> &);
 
   template<const PLMLimiter>
-  void AddBragDiffusiveFluxLim(int, const real, const IdefixArray4D<real> &);
+  void AddBragDiffusiveFluxLim(int, const real, const IdefixArray4D<flux_real> &);
 
   // Enroll user-defined thermal conductivity
   void EnrollBragThermalDiffusivity(BragDiffusivityFunc);
+  void UpdateDiffusivity(const real);   // fill the user-defined diffusivities
 
   IdefixArray3D<real> heatSrc;  // Source terms of the thermal operator
   IdefixArray3D<real> knorArr;
@@ -245,7 +246,7 @@ BragThermalDiffusion::BragThermalDiffusion(Input &input, Grid &grid, Fluid<Phys>
 // (this avoids an extra array)
 template <PLMLimiter limTemplate>
 void BragThermalDiffusion::AddBragDiffusiveFluxLim(int dir, const real t,
-                                                const IdefixArray4D<real> &Flux) {
+                                                const IdefixArray4D<flux_real> &Flux) {
   idfx::pushRegion("BragThermalDiffusion::AddBragDiffusiveFluxLim");
 
   IdefixArray4D<real> Vc = this->Vc;
@@ -303,28 +304,7 @@ void BragThermalDiffusion::AddBragDiffusiveFluxLim(int dir, const real t,
   IdefixArray3D<real> clessAlphaArr   = this->clessAlphaArr;
   IdefixArray3D<real> clessBetaArr  = this->clessBetaArr;
 
-  if(includeCollisionlessTD == false && haveThermalDiffusion == UserDefFunction && dir == IDIR) {
-    if(bragDiffusivityFunc) {
-      idfx::pushRegion("UserDef::BragThermalDiffusivityFunction");
-      std::vector<IdefixArray3D<real>> userdefArr = {kparArr, knorArr};
-      bragDiffusivityFunc(*this->data, t, userdefArr);
-      idfx::popRegion();
-    }
-    else {
-      IDEFIX_ERROR("No user-defined Braginskii thermal diffusion function has been enrolled");
-    }
-  } else if(includeCollisionlessTD == true && haveThermalDiffusion == UserDefFunction
-            && dir == IDIR) {
-    if (bragDiffusivityFunc) {
-      idfx::pushRegion("UserDef::ClessThermalDiffusivityFunction");
-      std::vector<IdefixArray3D<real>> userdefArr = {kparArr, knorArr, clessAlphaArr, clessBetaArr};
-      bragDiffusivityFunc(*this->data, t, userdefArr);
-      idfx::popRegion();
-    } else {
-      IDEFIX_ERROR("No user-defined Braginskii/collisionless "
-                    "thermal diffusion function has been enrolled");
-    }
-  }
+  // User-defined diffusivities are filled by Fluid::UpdateDiffusivities
 
   idefix_for("BragDiffusiveFlux",kbeg, kend, jbeg, jend, ibeg, iend,
     KOKKOS_LAMBDA (int k, int j, int i) {
@@ -33,9 +33,10 @@ void BragViscosity::InitArrays() {
         dmu(j) = 1.0/scrch;
       });
   #endif
-  bragViscSrc = IdefixArray4D<real>("BragViscosity_source", COMPONENTS, data->np_tot[KDIR],
-                                                                data->np_tot[JDIR],
-                                                                data->np_tot[IDIR]);
+  // The geometrical source terms are computed and used within the same stage (or RKL cycle)
+  data->scratch.Request(bragViscSrc, "BragViscosity_source",
+                        ScratchArena::stagePhase | ScratchArena::rklPhase,
+                        COMPONENTS, data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
 }
 void BragViscosity::ShowConfig() {
   if(status.status==Constant) {
@@ -44,7 +45,7 @@ void BragViscosity::ShowConfig() {
   } else if (status.status==UserDefFunction) {
     idfx::cout << "Braginskii Viscosity: ENABLED with user-defined braginskii viscosity function."
                    << std::endl;
-    if(!bragViscousDiffusivityFunc) {
+    if(!bragViscousDiffusivityFunc && !status.isShared) {
       IDEFIX_ERROR("No braginskii viscosity function has been enrolled");
     }
   } else {
@@ -83,11 +84,22 @@ void BragViscosity::EnrollBragViscousDiffusivity(DiffusivityFunc myFunc) {
   this->bragViscousDiffusivityFunc = myFunc;
 }
 
+void BragViscosity::UpdateDiffusivity(const real t) {
+  if(bragViscousDiffusivityFunc) {
+    idfx::pushRegion("UserDef::BragViscousDiffusivityFunction");
+    bragViscousDiffusivityFunc(*this->data, t, etaBragArr);
+    idfx::popRegion();
+  } else {
+    IDEFIX_ERROR("No user-defined Braginskii viscosity function has been enrolled");
+  }
+}
+
 // This function computes the viscous flux and stores it in hydro->fluxRiemann
 // (this avoids an extra array)
 // Associated source terms, present in non-cartesian geometry are also computed
 // and stored in this->viscSrc for later use (in calcRhs).
-void BragViscosity::AddBragViscousFlux(int dir, const real t, const IdefixArray4D<real> &Flux) {
+void BragViscosity::AddBragViscousFlux(int dir, const real t,
+                                       const IdefixArray4D<flux_real> &Flux) {
   idfx::pushRegion("BragViscosity::AddBragViscousFlux");
   switch(limiter) {
     case PLMLimiter::VanLeer:
@@ -25,13 +25,14 @@ class BragViscosity {
   template <typename Phys>
   BragViscosity(Input &, Grid &, Fluid<Phys> *);
   void ShowConfig();                    // print configuration
-  void AddBragViscousFlux(int, const real, const IdefixArray4D<real> &);
+  void AddBragViscousFlux(int, const real, const IdefixArray4D<flux_real> &);
 
   template <const PLMLimiter>
-  void AddBragViscousFluxLim(int, const real, const IdefixArray4D<real> &);
+  void AddBragViscousFluxLim(int, const real, const IdefixArray4D<flux_real> &);
 
   // Enroll user-defined viscous diffusivity
   void EnrollBragViscousDiffusivity(DiffusivityFunc);
+  void UpdateDiffusivity(const real);   // fill the user-defined viscosity
 
   // Function for internal use (but public to allow for Cuda lambda capture)
   void InitArrays();
@@ -169,7 +170,8 @@ BragViscosity::BragViscosity(Input &input, Grid &grid, Fluid<Phys> *hydroin):
 // Associated source terms, present in non-cartesian geometry are also computed
 // and stored in this->bragViscSrc for later use (in calcRhs).
 template <PLMLimiter limTemplate>
-void BragViscosity::AddBragViscousFluxLim(int dir, const real t, const IdefixArray4D<real> &Flux) {
+void BragViscosity::AddBragViscousFluxLim(int dir, const real t,
+                                          const IdefixArray4D<flux_real> &Flux) {
   idfx::pushRegion("BragViscosity::AddBragViscousFlux");
   IdefixArray4D<real> Vc = this->Vc;
   IdefixArray4D<real> Vs = this->Vs;
@@ -200,14 +202,7 @@ void BragViscosity::AddBragViscousFluxLim(int dir, const real t, const IdefixArr
   using SL = SlopeLimiter<limTemplate>;
 
   // Braginskii Viscosity
-  // Compute viscosity if needed
-  if(haveViscosity == UserDefFunction && dir == IDIR) {
-    if(bragViscousDiffusivityFunc) {
-      bragViscousDiffusivityFunc(*this->data, t, etaBragArr);
-    } else {
-      IDEFIX_ERROR("No user-defined Braginskii viscosity function has been enrolled");
-    }
-  }
+  // User-defined viscosities are filled by Fluid::UpdateDiffusivities
 
   int ibeg, iend, jbeg, jend, kbeg, kend;
   ibeg = this->data->beg[IDIR];
@@ -8,11 +8,15 @@
 #ifndef FLUID_CALCRIGHTHANDSIDE_HPP_
 #define FLUID_CALCRIGHTHANDSIDE_HPP_
 
+#include <string>
+
 #include "fluid.hpp"
 #include "dataBlock.hpp"
 #include "gravity.hpp"
 
-template<typename Phys, int dir>
+// haveMeanAdvection is set when a mean azimuthal advection (Fargo or rotating frame) is
+// added to the fluxes, so that the corresponding branches are removed at compile time otherwise.
+template<typename Phys, int dir, bool haveMeanAdvection>
 struct Fluid_CorrectFluxFunctor {
   // Correct the flux to take into account non-cartesian geometries and Fargo
   //*****************************************************************
@@ -47,6 +51,12 @@ struct Fluid_CorrectFluxFunctor {
 
     // Shearing box shear rate
     sbS = hydro->sbS;
+
+    // Dust species of the shared storage whose fluxes are corrected together
+    if(hydro->nFusedSpecies > 1) {
+      Flux = hydro->data->dustFlux;
+      nvSpecies = hydro->data->dustNvar;
+    }
   }
 
   //*****************************************************************
@@ -54,7 +64,7 @@ struct Fluid_CorrectFluxFunctor {
   //*****************************************************************
   IdefixArray4D<real> Uc;
   IdefixArray4D<real> Vc;
-  IdefixArray4D<real> Flux;
+  IdefixArray4D<flux_real> Flux;
   IdefixArray3D<real> A;
   IdefixArray3D<real> dV;
   IdefixArray1D<real> x1m;
@@ -78,12 +88,27 @@ struct Fluid_CorrectFluxFunctor {
   // timestep
   real dt;
 
+  // number of variables of each dust specie (fused species)
+  int nvSpecies{0};
+
   //*****************************************************************
   // Functor Operator
   //*****************************************************************
   KOKKOS_INLINE_FUNCTION void operator() (const int k, const int j,  const int i) const {
+    CorrectFlux(0, k, j, i);
+  }
+
+  // Dust specie s of the shared storage
+  KOKKOS_INLINE_FUNCTION void operator() (const int s, const int k, const int j,
+                                          const int i) const {
+    CorrectFlux(s*nvSpecies, k, j, i);
+  }
+
+  // Correct the flux of the fluid whose variables start at n0
+  KOKKOS_FORCEINLINE_FUNCTION void CorrectFlux(const int n0, const int k, const int j,
+                                               const int i) const {
       // Add Fargo velocity to the fluxes
-      if(haveFargo || haveRotation) {
+      if constexpr(haveMeanAdvection) {
         // Set mean advection direction
         #if (GEOMETRY == CARTESIAN || GEOMETRY == POLAR) && DIMENSIONS >=2
           const int meanDir = JDIR;
@@ -143,10 +168,11 @@ struct Fluid_CorrectFluxFunctor {
         // since in that case meanV=0
         if constexpr(Phys::pressure) {
           // Mignone (2012): second and third term of rhs of (25)
-          Flux(ENG,k,j,i) += meanV * (HALF_F*meanV*Flux(RHO,k,j,i) + Flux(MX1+meanDir,k,j,i));
+          Flux(n0+ENG,k,j,i) += meanV * (HALF_F*meanV*Flux(n0+RHO,k,j,i)
+                                         + Flux(n0+MX1+meanDir,k,j,i));
         }
         // Mignone+2012: second term of rhs of (24)
-        Flux(MX1+meanDir,k,j,i) += meanV * Flux(RHO,k,j,i);
+        Flux(n0+MX1+meanDir,k,j,i) += meanV * Flux(n0+RHO,k,j,i);
       } // Fargo & Rotation corrections
 
       //////////////////////////////////////////////
@@ -190,14 +216,14 @@ struct Fluid_CorrectFluxFunctor {
 
       // Finally correct the flux
       for(int nv = 0 ; nv < Phys::nvar ; nv++) {
-        Flux(nv,k,j,i) = Flux(nv,k,j,i) * Ax[nv];
+        Flux(n0+nv,k,j,i) = Flux(n0+nv,k,j,i) * Ax[nv];
       }
     }
 };
 
 
 
-template<typename Phys, int dir>
+template<typename Phys, int dir, bool haveMeanAdvection>
 struct Fluid_CalcRHSFunctor {
   //*****************************************************************
   // Functor constructor
@@ -266,13 +292,23 @@ struct Fluid_CalcRHSFunctor {
 
     // Shearing box shear rate
     sbS = hydro->sbS;
+
+    // Dust species of the shared storage evolved together
+    if(hydro->nFusedSpecies > 1) {
+      Uc = hydro->data->dustUc;
+      Vc = hydro->data->dustVc;
+      Flux = hydro->data->dustFlux;
+      speciesInvDt = hydro->data->dustInvDt;
+      speciesCMax = hydro->data->dustCMax;
+      nvSpecies = hydro->data->dustNvar;
+    }
   }
   //*****************************************************************
   // Functor Variables
   //*****************************************************************
   IdefixArray4D<real> Uc;
   IdefixArray4D<real> Vc;
-  IdefixArray4D<real> Flux;
+  IdefixArray4D<flux_real> Flux;
   IdefixArray3D<real> A;
   IdefixArray3D<real> dV;
   IdefixArray1D<real> x1m;
@@ -327,10 +363,39 @@ struct Fluid_CalcRHSFunctor {
   // timestep
   real dt;
 
+  // Dust species of the shared storage (fused species)
+  IdefixArray4D<real> speciesInvDt;
+  IdefixArray4D<real> speciesCMax;
+  int nvSpecies{0};
+
   //*****************************************************************
   // Functor Operator
   //*****************************************************************
   KOKKOS_INLINE_FUNCTION void operator() (const int k, const int j,  const int i) const {
+    constexpr int ioffset = (dir==IDIR) ? 1 : 0;
+    constexpr int joffset = (dir==JDIR) ? 1 : 0;
+    constexpr int koffset = (dir==KDIR) ? 1 : 0;
+    real idt = invDt(k,j,i);
+    Evolve(0, k, j, i, cMax(k,j,i), cMax(k+koffset,j+joffset,i+ioffset), idt);
+    invDt(k,j,i) = idt;
+  }
+
+  // Dust specie s of the shared storage
+  KOKKOS_INLINE_FUNCTION void operator() (const int s, const int k, const int j,
+                                          const int i) const {
+    constexpr int ioffset = (dir==IDIR) ? 1 : 0;
+    constexpr int joffset = (dir==JDIR) ? 1 : 0;
+    constexpr int koffset = (dir==KDIR) ? 1 : 0;
+    real idt = speciesInvDt(s,k,j,i);
+    Evolve(s*nvSpecies, k, j, i, speciesCMax(s,k,j,i),
+           speciesCMax(s,k+koffset,j+joffset,i+ioffset), idt);
+    speciesInvDt(s,k,j,i) = idt;
+  }
+
+  // Evolve the fluid whose variables start at n0, given the signal speeds on the left (cMaxL)
+  // and right (cMaxR) faces of the cell and its inverse timestep idt
+  KOKKOS_FORCEINLINE_FUNCTION void Evolve(const int n0, const int k, const int j, const int i,
+                                          const real cMaxL, const real cMaxR, real &idt) const {
     const int ioffset = (dir==IDIR) ? 1 : 0;
     const int joffset = (dir==JDIR) ? 1 : 0;
     const int koffset = (dir==KDIR) ? 1 : 0;
@@ -340,7 +405,8 @@ struct Fluid_CalcRHSFunctor {
 
     #pragma unroll
     for(int nv = 0 ; nv < Phys::nvar ; nv++) {
-      rhs[nv] = -  dtdV*(Flux(nv, k+koffset, j+joffset, i+ioffset) - Flux(nv, k, j, i));
+      rhs[nv] = -  dtdV*(static_cast<real>(Flux(n0+nv, k+koffset, j+joffset, i+ioffset))
+                         - Flux(n0+nv, k, j, i));
     }
 
     #if GEOMETRY != CARTESIAN
@@ -350,20 +416,24 @@ struct Fluid_CalcRHSFunctor {
         #endif
         if constexpr(Phys::mhd) {
           #if (GEOMETRY == POLAR || GEOMETRY == CYLINDRICAL) &&  (defined iBPHI)
-            rhs[iBPHI] = - dt / dx(i) * (Flux(iBPHI, k, j, i+1) - Flux(iBPHI, k, j, i) );
+            rhs[iBPHI] = - dt / dx(i) * (static_cast<real>(Flux(n0+iBPHI, k, j, i+1))
+                                         - Flux(n0+iBPHI, k, j, i) );
 
           #elif (GEOMETRY == SPHERICAL)
             real q = dt / (x1(i)*dx(i));
             EXPAND(                                                                       ,
-                  rhs[iBTH]  = -q * ((Flux(iBTH, k, j, i+1)  - Flux(iBTH, k, j, i) ));  ,
-                  rhs[iBPHI] = -q * ((Flux(iBPHI, k, j, i+1) - Flux(iBPHI, k, j, i) )); )
+                  rhs[iBTH]  = -q * ((static_cast<real>(Flux(n0+iBTH, k, j, i+1))
+                                       - Flux(n0+iBTH, k, j, i) ));                   ,
+                  rhs[iBPHI] = -q * ((static_cast<real>(Flux(n0+iBPHI, k, j, i+1))
+                                       - Flux(n0+iBPHI, k, j, i) ));                  )
           #endif
         } // MHD
       } else if constexpr(dir==JDIR) {
         #if (GEOMETRY == SPHERICAL) && (COMPONENTS == 3)
           rhs[iMPHI] /= FABS(sinx2(j));
           if constexpr(Phys::mhd) {
-            rhs[iBPHI] = -dt / (x1(i)*dx(j)) * (Flux(iBPHI, k, j+1, i) - Flux(iBPHI, k, j, i));
+            rhs[iBPHI] = -dt / (x1(i)*dx(j)) * (static_cast<real>(Flux(n0+iBPHI, k, j+1, i))
+                                                - Flux(n0+iBPHI, k, j, i));
           } // MHD
         #endif // GEOMETRY
       }
@@ -373,7 +443,7 @@ struct Fluid_CalcRHSFunctor {
 
     // Fargo terms to enfore conservation (actually substract back what was added in
     // Totalflux loop)
-    if(haveFargo || haveRotation) {
+    if constexpr(haveMeanAdvection) {
       // fetch fargo velocity when required
       real meanV = ZERO_F;
       #if (GEOMETRY == POLAR || GEOMETRY == CARTESIAN) && DIMENSIONS >=2
@@ -459,14 +529,14 @@ struct Fluid_CalcRHSFunctor {
                       - phiP(k+2,j,i) + 8.0 * phiP(k+1,j,i)
                       - 8.0*phiP(k-1,j,i) + phiP(k-2,j,i));
       }
-      rhs[MX1+dir] += dt * Vc(RHO,k,j,i) * dphi /dl;
+      rhs[MX1+dir] += dt * Vc(n0+RHO,k,j,i) * dphi /dl;
 
       if constexpr(Phys::pressure) {
         // Add gravitational force work as a source term
         // This is equivalent to rho * v . nabla(phi)
         // (note that Flux has already been multiplied by A)
         rhs[ENG] += HALF_F * dtdV  *
-                  (Flux(RHO,k,j,i) + Flux(RHO, k+koffset, j+joffset, i+ioffset)) * dphi;
+                  (Flux(n0+RHO,k,j,i) + Flux(n0+RHO, k+koffset, j+joffset, i+ioffset)) * dphi;
       }
     }
 
@@ -479,30 +549,30 @@ struct Fluid_CalcRHSFunctor {
           bf -= -2*Omega*sbS * x1(i);
         }
       #endif
-      rhs[MX1+dir] += dt * Vc(RHO,k,j,i) * bf;
+      rhs[MX1+dir] += dt * Vc(n0+RHO,k,j,i) * bf;
       if constexpr(Phys::pressure) {
         //  rho * v . f, where rhov is taken as a  volume average of Flux(RHO)
         rhs[ENG] += HALF_F * dtdV * dl *
-                      (Flux(RHO,k,j,i) + Flux(RHO, k+koffset, j+joffset, i+ioffset)) * bf;
+                      (Flux(n0+RHO,k,j,i) + Flux(n0+RHO, k+koffset, j+joffset, i+ioffset)) * bf;
       } // Pressure
 
       // Particular cases if we do not sweep all of the components
       #if DIMENSIONS == 1 && COMPONENTS > 1
         EXPAND(                                                           ,
-                  rhs[MX2] += dt * Vc(RHO,k,j,i) * bodyForce(JDIR,k,j,i);   ,
-                  rhs[MX3] += dt * Vc(RHO,k,j,i) * bodyForce(KDIR,k,j,i);    )
+                  rhs[MX2] += dt * Vc(n0+RHO,k,j,i) * bodyForce(JDIR,k,j,i);   ,
+                  rhs[MX3] += dt * Vc(n0+RHO,k,j,i) * bodyForce(KDIR,k,j,i);    )
         if constexpr(Phys::pressure) {
-          rhs[ENG] += dt * (EXPAND( ZERO_F                                              ,
-                                    + Vc(RHO,k,j,i) * Vc(VX2,k,j,i) * bodyForce(JDIR,k,j,i)   ,
-                                    + Vc(RHO,k,j,i) * Vc(VX3,k,j,i) * bodyForce(KDIR,k,j,i) ));
+          rhs[ENG] += dt * (EXPAND( ZERO_F                                          ,
+                                    + Vc(n0+RHO,k,j,i)*Vc(n0+VX2,k,j,i)*bodyForce(JDIR,k,j,i) ,
+                                    + Vc(n0+RHO,k,j,i)*Vc(n0+VX3,k,j,i)*bodyForce(KDIR,k,j,i) ));
         }
       #endif
       #if DIMENSIONS == 2 && COMPONENTS == 3
         // Only add this term once!
         if constexpr (dir==JDIR) {
-          rhs[MX3] += dt * Vc(RHO,k,j,i) * bodyForce(KDIR,k,j,i);
+          rhs[MX3] += dt * Vc(n0+RHO,k,j,i) * bodyForce(KDIR,k,j,i);
           if constexpr(Phys::pressure) {
-            rhs[ENG] += dt * Vc(RHO,k,j,i) * Vc(VX3,k,j,i) * bodyForce(KDIR,k,j,i);
+            rhs[ENG] += dt * Vc(n0+RHO,k,j,i) * Vc(n0+VX3,k,j,i) * bodyForce(KDIR,k,j,i);
           }
         }
       #endif
@@ -527,12 +597,10 @@ struct Fluid_CalcRHSFunctor {
     }
 
     // Compute dt from max signal speed
-    invDt(k,j,i) = invDt(k,j,i) + HALF_F*(cMax(k+koffset,j+joffset,i+ioffset)
-                  + cMax(k,j,i)) / (dl);
+    idt = idt + HALF_F*(cMaxR + cMaxL) / (dl);
 
     if(haveParabolicTerms) {
-      invDt(k,j,i) = invDt(k,j,i) + TWO_F* FMAX(dMax(k+koffset,j+joffset,i+ioffset),
-                                                  dMax(k,j,i)) / (dl*dl);
+      idt = idt + TWO_F* FMAX(dMax(k+koffset,j+joffset,i+ioffset), dMax(k,j,i)) / (dl*dl);
     }
 
 
@@ -545,25 +613,18 @@ struct Fluid_CalcRHSFunctor {
                 if(nv == BX3) { continue; }  )
 
 
-      Uc(nv,k,j,i) = Uc(nv,k,j,i) + rhs[nv];
+      Uc(n0+nv,k,j,i) = Uc(n0+nv,k,j,i) + rhs[nv];
     }
   }
 };
 
 
 
-// Compute the right handside in direction dir from conservative equation, with timestep dt
-template<typename Phys>
-template<int dir>
-void Fluid<Phys>::CalcRightHandSide(real t, real dt) {
-  idfx::pushRegion("Fluid::CalcRightHandSide");
-
-  // Update fargo velocity when needed
-  if(data->haveFargo && data->fargo->type == Fargo::userdef) {
-    data->fargo->GetFargoVelocity(t);
-  }
-
-  auto fluxCorrection = Fluid_CorrectFluxFunctor<Phys,dir>(this,dt);
+// Launch the flux correction and right hand side kernels in direction dir
+template<typename Phys, int dir, bool haveMeanAdvection>
+void LaunchRightHandSide(Fluid<Phys> *hydro, real t, real dt) {
+  DataBlock *data = hydro->data;
+  auto fluxCorrection = Fluid_CorrectFluxFunctor<Phys,dir,haveMeanAdvection>(hydro,dt);
 
   /////////////////////////////////////////////////////////////////////////////
   // Flux correction (for fargo/non-cartesian geometry)
@@ -571,26 +632,86 @@ void Fluid<Phys>::CalcRightHandSide(real t, real dt) {
   const int ioffset = (dir==IDIR) ? 1 : 0;
   const int joffset = (dir==JDIR) ? 1 : 0;
   const int koffset = (dir==KDIR) ? 1 : 0;
-  idefix_for("Correct Flux",
-             data->beg[KDIR],data->end[KDIR]+koffset,
-             data->beg[JDIR],data->end[JDIR]+joffset,
-             data->beg[IDIR],data->end[IDIR]+ioffset,
-              fluxCorrection);
+  // (dust species of the shared storage: all of them in the same kernel)
+  const int nFused = hydro->nFusedSpecies;
+  if(nFused > 1) {
+    idefix_for("Correct Flux Species",
+               0, nFused,
+               data->beg[KDIR],data->end[KDIR]+koffset,
+               data->beg[JDIR],data->end[JDIR]+joffset,
+               data->beg[IDIR],data->end[IDIR]+ioffset,
+                fluxCorrection);
+  } else {
+    idefix_for("Correct Flux",
+               data->beg[KDIR],data->end[KDIR]+koffset,
+               data->beg[JDIR],data->end[JDIR]+joffset,
+               data->beg[IDIR],data->end[IDIR]+ioffset,
+                fluxCorrection);
+  }
 
 
   // If user has requested specific flux functions for the boundaries, here they come
-  if(boundary->haveFluxBoundary) boundary->EnforceFluxBoundaries(dir,t);
+  if(nFused > 1) {
+    if constexpr(Phys::dust) {
+      for(int s = 0 ; s < nFused ; s++) {
+        auto boundary = data->dust[hydro->instanceNumber+s]->boundary.get();
+        if(boundary->haveFluxBoundary) boundary->EnforceFluxBoundaries(dir,t);
+      }
+    }
+  } else if(hydro->boundary->haveFluxBoundary) {
+    hydro->boundary->EnforceFluxBoundaries(dir,t);
+  }
 
-  auto calcRHS = Fluid_CalcRHSFunctor<Phys,dir>(this,dt);
+  auto calcRHS = Fluid_CalcRHSFunctor<Phys,dir,haveMeanAdvection>(hydro,dt);
   /////////////////////////////////////////////////////////////////////////////
   // Final conserved quantity budget from fluxes divergence
   /////////////////////////////////////////////////////////////////////////////
-  idefix_for("CalcRightHandSide",
-             data->beg[KDIR],data->end[KDIR],
-             data->beg[JDIR],data->end[JDIR],
-             data->beg[IDIR],data->end[IDIR],
-              calcRHS);
+  // Compulsory memory traffic: read Flux, read and write Uc
+  // (the kernel name includes the physics, since nvar differs between fluids)
+  const std::string kernelName = std::string(Phys::prefix) + "::CalcRightHandSide";
+  if(nFused > 1) {
+    // kernel counters are in cells, whatever the number of species
+    idfx::annotateKernel(kernelName+"Species",
+                         nFused*Phys::nvar*(sizeof(flux_real)+2*sizeof(real)));
+    idefix_for(kernelName+"Species",
+               0, nFused,
+               data->beg[KDIR],data->end[KDIR],
+               data->beg[JDIR],data->end[JDIR],
+               data->beg[IDIR],data->end[IDIR],
+                calcRHS);
+  } else {
+    idfx::annotateKernel(kernelName, Phys::nvar*(sizeof(flux_real)+2*sizeof(real)));
+    idefix_for(kernelName,
+               data->beg[KDIR],data->end[KDIR],
+               data->beg[JDIR],data->end[JDIR],
+               data->beg[IDIR],data->end[IDIR],
+                calcRHS);
+  }
+}
+
+// Compute the right handside in direction dir from conservative equation, with timestep dt
+template<typename Phys>
+template<int dir>
+void Fluid<Phys>::CalcRightHandSide(real t, real dt) {
+  idfx::pushRegion("Fluid::CalcRightHandSide");
 
+  // Update fargo velocity when needed
+  if(data->haveFargo && data->fargo->type == Fargo::userdef) {
+    data->fargo->GetFargoVelocity(t);
+  }
+
+  // Rotation is treated as a mean advection in the fluxes only in non-cartesian geometries
+  #if GEOMETRY == CARTESIAN
+    const bool haveMeanAdvection = data->haveFargo;
+  #else
+    const bool haveMeanAdvection = data->haveFargo || haveRotation;
+  #endif
+
+  if(haveMeanAdvection) {
+    LaunchRightHandSide<Phys,dir,true>(this, t, dt);
+  } else {
+    LaunchRightHandSide<Phys,dir,false>(this, t, dt);
+  }
 
   idfx::popRegion();
 }
@@ -10,6 +10,7 @@
 
 #include "fluid.hpp"
 #include "dataBlock.hpp"
+#include "reductionManager.hpp"
 
 template<typename Phys>
 real Fluid<Phys>::CheckDivB() {
@@ -51,11 +52,7 @@ real Fluid<Phys>::CheckDivB() {
     Kokkos::Max<real>(divB) // reduction
   );
 
-#ifdef WITH_MPI
-  if(idfx::psize>1) {
-    MPI_Allreduce(MPI_IN_PLACE, &divB, 1, realMPI, MPI_MAX, MPI_COMM_WORLD);
-  }
-#endif
+  divB = idfx::reductions.Reduce(divB, idfx::ReductionManager::max);
 
   return(divB);
 }
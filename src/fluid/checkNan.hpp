@@ -11,15 +11,15 @@
 #include "dataBlock.hpp"
 #include "dataBlockHost.hpp"
 #include "fluid.hpp"
+#include "reductionManager.hpp"
 
-// Check if current datablock has nans
+// Count the nans of the current datablock in Vc and Vs (no reduction over the processes)
 
 template<typename Phys>
-int Fluid<Phys>::CheckNan()  {
-  int nanVs=0;
-  int nanVc=0;
+void Fluid<Phys>::CountNan(int &nanVc, int &nanVs)  {
+  nanVs=0;
+  nanVc=0;
 
-  idfx::pushRegion("Fluid::CheckNan");
   IdefixArray4D<real> Vc=this->Vc;
 
   idefix_reduce("checkNanVc",
@@ -44,12 +44,27 @@ int Fluid<Phys>::CheckNan()  {
       }, Kokkos::Sum<int>(nanVs) // reduction variable
     );
   }
+}
 
+template<typename Phys>
+int Fluid<Phys>::CountNan()  {
+  idfx::pushRegion("Fluid::CountNan");
+  int nanVc, nanVs;
+  CountNan(nanVc, nanVs);
+  idfx::popRegion();
+  return(nanVc+nanVs);
+}
+
+// Check if current datablock has nans
+
+template<typename Phys>
+int Fluid<Phys>::CheckNan()  {
+  idfx::pushRegion("Fluid::CheckNan");
+  int nanVc, nanVs;
+  CountNan(nanVc, nanVs);
 
-  int nanTot = nanVc+nanVs;
-  #ifdef WITH_MPI
-    MPI_Allreduce(MPI_IN_PLACE, &nanTot,1,MPI_INT, MPI_SUM, MPI_COMM_WORLD);
-  #endif
+  const int nanTot = static_cast<int>(idfx::reductions.Reduce(nanVc+nanVs,
+                                                              idfx::ReductionManager::sum));
   if(nanTot>0) {
     idfx::cout << "Fluid<" << prefix << ">: Nans were found in the current calculation"
                << std::endl;
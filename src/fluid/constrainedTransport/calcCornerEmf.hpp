@@ -10,6 +10,28 @@
 #include "fluid.hpp"
 #include "dataBlock.hpp"
 
+#if MHD == YES && DIMENSIONS >= 2
+// Cell-centered ideal EMFs E=-v x B, computed on the fly by the fused corner kernels
+// (same expressions as in CalcCellCenteredEMF)
+namespace CornerEMF {
+KOKKOS_FORCEINLINE_FUNCTION
+real Ex3(const IdefixArray4D<real> &Vc, const int k, const int j, const int i) {
+  return Vc(VX2,k,j,i)*Vc(BX1,k,j,i) - Vc(VX1,k,j,i)*Vc(BX2,k,j,i);
+}
+#if DIMENSIONS == 3
+KOKKOS_FORCEINLINE_FUNCTION
+real Ex1(const IdefixArray4D<real> &Vc, const int k, const int j, const int i) {
+  return Vc(VX3,k,j,i)*Vc(BX2,k,j,i) - Vc(VX2,k,j,i)*Vc(BX3,k,j,i);
+}
+
+KOKKOS_FORCEINLINE_FUNCTION
+real Ex2(const IdefixArray4D<real> &Vc, const int k, const int j, const int i) {
+  return Vc(VX1,k,j,i)*Vc(BX3,k,j,i) - Vc(VX3,k,j,i)*Vc(BX1,k,j,i);
+}
+#endif
+}  // namespace CornerEMF
+#endif
+
 // Compute Corner EMFs from the one stored in the Riemann step
 template<typename Phys>
 void ConstrainedTransport<Phys>::CalcCornerEMF(real t) {
@@ -21,13 +43,22 @@ void ConstrainedTransport<Phys>::CalcCornerEMF(real t) {
     CalcArithmeticAverage();
   }
   if(averaging==uct_contact||averaging==uct0) {
-    CalcCellCenteredEMF();
-    if(averaging==uct0) {
-      CalcUCT0Average();
+    if(haveFusedCornerEMF) {
+      if(averaging==uct0) {
+        CalcUCT0AverageFused();
+      } else {
+        CalcContactAverageFused();
+      }
     } else {
-      CalcContactAverage();
+      CalcCellCenteredEMF();
+      if(averaging==uct0) {
+        CalcUCT0Average();
+      } else {
+        CalcContactAverage();
+      }
     }
   }
+  // Note that uct_hll and uct_hlld are already computed in a single kernel
   if(averaging==uct_hll || averaging==uct_hlld) {
     CalcRiemannAverage();
   }
@@ -411,4 +442,174 @@ void ConstrainedTransport<Phys>::CalcContactAverage() {
 #endif // MHD
   idfx::popRegion();
 }
+
+// Fused version of CalcCellCenteredEMF+CalcUCT0Average: the face-centered EMFs are corrected
+// and averaged to the corners in registers, and the face arrays are left untouched
+template<typename Phys>
+void ConstrainedTransport<Phys>::CalcUCT0AverageFused() {
+  idfx::pushRegion("ConstrainedTransport::CalcUCT0Average");
+  IdefixArray4D<real> Vc = hydro->Vc;
+
+  // Corned EMFs
+  IdefixArray3D<real> ex = this->ex;
+  IdefixArray3D<real> ey = this->ey;
+  IdefixArray3D<real> ez = this->ez;
+
+  // Face-centered EMFs
+  IdefixArray3D<real> exj = this->exj;
+  IdefixArray3D<real> exk = this->exk;
+  IdefixArray3D<real> eyi = this->eyi;
+  IdefixArray3D<real> eyk = this->eyk;
+  IdefixArray3D<real> ezi = this->ezi;
+  IdefixArray3D<real> ezj = this->ezj;
+
+#if MHD == YES && DIMENSIONS >= 2
+  idfx::annotateKernel("CalcUCT0CornerEMFFused",
+                       (4*(DIMENSIONS-1) + 2*COMPONENTS + DIMENSIONS-1)*sizeof(real));
+  idefix_for("CalcUCT0CornerEMFFused",
+            data->beg[KDIR],data->end[KDIR]+KOFFSET,
+            data->beg[JDIR],data->end[JDIR]+JOFFSET,
+            data->beg[IDIR],data->end[IDIR]+IOFFSET,
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      const real w = ONE_FOURTH_F;
+      // Cell-centered EMFs of the 4 cells sharing the edge
+      const real ez_mm = CornerEMF::Ex3(Vc,k,j-1,i-1);
+      const real ez_m0 = CornerEMF::Ex3(Vc,k,j-1,i);
+      const real ez_0m = CornerEMF::Ex3(Vc,k,j,i-1);
+      const real ez_00 = CornerEMF::Ex3(Vc,k,j,i);
+
+      const real ezi_0 = TWO_F*ezi(k,j,i) - HALF_F*(ez_0m + ez_00);
+      const real ezi_m = TWO_F*ezi(k,j-1,i) - HALF_F*(ez_mm + ez_m0);
+      const real ezj_0 = TWO_F*ezj(k,j,i) - HALF_F*(ez_m0 + ez_00);
+      const real ezj_m = TWO_F*ezj(k,j,i-1) - HALF_F*(ez_mm + ez_0m);
+      ez(k,j,i) = w * (ezi_0 + ezi_m + ezj_0 + ezj_m);
+
+    #if DIMENSIONS == 3
+      const real ex_mm = CornerEMF::Ex1(Vc,k-1,j-1,i);
+      const real ex_m0 = CornerEMF::Ex1(Vc,k-1,j,i);
+      const real ex_0m = CornerEMF::Ex1(Vc,k,j-1,i);
+      const real ex_00 = CornerEMF::Ex1(Vc,k,j,i);
+
+      const real exj_0 = TWO_F*exj(k,j,i) - HALF_F*(ex_0m + ex_00);
+      const real exj_m = TWO_F*exj(k-1,j,i) - HALF_F*(ex_mm + ex_m0);
+      const real exk_0 = TWO_F*exk(k,j,i) - HALF_F*(ex_m0 + ex_00);
+      const real exk_m = TWO_F*exk(k,j-1,i) - HALF_F*(ex_mm + ex_0m);
+      ex(k,j,i) = w * (exj_0 + exj_m + exk_0 + exk_m);
+
+      const real ey_mm = CornerEMF::Ex2(Vc,k-1,j,i-1);
+      const real ey_m0 = CornerEMF::Ex2(Vc,k-1,j,i);
+      const real ey_0m = CornerEMF::Ex2(Vc,k,j,i-1);
+      const real ey_00 = CornerEMF::Ex2(Vc,k,j,i);
+
+      const real eyi_0 = TWO_F*eyi(k,j,i) - HALF_F*(ey_0m + ey_00);
+      const real eyi_m = TWO_F*eyi(k-1,j,i) - HALF_F*(ey_mm + ey_m0);
+      const real eyk_0 = TWO_F*eyk(k,j,i) - HALF_F*(ey_m0 + ey_00);
+      const real eyk_m = TWO_F*eyk(k,j,i-1) - HALF_F*(ey_mm + ey_0m);
+      ey(k,j,i) = w * (eyi_0 + eyi_m + eyk_0 + eyk_m);
+    #endif
+    }
+  );
+#endif
+  idfx::popRegion();
+}
+
+// Fused version of CalcCellCenteredEMF+CalcContactAverage: the cell-centered EMFs are computed
+// on the fly from Vc, so that Ex1, Ex2 and Ex3 are neither written nor read back.
+template<typename Phys>
+void ConstrainedTransport<Phys>::CalcContactAverageFused() {
+  idfx::pushRegion("ConstrainedTransport::CalcContactAverage");
+  IdefixArray4D<real> Vc = hydro->Vc;
+
+  // Corned EMFs
+  IdefixArray3D<real> ex = this->ex;
+  IdefixArray3D<real> ey = this->ey;
+  IdefixArray3D<real> ez = this->ez;
+
+  // Face-centered EMFs
+  IdefixArray3D<real> exj = this->exj;
+  IdefixArray3D<real> exk = this->exk;
+  IdefixArray3D<real> eyi = this->eyi;
+  IdefixArray3D<real> eyk = this->eyk;
+  IdefixArray3D<real> ezi = this->ezi;
+  IdefixArray3D<real> ezj = this->ezj;
+
+  // sign of contact discontinuity
+  IdefixArray3D<real> wsx = this->svx;
+  IdefixArray3D<real> wsy = this->svy;
+  IdefixArray3D<real> wsz = this->svz;
+
+#if MHD == YES && DIMENSIONS >= 2
+  idfx::annotateKernel("EMF_Integrate_to_CornerFused",
+                       (5*(DIMENSIONS-1) + 2*COMPONENTS + DIMENSIONS-1)*sizeof(real));
+  idefix_for("EMF_Integrate_to_CornerFused",
+            data->beg[KDIR],data->end[KDIR]+KOFFSET,
+            data->beg[JDIR],data->end[JDIR]+JOFFSET,
+            data->beg[IDIR],data->end[IDIR]+IOFFSET,
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      // Cell-centered EMFs of the 4 cells sharing the edge
+      const real ez_mm = CornerEMF::Ex3(Vc,k,j-1,i-1);
+      const real ez_m0 = CornerEMF::Ex3(Vc,k,j-1,i);
+      const real ez_0m = CornerEMF::Ex3(Vc,k,j,i-1);
+      const real ez_00 = CornerEMF::Ex3(Vc,k,j,i);
+
+      real ez_l2 = (1-wsx(k,j-1,i)) * (ezj(k,j,i)   - ez_m0) +
+                   (  wsx(k,j-1,i)) * (ezj(k,j,i-1) - ez_mm);
+
+      real ez_r2 = (1-wsx(k,j,i)) * (ezj(k,j,i)   - ez_00) +
+                   (  wsx(k,j,i)) * (ezj(k,j,i-1) - ez_0m);
+
+      real ez_l1 = (1-wsy(k,j,i-1)) * (ezi(k,j,i)   - ez_0m) +
+                   (  wsy(k,j,i-1)) * (ezi(k,j-1,i) - ez_mm);
+
+      real ez_r1 = (1-wsy(k,j,i)) * (ezi(k,j,i)   - ez_00) +
+                   (  wsy(k,j,i)) * (ezi(k,j-1,i) - ez_m0);
+
+      ez(k,j,i) = ONE_FOURTH_F * (ez_l2 + ez_r2 + ez_l1 + ez_r1 +
+                          ezi(k,j,i) + ezi(k,j-1,i) + ezj(k,j,i) + ezj(k,j,i-1));
+
+      #if DIMENSIONS == 3
+        const real ex_mm = CornerEMF::Ex1(Vc,k-1,j-1,i);
+        const real ex_m0 = CornerEMF::Ex1(Vc,k-1,j,i);
+        const real ex_0m = CornerEMF::Ex1(Vc,k,j-1,i);
+        const real ex_00 = CornerEMF::Ex1(Vc,k,j,i);
+
+        real ex_l3 = (1-wsy(k-1,j,i)) * (exk(k,j,i)   - ex_m0) +
+                     (  wsy(k-1,j,i)) * (exk(k,j-1,i) - ex_mm);
+
+        real ex_r3 = (1-wsy(k,j,i)) * (exk(k,j,i)   - ex_00) +
+                     (  wsy(k,j,i)) * (exk(k,j-1,i) - ex_0m);
+
+        real ex_l2 = (1-wsz(k,j-1,i)) * (exj(k,j,i)   - ex_0m) +
+                     (  wsz(k,j-1,i)) * (exj(k-1,j,i) - ex_mm);
+
+        real ex_r2 = (1-wsz(k,j,i)) * (exj(k,j,i)   - ex_00) +
+                     (  wsz(k,j,i)) * (exj(k-1,j,i) - ex_m0);
+
+        ex(k,j,i) = ONE_FOURTH_F * (ex_l3 + ex_r3 + ex_l2 + ex_r2 +
+                            exj(k,j,i) + exj(k-1,j,i) + exk(k,j,i) + exk(k,j-1,i) );
+
+        const real ey_mm = CornerEMF::Ex2(Vc,k-1,j,i-1);
+        const real ey_m0 = CornerEMF::Ex2(Vc,k-1,j,i);
+        const real ey_0m = CornerEMF::Ex2(Vc,k,j,i-1);
+        const real ey_00 = CornerEMF::Ex2(Vc,k,j,i);
+
+        real ey_l3 = (1-wsx(k-1,j,i)) * (eyk(k,j,i)   - ey_m0) +
+                     (  wsx(k-1,j,i)) * (eyk(k,j,i-1) - ey_mm);
+
+        real ey_r3 = (1-wsx(k,j,i)) * (eyk(k,j,i)   - ey_00) +
+                     (  wsx(k,j,i)) * (eyk(k,j,i-1) - ey_0m);
+
+        real ey_l1 = (1-wsz(k,j,i-1)) * (eyi(k,j,i)   - ey_0m) +
+                     (  wsz(k,j,i-1)) * (eyi(k-1,j,i) - ey_mm);
+
+        real ey_r1 = (1-wsz(k,j,i)) * (eyi(k,j,i)   - ey_00) +
+                     (  wsz(k,j,i)) * (eyi(k-1,j,i) - ey_m0);
+
+        ey(k,j,i) = ONE_FOURTH_F * (ey_l3 + ey_r3 + ey_l1 + ey_r1 +
+                            eyi(k,j,i) + eyi(k-1,j,i) + eyk(k,j,i) + eyk(k,j,i-1));
+      #endif
+    });
+#endif // MHD
+  idfx::popRegion();
+}
 #endif // FLUID_CONSTRAINEDTRANSPORT_CALCCORNEREMF_HPP_
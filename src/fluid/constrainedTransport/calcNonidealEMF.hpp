@@ -28,17 +28,23 @@ void ConstrainedTransport<Phys>::CalcNonidealEMF(real t) {
   // These arrays have been previously computed in calcParabolicFlux
   IdefixArray3D<real> etaArr = hydro->etaOhmic;
   IdefixArray3D<real> xAmbiArr = hydro->xAmbipolar;
+  IdefixArray3D<real> xHallArr = hydro->xHall;
 
   // these two are required to ensure that the type is captured by KOKKOS_LAMBDA
   HydroModuleStatus resistivity = hydro->resistivityStatus.status;
   HydroModuleStatus ambipolar = hydro->ambipolarStatus.status;
+  HydroModuleStatus hall = hydro->hallStatus.status;
 
   bool haveResistivity{false};
   bool haveAmbipolar{false};
+  bool haveHall{false};
 
   if(data->rklCycle) {
     haveResistivity = hydro->resistivityStatus.isRKL;
     haveAmbipolar = hydro->ambipolarStatus.isRKL;
+  } else if(data->hallCycle) {
+    // Hall sub-cycles: the other effects are integrated in their own steps
+    haveHall = hydro->hallStatus.isSubcycled;
   } else {
     haveResistivity = hydro->resistivityStatus.isExplicit;
     haveAmbipolar = hydro->ambipolarStatus.isExplicit;
@@ -46,6 +52,7 @@ void ConstrainedTransport<Phys>::CalcNonidealEMF(real t) {
 
   real etaConstant = hydro->etaO;
   real xAConstant = hydro->xA;
+  real xHConstant = hydro->xH;
 
   idefix_for("CalcNIEMF",
              data->beg[KDIR],data->end[KDIR]+KOFFSET,
@@ -54,13 +61,15 @@ void ConstrainedTransport<Phys>::CalcNonidealEMF(real t) {
     KOKKOS_LAMBDA (int k, int j, int i) {
       real Bx1, Bx2, Bx3;
       real Jx1, Jx2, Jx3;
-      real eta, xA;
+      real eta, xA, xH;
       // CT_EMF_ArithmeticAverage (emf, 0.25);
 
       if(resistivity == Constant)
         eta = etaConstant;
       if(ambipolar == Constant)
         xA = xAConstant;
+      if(hall == Constant)
+        xH = xHConstant;
 
   #if DIMENSIONS == 3
       // -----------------------
@@ -75,9 +84,7 @@ void ConstrainedTransport<Phys>::CalcNonidealEMF(real t) {
         ex(k,j,i) += eta * Jx1;
       }
 
-      // Ambipolar diffusion
-      if(haveAmbipolar) {
-        if(ambipolar == UserDefFunction) xA = AVERAGE_3D_YZ(xAmbiArr,k,j,i);
+      if(haveAmbipolar || haveHall) {
         Bx1 = AVERAGE_4D_XYZ(Vs, BX1s, k,j,i+1);
         Bx2 = AVERAGE_4D_Z(Vs, BX2s, k, j, i);
         Bx3 = AVERAGE_4D_Y(Vs, BX3s, k, j, i);
@@ -85,6 +92,11 @@ void ConstrainedTransport<Phys>::CalcNonidealEMF(real t) {
         // Jx1 is already defined above
         Jx2 = AVERAGE_4D_XY(J, JDIR, k, j, i+1);
         Jx3 = AVERAGE_4D_XZ(J, KDIR, k, j, i+1);
+      }
+
+      // Ambipolar diffusion
+      if(haveAmbipolar) {
+        if(ambipolar == UserDefFunction) xA = AVERAGE_3D_YZ(xAmbiArr,k,j,i);
 
         real JdotB = (Jx1*Bx1 + Jx2*Bx2 + Jx3*Bx3);
         real BdotB = (Bx1*Bx1 + Bx2*Bx2 + Bx3*Bx3);
@@ -92,6 +104,12 @@ void ConstrainedTransport<Phys>::CalcNonidealEMF(real t) {
         ex(k,j,i) += xA * (BdotB*Jx1 - JdotB * Bx1);
       }
 
+      // Hall effect
+      if(haveHall) {
+        if(hall == UserDefFunction) xH = AVERAGE_3D_YZ(xHallArr,k,j,i);
+        ex(k,j,i) += xH * (Jx2*Bx3 - Jx3*Bx2);
+      }
+
       // -----------------------
       // X2 EMF Component
       // -----------------------
@@ -103,9 +121,7 @@ void ConstrainedTransport<Phys>::CalcNonidealEMF(real t) {
         ey(k,j,i) += eta * Jx2;
       }
 
-      // Ambipolar diffusion
-      if(haveAmbipolar) {
-        if(ambipolar == UserDefFunction) xA = AVERAGE_3D_XZ(xAmbiArr,k,j,i);
+      if(haveAmbipolar || haveHall) {
         Bx1 = AVERAGE_4D_Z(Vs, BX1s, k, j, i);
         Bx2 = AVERAGE_4D_XYZ(Vs, BX2s, k, j+1, i);
         Bx3 = AVERAGE_4D_X(Vs, BX3s, k, j, i);
@@ -113,12 +129,23 @@ void ConstrainedTransport<Phys>::CalcNonidealEMF(real t) {
         // Jx2 is already defined above
         Jx1 = AVERAGE_4D_XY(J, IDIR, k, j+1, i);
         Jx3 = AVERAGE_4D_YZ(J, KDIR, k, j+1, i);
+      }
+
+      // Ambipolar diffusion
+      if(haveAmbipolar) {
+        if(ambipolar == UserDefFunction) xA = AVERAGE_3D_XZ(xAmbiArr,k,j,i);
 
         real JdotB = (Jx1*Bx1 + Jx2*Bx2 + Jx3*Bx3);
         real BdotB = (Bx1*Bx1 + Bx2*Bx2 + Bx3*Bx3);
 
         ey(k,j,i) += xA * (BdotB*Jx2 - JdotB * Bx2);
       }
+
+      // Hall effect
+      if(haveHall) {
+        if(hall == UserDefFunction) xH = AVERAGE_3D_XZ(xHallArr,k,j,i);
+        ey(k,j,i) += xH * (Jx3*Bx1 - Jx1*Bx3);
+      }
   #endif
       // -----------------------
       // X3 EMF Component
@@ -131,9 +158,7 @@ void ConstrainedTransport<Phys>::CalcNonidealEMF(real t) {
         ez(k,j,i) += eta * Jx3;
       }
 
-      // Ambipolar diffusion
-      if(haveAmbipolar) {
-        if(ambipolar == UserDefFunction) xA = AVERAGE_3D_XY(xAmbiArr,k,j,i);
+      if(haveAmbipolar || haveHall) {
         Bx1 = AVERAGE_4D_Y(Vs, BX1s, k, j, i);
   #if DIMENSIONS >= 2
         Bx2 = AVERAGE_4D_X(Vs, BX2s, k, j, i);
@@ -163,11 +188,23 @@ void ConstrainedTransport<Phys>::CalcNonidealEMF(real t) {
         Jx1 = AVERAGE_4D_X(J, IDIR, k, j, i);
         Jx2 = AVERAGE_4D_Y(J, JDIR, k, j, i);
   #endif
+      }
+
+      // Ambipolar diffusion
+      if(haveAmbipolar) {
+        if(ambipolar == UserDefFunction) xA = AVERAGE_3D_XY(xAmbiArr,k,j,i);
+
         real JdotB = (Jx1*Bx1 + Jx2*Bx2 + Jx3*Bx3);
         real BdotB = (Bx1*Bx1 + Bx2*Bx2 + Bx3*Bx3);
 
         ez(k,j,i) += xA * (BdotB * Jx3 - JdotB * Bx3);
       }
+
+      // Hall effect
+      if(haveHall) {
+        if(hall == UserDefFunction) xH = AVERAGE_3D_XY(xHallArr,k,j,i);
+        ez(k,j,i) += xH * (Jx1*Bx2 - Jx2*Bx1);
+      }
     }
   );
 #endif
@@ -77,7 +77,7 @@ void ConstrainedTransport<Phys>::CalcRiemannAverage() {
       dL = HALF_F*(dxL(k,jm,i) + dxL(k,jm+1,i));
       dR = HALF_F*(dxR(k,jm,i) + dxR(k,jm+1,i));
 
-      #if ORDER == 4
+      #if ORDER >= 4
         SL::getPPMStates( Vs(BX2s,k,j,im-2),
                           Vs(BX2s,k,j,im-1),
                           Vs(BX2s,k,j,im),
@@ -102,7 +102,7 @@ void ConstrainedTransport<Phys>::CalcRiemannAverage() {
 
       #endif
 
-      #if ORDER == 4
+      #if ORDER >= 4
         SL::getPPMStates( ezj(k,j,im-2),
                           ezj(k,j,im-1),
                           ezj(k,j,im),
@@ -137,7 +137,7 @@ void ConstrainedTransport<Phys>::CalcRiemannAverage() {
       dL = HALF_F*(dxL(km,j,i) + dxL(km+1,j,i));
       dR = HALF_F*(dxR(km,j,i) + dxR(km+1,j,i));
 
-      #if ORDER == 4
+      #if ORDER >= 4
         SL::getPPMStates( Vs(BX3s,k,j,im-2),
                           Vs(BX3s,k,j,im-1),
                           Vs(BX3s,k,j,im),
@@ -161,7 +161,7 @@ void ConstrainedTransport<Phys>::CalcRiemannAverage() {
         bR = Vs(BX3s,k,j,i) - HALF_F*db;
       #endif
 
-      #if ORDER == 4
+      #if ORDER >= 4
         SL::getPPMStates( eyk(k,j,im-2),
                           eyk(k,j,im-1),
                           eyk(k,j,im),
@@ -198,7 +198,7 @@ void ConstrainedTransport<Phys>::CalcRiemannAverage() {
       dL = HALF_F*(dyL(km,j,i) + dyL(km+1,j,i));
       dR = HALF_F*(dyR(km,j,i) + dyR(km+1,j,i));
 
-      #if ORDER == 4
+      #if ORDER >= 4
         SL::getPPMStates(Vs(BX3s,k,jm-2,i),
                      Vs(BX3s,k,jm-1,i),
                      Vs(BX3s,k,jm,i),
@@ -222,7 +222,7 @@ void ConstrainedTransport<Phys>::CalcRiemannAverage() {
         bR = Vs(BX3s,k,j,i) - HALF_F*db;
       #endif
 
-      #if ORDER == 4
+      #if ORDER >= 4
         SL::getPPMStates(exk(k,jm-2,i),
                      exk(k,jm-1,i),
                      exk(k,jm,i),
@@ -256,7 +256,7 @@ void ConstrainedTransport<Phys>::CalcRiemannAverage() {
       dL = HALF_F*(dyL(k,j,im) + dyL(k,j,im+1));
       dR = HALF_F*(dyR(k,j,im) + dyR(k,j,im+1));
 
-      #if ORDER == 4
+      #if ORDER >= 4
         SL::getPPMStates(Vs(BX1s,k,jm-2,i),
                      Vs(BX1s,k,jm-1,i),
                      Vs(BX1s,k,jm,i),
@@ -280,7 +280,7 @@ void ConstrainedTransport<Phys>::CalcRiemannAverage() {
         bR = Vs(BX1s,k,j,i) - HALF_F*db;
       #endif
 
-      #if ORDER == 4
+      #if ORDER >= 4
         SL::getPPMStates(ezi(k,jm-2,i),
                      ezi(k,jm-1,i),
                      ezi(k,jm,i),
@@ -316,7 +316,7 @@ void ConstrainedTransport<Phys>::CalcRiemannAverage() {
       dL = HALF_F*(dzL(k,j,im) + dzL(k,j,im+1));
       dR = HALF_F*(dzR(k,j,im) + dzR(k,j,im+1));
 
-      #if ORDER == 4
+      #if ORDER >= 4
         SL::getPPMStates(Vs(BX1s,km-2,j,i),
                      Vs(BX1s,km-1,j,i),
                      Vs(BX1s,km,j,i),
@@ -340,7 +340,7 @@ void ConstrainedTransport<Phys>::CalcRiemannAverage() {
         bR = Vs(BX1s,k,j,i) - HALF_F*db;
       #endif
 
-      #if ORDER == 4
+      #if ORDER >= 4
         SL::getPPMStates(eyi(km-2,j,i),
                      eyi(km-1,j,i),
                      eyi(km,j,i),
@@ -373,7 +373,7 @@ void ConstrainedTransport<Phys>::CalcRiemannAverage() {
       dL = HALF_F*(dzL(k,jm,i) + dzL(k,jm+1,i));
       dR = HALF_F*(dzR(k,jm,i) + dzR(k,jm+1,i));
 
-      #if ORDER == 4
+      #if ORDER >= 4
         SL::getPPMStates(Vs(BX2s,km-2,j,i),
                      Vs(BX2s,km-1,j,i),
                      Vs(BX2s,km,j,i),
@@ -397,7 +397,7 @@ void ConstrainedTransport<Phys>::CalcRiemannAverage() {
         bR = Vs(BX2s,k,j,i) - HALF_F*db;
       #endif
 
-      #if ORDER == 4
+      #if ORDER >= 4
         SL::getPPMStates(exj(km-2,j,i),
                      exj(km-1,j,i),
                      exj(km,j,i),
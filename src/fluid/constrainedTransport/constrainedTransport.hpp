@@ -26,6 +26,10 @@ class ConstrainedTransport {
   // Type of averaging
   AveragingType averaging{none};
 
+  // Whether corner EMFs are computed in a single kernel, with the cell-centered EMFs computed
+  // on the fly instead of being stored (uct0 and uct_contact)
+  bool haveFusedCornerEMF{true};
+
   // Face centered emf components
   IdefixArray3D<real>     exj;
   IdefixArray3D<real>     exk;
@@ -87,6 +91,8 @@ class ConstrainedTransport {
   void CalcCellCenteredEMF();
   void CalcUCT0Average();
   void CalcContactAverage();
+  void CalcUCT0AverageFused();
+  void CalcContactAverageFused();
 
   // Enforce boundary conditions on the EMFs.
   void EnforceEMFBoundary();
@@ -174,13 +180,24 @@ ConstrainedTransport<Phys>::ConstrainedTransport(Input &input, Fluid<Phys> *hydr
       IDEFIX_ERROR("Unknown EMF averaging scheme");
     }
   } else {
-    if(hydro->hallStatus.status == HydroModuleStatus::Disabled) {
-      // by default, use uct_contact
+    if(!hydro->hallStatus.isExplicit) {
+      // by default, use uct_contact (a sub-cycled Hall effect has its own EMF)
       this->averaging = uct_contact;
     } else {
       this->averaging = arithmetic;
     }
   }
+  #ifdef FIXED_EMF
+    // The averaging scheme has been fixed at compile time (Idefix_EMF)
+    if(input.CheckEntry("Hydro","emf")<0) {
+      this->averaging = FIXED_EMF;
+    } else if(this->averaging != FIXED_EMF) {
+      IDEFIX_ERROR("The emf averaging scheme requested in the input file differs from the one "
+                   "set at compile time with Idefix_EMF");
+    }
+  #endif
+
+  haveFusedCornerEMF = input.GetOrSet<bool>("Hydro","emf_fused",0,true);
 
   this->data = hydro->data;
   this->hydro = hydro;
@@ -200,60 +217,47 @@ ConstrainedTransport<Phys>::ConstrainedTransport(Input &input, Fluid<Phys> *hydr
             ey = IdefixArray3D<real>("EMF_ey",
                               data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);  )
 
-  D_EXPAND( ezi = IdefixArray3D<real>("EMF_ezi",
-                              data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-            ezj = IdefixArray3D<real>("EMF_ezj",
-                              data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);  ,
-                                                                                            ,
-            exj = IdefixArray3D<real>("EMF_exj",
-                              data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-            exk = IdefixArray3D<real>("EMF_exj",
-                              data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-            eyi = IdefixArray3D<real>("EMF_eyi",
-                              data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-            eyk = IdefixArray3D<real>("EMF_eyi",
-                              data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]); )
+  // Face-centered EMFs and the averaging helpers are only needed within a stage (or an RKL
+  // cycle), so that they can share memory with the scratch arrays of other phases
+  const int lifetime = ScratchArena::stagePhase | ScratchArena::rklPhase;
+  const int nk = data->np_tot[KDIR];
+  const int nj = data->np_tot[JDIR];
+  const int ni = data->np_tot[IDIR];
+  ScratchArena &scratch = data->scratch;
+
+  D_EXPAND( scratch.Request(ezi, "EMF_ezi", lifetime, nk, nj, ni);
+            scratch.Request(ezj, "EMF_ezj", lifetime, nk, nj, ni);  ,
+                                                                    ,
+            scratch.Request(exj, "EMF_exj", lifetime, nk, nj, ni);
+            scratch.Request(exk, "EMF_exk", lifetime, nk, nj, ni);
+            scratch.Request(eyi, "EMF_eyi", lifetime, nk, nj, ni);
+            scratch.Request(eyk, "EMF_eyk", lifetime, nk, nj, ni);  )
 
   if(averaging==uct_contact) {
-    D_EXPAND( svx = IdefixArray3D<real>("EMF_svx",
-                                data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);  ,
-              svy = IdefixArray3D<real>("EMF_svy",
-                                data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);  ,
-              svz = IdefixArray3D<real>("EMF_svz",
-                                data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);  )
+    D_EXPAND( scratch.Request(svx, "EMF_svx", lifetime, nk, nj, ni);  ,
+              scratch.Request(svy, "EMF_svy", lifetime, nk, nj, ni);  ,
+              scratch.Request(svz, "EMF_svz", lifetime, nk, nj, ni);  )
   }
 
 
   if(averaging==uct_hll || averaging==uct_hlld) {
-    D_EXPAND( axL = IdefixArray3D<real>("EMF_axL",
-                                data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-              axR = IdefixArray3D<real>("EMF_axR",
-                                data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);  ,
-
-              ayL = IdefixArray3D<real>("EMF_ayL",
-                                data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-              ayR = IdefixArray3D<real>("EMF_ayR",
-                                data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);  ,
-
-              azL = IdefixArray3D<real>("EMF_azL",
-                                data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-              azR = IdefixArray3D<real>("EMF_azR",
-                                data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);  )
-
-    D_EXPAND( dxL = IdefixArray3D<real>("EMF_dxL",
-                                data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-              dxR = IdefixArray3D<real>("EMF_dxR",
-                                data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);  ,
-
-              dyL = IdefixArray3D<real>("EMF_dyL",
-                                data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-              dyR = IdefixArray3D<real>("EMF_dyR",
-                                data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);  ,
-
-              dzL = IdefixArray3D<real>("EMF_dzL",
-                                data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-              dzR = IdefixArray3D<real>("EMF_dzR",
-                                data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);  )
+    D_EXPAND( scratch.Request(axL, "EMF_axL", lifetime, nk, nj, ni);
+              scratch.Request(axR, "EMF_axR", lifetime, nk, nj, ni);  ,
+
+              scratch.Request(ayL, "EMF_ayL", lifetime, nk, nj, ni);
+              scratch.Request(ayR, "EMF_ayR", lifetime, nk, nj, ni);  ,
+
+              scratch.Request(azL, "EMF_azL", lifetime, nk, nj, ni);
+              scratch.Request(azR, "EMF_azR", lifetime, nk, nj, ni);  )
+
+    D_EXPAND( scratch.Request(dxL, "EMF_dxL", lifetime, nk, nj, ni);
+              scratch.Request(dxR, "EMF_dxR", lifetime, nk, nj, ni);  ,
+
+              scratch.Request(dyL, "EMF_dyL", lifetime, nk, nj, ni);
+              scratch.Request(dyR, "EMF_dyR", lifetime, nk, nj, ni);  ,
+
+              scratch.Request(dzL, "EMF_dzL", lifetime, nk, nj, ni);
+              scratch.Request(dzR, "EMF_dzR", lifetime, nk, nj, ni);  )
   }
   if(averaging==uct_hlld) {
     if(   hydro->rSolver->GetSolver() == RiemannSolver<Phys>::Solver::HLL_MHD
@@ -446,6 +450,10 @@ void ConstrainedTransport<Phys>::ShowConfig() {
     default:
       IDEFIX_ERROR("Unknown averaging scheme");
   }
+  if(haveFusedCornerEMF && (averaging==uct0 || averaging==uct_contact)) {
+    idfx::cout << "ConstrainedTransport: corner EMFs computed in a single fused kernel."
+               << std::endl;
+  }
 }
 
 #include "calcCornerEmf.hpp"
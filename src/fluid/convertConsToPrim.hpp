@@ -8,9 +8,12 @@
 #ifndef FLUID_CONVERTCONSTOPRIM_HPP_
 #define FLUID_CONVERTCONSTOPRIM_HPP_
 
+#include <string>
+
 #include "fluid.hpp"
 #include "dataBlock.hpp"
 #include "tracer.hpp"
+#include "simdBatch.hpp"
 
 template <typename Phys>
 KOKKOS_INLINE_FUNCTION void K_ConsToPrim(real Vc[], real Uc[], const EquationOfState *eos) {
@@ -66,8 +69,9 @@ KOKKOS_INLINE_FUNCTION void K_ConsToPrim(real Vc[], real Uc[], const EquationOfS
   } // Have Energy
 }
 
-template <typename Phys>
-KOKKOS_INLINE_FUNCTION void K_PrimToCons(real Uc[], real Vc[], const EquationOfState *eos) {
+// T is either real or a batch of reals (idfx::Batch)
+template <typename Phys, typename T = real>
+KOKKOS_INLINE_FUNCTION void K_PrimToCons(T Uc[], T Vc[], const EquationOfState *eos) {
   Uc[RHO] = Vc[RHO];
 
   EXPAND( Uc[MX1] = Vc[VX1]*Vc[RHO];  ,
@@ -83,7 +87,7 @@ KOKKOS_INLINE_FUNCTION void K_PrimToCons(real Uc[], real Vc[], const EquationOfS
 
   if constexpr(Phys::pressure) {
     if constexpr(Phys::mhd) {
-      Uc[ENG] = eos->GetInternalEnergy(Vc[PRS],Vc[RHO])
+      Uc[ENG] = idfx::GetInternalEnergy(*eos,Vc[PRS],Vc[RHO])
                 + HALF_F * Vc[RHO] * (EXPAND( Vc[VX1]*Vc[VX1]  ,
                                             + Vc[VX2]*Vc[VX2]  ,
                                             + Vc[VX3]*Vc[VX3]  ))
@@ -91,7 +95,7 @@ KOKKOS_INLINE_FUNCTION void K_PrimToCons(real Uc[], real Vc[], const EquationOfS
                                   + Uc[BX2]*Uc[BX2]  ,
                                   + Uc[BX3]*Uc[BX3]  ));
     } else {
-      Uc[ENG] = eos->GetInternalEnergy(Vc[PRS],Vc[RHO])
+      Uc[ENG] = idfx::GetInternalEnergy(*eos,Vc[PRS],Vc[RHO])
                 + HALF_F * Vc[RHO] * (EXPAND( Vc[VX1]*Vc[VX1]  ,
                                             + Vc[VX2]*Vc[VX2]  ,
                                             + Vc[VX3]*Vc[VX3]  ));
@@ -120,7 +124,11 @@ void Fluid<Phys>::ConvertConsToPrim() {
     boundary->ReconstructVcField(Uc);
   }
 
-  idefix_for("ConsToPrim",
+  // Compulsory memory traffic: read Uc, write Vc
+  // (the kernel name includes the physics, since nvar differs between fluids)
+  const std::string kernelName = std::string(Phys::prefix) + "::ConsToPrim";
+  idfx::annotateKernel(kernelName, 2*Phys::nvar*sizeof(real));
+  idefix_for(kernelName,
              0,data->np_tot[KDIR],
              0,data->np_tot[JDIR],
              0,data->np_tot[IDIR],
@@ -160,7 +168,11 @@ void Fluid<Phys>::ConvertPrimToCons() {
     eos = *(this->eos.get());
   }
 
-  idefix_for("ConvertPrimToCons",
+  // Compulsory memory traffic: read Vc, write Uc
+  // (the kernel name includes the physics, since nvar differs between fluids)
+  const std::string kernelName = std::string(Phys::prefix) + "::ConvertPrimToCons";
+  idfx::annotateKernel(kernelName, 2*Phys::nvar*sizeof(real));
+  idefix_for(kernelName,
              0,data->np_tot[KDIR],
              0,data->np_tot[JDIR],
              0,data->np_tot[IDIR],
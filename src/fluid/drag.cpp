@@ -5,8 +5,10 @@
 // Licensed under CeCILL 2.1 License, see COPYING for more information
 // ***********************************************************************************
 #include "drag.hpp"
+#include <limits>
 #include <string>
 #include "physics.hpp"
+#include "dataBlock.hpp"
 
 void Drag::AddDragForce(const real dt) {
   idfx::pushRegion("Drag::AddDragForce");
@@ -263,3 +265,351 @@ GammaDrag::GammaDrag(Input &input, std::string BlockName, int instanceNumber, Da
   this->dragCoeff = input.Get<real>(BlockName,"drag",instanceNumber+1);
   this->instanceNumber = instanceNumber;
 }
+
+////////////////////////////////////////////
+// MultiSpeciesDrag function definitions
+////////////////////////////////////////////
+
+MultiSpeciesDrag::MultiSpeciesDrag(Input &input, DataBlock *datain) {
+  idfx::pushRegion("MultiSpeciesDrag::MultiSpeciesDrag");
+  this->data = datain;
+  this->nSpecies = data->dust.size();
+  // The drag law and the feedback are common to all of the species
+  this->feedback = data->dust[0]->drag->HasFeedback();
+
+  std::string solverName = input.GetOrSet<std::string>("Dust","drag_implicit_solver",0,"fused");
+  if(solverName.compare("fused") == 0) {
+    this->solver = Solver::fused;
+  } else if(solverName.compare("split") == 0) {
+    this->solver = Solver::split;
+  } else if(solverName.compare("exact") == 0) {
+    this->solver = Solver::exact;
+    if(nSpecies > exactMaxSpecies) {
+      std::stringstream msg;
+      msg << "The exact implicit drag solver is limited to " << exactMaxSpecies
+          << " dust species." << std::endl;
+      IDEFIX_ERROR(msg);
+    }
+  } else {
+    std::stringstream msg;
+    msg << "Unknown implicit drag solver \"" << solverName << "\" in your input file."
+        << std::endl << "Allowed values are: fused, split, exact." << std::endl;
+    IDEFIX_ERROR(msg);
+  }
+
+  // Gather the pointers to the dust arrays of each specie
+  UcDust = IdefixArray1D<real*>("MultiSpeciesDrag_UcDust",nSpecies);
+  VcDust = IdefixArray1D<real*>("MultiSpeciesDrag_VcDust",nSpecies);
+  gammai = IdefixArray1D<real*>("MultiSpeciesDrag_gammai",nSpecies);
+  beta = IdefixArray1D<real>("MultiSpeciesDrag_beta",nSpecies);
+
+  auto UcDustHost = Kokkos::create_mirror_view(UcDust);
+  auto VcDustHost = Kokkos::create_mirror_view(VcDust);
+  auto gammaiHost = Kokkos::create_mirror_view(gammai);
+  auto betaHost = Kokkos::create_mirror_view(beta);
+
+  for(int s = 0 ; s < nSpecies ; s++) {
+    Fluid<DustPhysics> *fluid = data->dust[s].get();
+    UcDustHost(s) = fluid->Uc.data();
+    VcDustHost(s) = fluid->Vc.data();
+    gammaiHost(s) = fluid->drag->gammaDrag.gammai.data();
+    betaHost(s) = fluid->drag->gammaDrag.dragCoeff;
+  }
+  Kokkos::deep_copy(UcDust, UcDustHost);
+  Kokkos::deep_copy(VcDust, VcDustHost);
+  Kokkos::deep_copy(gammai, gammaiHost);
+  Kokkos::deep_copy(beta, betaHost);
+
+  // All of the dust fluids share the same dimensions
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    stride[dir] = data->dust[0]->Uc.stride(dir);
+  }
+  if(data->dust[0]->drag->gammaDrag.type == GammaDrag::Type::Userdef) {
+    strideGamma[0] = data->dust[0]->drag->gammaDrag.gammai.stride(0);
+    strideGamma[1] = data->dust[0]->drag->gammaDrag.gammai.stride(1);
+  } else {
+    strideGamma = {0, 0};
+  }
+  idfx::popRegion();
+}
+
+void MultiSpeciesDrag::AddImplicitDrag(const real dt) {
+  idfx::pushRegion("MultiSpeciesDrag::AddImplicitDrag");
+  // Refresh the user-defined drag coefficients of all of the species
+  if(solver != Solver::split) {
+    for(int s = 0 ; s < nSpecies ; s++) {
+      data->dust[s]->drag->gammaDrag.RefreshUserDrag(data);
+    }
+  }
+  switch(solver) {
+    case Solver::split:
+      AddImplicitDragSplit(dt);
+      break;
+    case Solver::fused:
+      AddImplicitDragFused(dt);
+      break;
+    case Solver::exact:
+      AddImplicitDragExact(dt);
+      break;
+  }
+  idfx::popRegion();
+}
+
+void MultiSpeciesDrag::AddImplicitDragSplit(const real dt) {
+  auto &dust = data->dust;
+  for(int i = 0 ; i < dust.size() ; i++) {
+    dust[i]->drag->AddImplicitBackReaction(dt,dust[0]->drag->implicitFactor);
+  }
+  dust[0]->drag->NormalizeImplicitBackReaction(dt);
+  for(int i = 0 ; i < dust.size() ; i++) {
+    dust[i]->drag->AddImplicitFluidMomentum(dt);
+  }
+}
+
+// Same 1st order implicit scheme as AddImplicitBackReaction, NormalizeImplicitBackReaction
+// and AddImplicitFluidMomentum, but with all of the species updated in the same pass.
+void MultiSpeciesDrag::AddImplicitDragFused(const real dt) {
+  idfx::pushRegion("MultiSpeciesDrag::AddImplicitDragFused");
+  auto UcGas = data->hydro->Uc;
+  auto UcDust = this->UcDust;
+  auto VcDust = this->VcDust;
+  auto gammai = this->gammai;
+  auto beta = this->beta;
+  auto gammaDrag = data->dust[0]->drag->gammaDrag;
+  const bool userDef = gammaDrag.type == GammaDrag::Type::Userdef;
+  const bool feedback = this->feedback;
+  const int nSpecies = this->nSpecies;
+  const int64_t sv = stride[0];
+  const int64_t sk = stride[1];
+  const int64_t sj = stride[2];
+  const int64_t gk = strideGamma[0];
+  const int64_t gj = strideGamma[1];
+
+  idfx::annotateKernel("MultiSpeciesDrag", nSpecies*(2*COMPONENTS+2)*sizeof(real)
+                                           + (2*COMPONENTS+2)*sizeof(real));
+  idefix_for("MultiSpeciesDrag",0,data->np_tot[KDIR],0,data->np_tot[JDIR],0,data->np_tot[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      const int64_t idx = k*sk + j*sj + i;
+      const real rhoGas = UcGas(RHO,k,j,i);
+
+      if(feedback) {
+        // Back reaction on the gas
+        real preFactor = 0;
+        real mom[COMPONENTS];
+        for(int n = 0 ; n < COMPONENTS ; n++) {
+          mom[n] = UcGas(MX1+n,k,j,i);
+        }
+        for(int s = 0 ; s < nSpecies ; s++) {
+          const real gamma = userDef ? gammai(s)[k*gk + j*gj + i]
+                                     : gammaDrag.GetGamma(beta(s),k,j,i);
+          const real *Uc = UcDust(s);
+          preFactor += Uc[RHO*sv + idx]*gamma*dt/(1+rhoGas*gamma*dt);
+          for(int n = 0 ; n < COMPONENTS ; n++) {
+            mom[n] += dt * gamma * rhoGas * Uc[(MX1+n)*sv + idx] / (1 + rhoGas*dt*gamma);
+          }
+        }
+        const real factor = 1+preFactor;
+        for(int n = 0 ; n < COMPONENTS ; n++) {
+          UcGas(MX1+n,k,j,i) = mom[n] / factor;
+        }
+      }
+
+      // Dust momentum, using the updated gas momentum
+      for(int s = 0 ; s < nSpecies ; s++) {
+        const real gamma = userDef ? gammai(s)[k*gk + j*gj + i]
+                                   : gammaDrag.GetGamma(beta(s),k,j,i);
+        real *Uc = UcDust(s);
+        [[maybe_unused]] const real *Vc = VcDust(s);
+        for(int n = 0 ; n < COMPONENTS ; n++) {
+          const real oldUc = Uc[(MX1+n)*sv + idx];
+          const real newUc = (oldUc + dt * gamma * Uc[RHO*sv + idx] * UcGas(MX1+n,k,j,i)) /
+                             (1 + rhoGas*dt*gamma);
+          Uc[(MX1+n)*sv + idx] = newUc;
+          #if HAVE_ENERGY == 1
+            // Heating by the dust drag (see AddImplicitFluidMomentum)
+            if(feedback) UcGas(ENG,k,j,i) -= (newUc - oldUc)*Vc[(MX1+n)*sv + idx];
+          #endif
+        }
+      }
+    });
+  idfx::popRegion();
+}
+
+// Diagonalise the symmetric matrix a (of size n) with the cyclic Jacobi method.
+// On output, the diagonal of a contains the eigenvalues and the columns of v the eigenvectors.
+template<int N>
+KOKKOS_INLINE_FUNCTION void JacobiEigenSolve(real (&a)[N][N], real (&v)[N][N],
+                                             const int n, const real tol) {
+  for(int p = 0 ; p < n ; p++) {
+    for(int q = 0 ; q < n ; q++) {
+      v[p][q] = (p == q) ? 1 : 0;
+    }
+  }
+  for(int sweep = 0 ; sweep < 50 ; sweep++) {
+    real off = 0;
+    real diag = 0;
+    for(int p = 0 ; p < n ; p++) {
+      diag += a[p][p]*a[p][p];
+      for(int q = p+1 ; q < n ; q++) {
+        off += a[p][q]*a[p][q];
+      }
+    }
+    if(off <= tol*tol*diag) return;
+
+    for(int p = 0 ; p < n-1 ; p++) {
+      for(int q = p+1 ; q < n ; q++) {
+        const real apq = a[p][q];
+        if(apq == 0) continue;
+        const real theta = (a[q][q]-a[p][p])/(2*apq);
+        real t = 1/(std::fabs(theta) + std::sqrt(theta*theta+1));
+        if(theta < 0) t = -t;
+        const real c = 1/std::sqrt(t*t+1);
+        const real s = t*c;
+        for(int m = 0 ; m < n ; m++) {
+          const real amp = a[m][p];
+          const real amq = a[m][q];
+          a[m][p] = c*amp - s*amq;
+          a[m][q] = s*amp + c*amq;
+        }
+        for(int m = 0 ; m < n ; m++) {
+          const real apm = a[p][m];
+          const real aqm = a[q][m];
+          a[p][m] = c*apm - s*aqm;
+          a[q][m] = s*apm + c*aqm;
+        }
+        for(int m = 0 ; m < n ; m++) {
+          const real vmp = v[m][p];
+          const real vmq = v[m][q];
+          v[m][p] = c*vmp - s*vmq;
+          v[m][q] = s*vmp + c*vmq;
+        }
+      }
+    }
+  }
+}
+
+// Exact integration over dt of the linear drag system (with frozen densities and drag
+// coefficients). With u=p/sqrt(rho), the system reads du/dt=-S.u where S is symmetric, so that
+// u(dt)=Q.exp(-L dt).Q^T.u(0) with S=Q.L.Q^T.
+void MultiSpeciesDrag::AddImplicitDragExact(const real dt) {
+  idfx::pushRegion("MultiSpeciesDrag::AddImplicitDragExact");
+  auto UcGas = data->hydro->Uc;
+  auto UcDust = this->UcDust;
+  auto gammai = this->gammai;
+  auto beta = this->beta;
+  auto gammaDrag = data->dust[0]->drag->gammaDrag;
+  const bool userDef = gammaDrag.type == GammaDrag::Type::Userdef;
+  const bool feedback = this->feedback;
+  const int nSpecies = this->nSpecies;
+  const int64_t sv = stride[0];
+  const int64_t sk = stride[1];
+  const int64_t sj = stride[2];
+  const int64_t gk = strideGamma[0];
+  const int64_t gj = strideGamma[1];
+  const real tol = std::numeric_limits<real>::epsilon();
+  constexpr int nmax = exactMaxSpecies+1;
+
+  idefix_for("MultiSpeciesDragExact",
+              0,data->np_tot[KDIR],0,data->np_tot[JDIR],0,data->np_tot[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      const int64_t idx = k*sk + j*sj + i;
+      const real rhoGas = UcGas(RHO,k,j,i);
+
+      if(!feedback) {
+        // Each specie relaxes independently towards the gas velocity
+        for(int s = 0 ; s < nSpecies ; s++) {
+          const real gamma = userDef ? gammai(s)[k*gk + j*gj + i]
+                                     : gammaDrag.GetGamma(beta(s),k,j,i);
+          real *Uc = UcDust(s);
+          const real decay = std::exp(-gamma*rhoGas*dt);
+          for(int n = 0 ; n < COMPONENTS ; n++) {
+            const real pEq = Uc[RHO*sv + idx] * UcGas(MX1+n,k,j,i) / rhoGas;
+            Uc[(MX1+n)*sv + idx] = pEq + (Uc[(MX1+n)*sv + idx] - pEq)*decay;
+          }
+        }
+        return;
+      }
+
+      // Index 0 is the gas, index s+1 the dust specie s
+      const int nf = nSpecies+1;
+      real S[nmax][nmax];
+      real Q[nmax][nmax];
+      real sqrtRho[nmax];
+      for(int a = 0 ; a < nf ; a++) {
+        for(int b = 0 ; b < nf ; b++) {
+          S[a][b] = 0;
+        }
+      }
+      sqrtRho[0] = std::sqrt(rhoGas);
+      for(int s = 0 ; s < nSpecies ; s++) {
+        const real gamma = userDef ? gammai(s)[k*gk + j*gj + i]
+                                   : gammaDrag.GetGamma(beta(s),k,j,i);
+        const real rhoDust = UcDust(s)[RHO*sv + idx];
+        sqrtRho[s+1] = std::sqrt(rhoDust);
+        S[0][0] += gamma*rhoDust;
+        S[s+1][s+1] = gamma*rhoGas;
+        S[0][s+1] = -gamma*sqrtRho[0]*sqrtRho[s+1];
+        S[s+1][0] = S[0][s+1];
+      }
+
+      JacobiEigenSolve(S, Q, nf, tol);
+
+      real decay[nmax];
+      for(int m = 0 ; m < nf ; m++) {
+        decay[m] = std::exp(-S[m][m]*dt);
+      }
+
+      [[maybe_unused]] real dEkin = 0;  // Variation of the dust kinetic energy
+      for(int n = 0 ; n < COMPONENTS ; n++) {
+        real u[nmax];
+        real w[nmax];
+        u[0] = UcGas(MX1+n,k,j,i)/sqrtRho[0];
+        for(int s = 0 ; s < nSpecies ; s++) {
+          u[s+1] = sqrtRho[s+1] > 0 ? UcDust(s)[(MX1+n)*sv + idx]/sqrtRho[s+1] : 0;
+        }
+        // Project on the eigenvectors and integrate
+        for(int m = 0 ; m < nf ; m++) {
+          w[m] = 0;
+          for(int a = 0 ; a < nf ; a++) {
+            w[m] += Q[a][m]*u[a];
+          }
+          w[m] *= decay[m];
+        }
+        // Back to the original variables
+        for(int a = 0 ; a < nf ; a++) {
+          real uNew = 0;
+          for(int m = 0 ; m < nf ; m++) {
+            uNew += Q[a][m]*w[m];
+          }
+          if(a == 0) {
+            UcGas(MX1+n,k,j,i) = sqrtRho[0]*uNew;
+          } else {
+            UcDust(a-1)[(MX1+n)*sv + idx] = sqrtRho[a]*uNew;
+            dEkin += 0.5*(uNew*uNew - u[a]*u[a]);
+          }
+        }
+      }
+      #if HAVE_ENERGY == 1
+        // The kinetic energy lost by the dust is given to the gas, so that the total energy
+        // is exactly conserved
+        UcGas(ENG,k,j,i) -= dEkin;
+      #endif
+    });
+  idfx::popRegion();
+}
+
+void MultiSpeciesDrag::ShowConfig() {
+  idfx::cout << "MultiSpeciesDrag: implicit drag of " << nSpecies << " dust species using the ";
+  switch(solver) {
+    case Solver::split:
+      idfx::cout << "split (one pass per specie)";
+      break;
+    case Solver::fused:
+      idfx::cout << "fused 1st order";
+      break;
+    case Solver::exact:
+      idfx::cout << "exact";
+      break;
+  }
+  idfx::cout << " solver." << std::endl;
+}
@@ -7,6 +7,7 @@
 #ifndef FLUID_DRAG_HPP_
 #define FLUID_DRAG_HPP_
 
+#include <array>
 #include <string>
 #include "idefix.hpp"
 #include "input.hpp"
@@ -25,13 +26,22 @@ class GammaDrag {
   void RefreshUserDrag(DataBlock *);
 
   KOKKOS_INLINE_FUNCTION real GetGamma(const int k, const int j, const int i) const {
-    real gamma;  // The drag coefficient
+    if(type == Type::Userdef) {
+      return gammai(k,j,i);
+    }
+    return GetGamma(dragCoeff,k,j,i);
+  }
+
+  // Drag coefficient for a given drag parameter beta (not used by user-defined drag laws)
+  KOKKOS_INLINE_FUNCTION real GetGamma(const real beta,
+                                       const int k, const int j, const int i) const {
+    real gamma{0};  // The drag coefficient
     if(type ==  Type::Gamma) {
-      gamma = dragCoeff;
+      gamma = beta;
 
     } else if(type == Type::Tau) {
       // In this case, the coefficient is the stopping time (assumed constant)
-      gamma = 1/(dragCoeff*VcGas(RHO,k,j,i));
+      gamma = 1/(beta*VcGas(RHO,k,j,i));
     } else if(type == Type::Size) {
       real cs;
       // Assume a fixed size, hence for both Epstein or Stokes, gamma~1/rho_g/cs
@@ -42,9 +52,7 @@ class GammaDrag {
       #else
         cs = eos.GetWaveSpeed(k,j,i);
       #endif
-      gamma = cs/dragCoeff;
-    } else if(type == Type::Userdef) {
-      gamma = gammai(k,j,i);
+      gamma = cs/beta;
     }
     return gamma;
   }
@@ -77,6 +85,7 @@ class Drag {
 
   void EnrollUserDrag(UserDefDragFunc);   // User defined drag function enrollment
   bool IsImplicit() const { return implicit; }  // Check if the drag is implicit
+  bool HasFeedback() const { return feedback; }  // Check if the drag has a feedback on the gas
 
   IdefixArray4D<real> UcDust;  // Dust conservative quantities
   IdefixArray4D<real> UcGas;  // Gas conservative quantities
@@ -95,6 +104,37 @@ class Drag {
 };
 
 
+// Implicit drag of all of the dust species of a DataBlock
+// The gas and dust momenta are updated in a single pass over the grid, the dust arrays
+// being gathered through device arrays of pointers to the data of each specie.
+class MultiSpeciesDrag {
+ public:
+  enum class Solver {split, fused, exact};
+  // Maximum number of species handled by the exact solver (local matrices are on the stack)
+  static constexpr int exactMaxSpecies = 16;
+
+  MultiSpeciesDrag(Input &, DataBlock *);
+  void AddImplicitDrag(const real);     // Apply the implicit drag to all of the fluids
+  void ShowConfig();                    // print configuration
+
+ private:
+  void AddImplicitDragSplit(const real);  // One pass per specie (historical implementation)
+  void AddImplicitDragFused(const real);  // 1st order implicit drag, in a single pass
+  void AddImplicitDragExact(const real);  // Exact integration of the drag, in a single pass
+
+  DataBlock *data;
+  Solver solver{Solver::fused};
+  int nSpecies;
+  bool feedback;
+
+  IdefixArray1D<real*> UcDust;    // Conservative variables of each dust specie
+  IdefixArray1D<real*> VcDust;    // Primitive variables of each dust specie
+  IdefixArray1D<real*> gammai;    // User-defined drag coefficients of each dust specie
+  IdefixArray1D<real> beta;       // Drag parameter of each dust specie
+  std::array<int64_t,3> stride;   // Strides of the dust arrays (variable, k, j)
+  std::array<int64_t,2> strideGamma; // Strides of the user-defined drag arrays (k, j)
+};
+
 #include "fluid.hpp"
 
 template<typename Phys>
@@ -112,6 +112,21 @@ void Fluid<Phys>::EnrollHallDiffusivity(DiffusivityFunc myFunc) {
   this->hallDiffusivityFunc = myFunc;
 }
 
+template<typename Phys>
+void Fluid<Phys>::EnrollDiffusivities(DiffusivitiesFunc myFunc) {
+  if(!haveUserDiffusivities) {
+    IDEFIX_WARNING("Diffusivities enrollment requires at least one parabolic module "
+                 "to be set to userdef in .ini file");
+  }
+  // This function replaces the module functions
+  for(ParabolicModuleStatus *st : {&resistivityStatus, &ambipolarStatus, &hallStatus,
+                                  &viscosityStatus, &thermalDiffusionStatus,
+                                  &bragViscosityStatus, &bragThermalDiffusionStatus}) {
+    if(st->status == UserDefFunction) st->isShared = true;
+  }
+  this->diffusivitiesFunc = myFunc;
+}
+
 template<typename Phys>
 void Fluid<Phys>::ResetStage() {
   // Reset variables required at the beginning of each stage
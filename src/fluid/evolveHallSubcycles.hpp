@@ -0,0 +1,136 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef FLUID_EVOLVEHALLSUBCYCLES_HPP_
+#define FLUID_EVOLVEHALLSUBCYCLES_HPP_
+
+#include <algorithm>
+#include <cmath>
+
+#include "fluid.hpp"
+#include "dataBlock.hpp"
+
+// Evolve the magnetic field by dt under the Hall EMF alone, using as many sub-steps as required
+// by the whistler waves. The hyperbolic stages are then limited by the MHD CFL only. The other
+// variables are frozen: the Hall EMF does no work on the gas (J.E_H=0), so that the pressure
+// is kept. The ghost zones should be up to date when this function is called.
+// The Hall term is dispersive: its eigenvalues lie on the imaginary axis, where forward Euler
+// is unconditionally unstable. Each sub-step is therefore a third-order SSP Runge-Kutta step,
+// which is stable on the imaginary axis up to |omega dt| = sqrt(3) without any added diffusion.
+template<typename Phys>
+void Fluid<Phys>::EvolveHallSubcycles(const real t, const real dt) {
+  if constexpr(Phys::mhd) {
+  #if DIMENSIONS == 3
+    idfx::pushRegion("Fluid::EvolveHallSubcycles");
+
+    // Stability limit of the Runge-Kutta sub-steps: the whistler frequency at the grid scale is
+    // at most 4 times the rate below, so that the scheme is stable up to dt*rate = sqrt(3)/4
+    const real hallCfl = 0.3;
+
+    IdefixArray4D<real> Vc = this->Vc;
+    IdefixArray3D<real> xHallArr = this->xHall;
+    IdefixArray1D<real> dx1 = data->dx[IDIR];
+    IdefixArray1D<real> dx2 = data->dx[JDIR];
+    IdefixArray1D<real> dx3 = data->dx[KDIR];
+    [[maybe_unused]] IdefixArray1D<real> x1 = data->x[IDIR];
+    [[maybe_unused]] IdefixArray1D<real> rt = data->rt;
+    [[maybe_unused]] IdefixArray1D<real> dmu = data->dmu;
+    HydroModuleStatus hall = hallStatus.status;
+    real xHConstant = this->xH;
+
+    // Largest whistler rate |xH| |B| / dl^2
+    real rateMax = ZERO_F;
+    idefix_reduce("HallSubcycleRate",
+      data->beg[KDIR], data->end[KDIR],
+      data->beg[JDIR], data->end[JDIR],
+      data->beg[IDIR], data->end[IDIR],
+      KOKKOS_LAMBDA (int k, int j, int i, real &localMax) {
+        real xH = (hall == UserDefFunction) ? xHallArr(k,j,i) : xHConstant;
+        real Bmag = std::sqrt(Vc(BX1,k,j,i)*Vc(BX1,k,j,i) + Vc(BX2,k,j,i)*Vc(BX2,k,j,i)
+                              + Vc(BX3,k,j,i)*Vc(BX3,k,j,i));
+        real dl1 = dx1(i);
+        real dl2 = dx2(j);
+        real dl3 = dx3(k);
+        #if GEOMETRY == POLAR
+          dl2 = dl2*x1(i);
+        #elif GEOMETRY == SPHERICAL
+          dl2 = dl2*rt(i);
+          dl3 = dl3*rt(i)*dmu(j)/dx2(j);
+        #endif
+        real rate = FABS(xH)*Bmag*(ONE_F/(dl1*dl1) + ONE_F/(dl2*dl2) + ONE_F/(dl3*dl3));
+        localMax = FMAX(localMax, rate);
+      },
+      Kokkos::Max<real>(rateMax));
+    rateMax = idfx::reductions.Reduce(rateMax, idfx::ReductionManager::max);
+
+    const int nSub = std::max(1, static_cast<int>(std::ceil(dt*rateMax/hallCfl)));
+    const real dtSub = dt/nSub;
+
+    IdefixArray3D<real> ex = emf->ex;
+    IdefixArray3D<real> ey = emf->ey;
+    IdefixArray3D<real> ez = emf->ez;
+
+    // Field advanced by the sub-steps
+    #ifdef EVOLVE_VECTOR_POTENTIAL
+      IdefixArray4D<real> B = this->Ve;
+    #else
+      IdefixArray4D<real> B = this->Vs;
+    #endif
+    IdefixArray4D<real> B0 = this->hallB0;
+
+    // Shu-Osher form of the SSP-RK3 step: B <- w0*B0 + (1-w0)*(B + dtSub*L(B)), the stages
+    // being evaluated at t + c*dtSub
+    const real w0[3] = {ZERO_F, 0.75, ONE_F/3.0};
+    const real c[3] = {ZERO_F, ONE_F, HALF_F};
+
+    data->hallCycle = true;
+    for(int s = 0 ; s < nSub ; s++) {
+      Kokkos::deep_copy(B0, B);
+      for(int stage = 0 ; stage < 3 ; stage++) {
+        const real tStage = t + (s + c[stage])*dtSub;
+        // Update the ghost zones with the field of the previous stage
+        if(s>0 || stage>0) boundary->SetBoundaries(tStage);
+
+        CalcCurrent();
+
+        idefix_for("HallResetEMF",0,data->np_tot[KDIR],0,data->np_tot[JDIR],0,data->np_tot[IDIR],
+          KOKKOS_LAMBDA (int k, int j, int i) {
+            ex(k,j,i) = ZERO_F;
+            ey(k,j,i) = ZERO_F;
+            ez(k,j,i) = ZERO_F;
+        });
+
+        emf->CalcNonidealEMF(tStage);
+        emf->EnforceEMFBoundary();
+        #ifdef EVOLVE_VECTOR_POTENTIAL
+          emf->EvolveVectorPotential(dtSub, Ve);
+        #else
+          emf->EvolveMagField(tStage, dtSub, Vs);
+        #endif
+
+        if(stage > 0) {
+          const real w = w0[stage];
+          idefix_for("HallRKCombine",0,B.extent(0),0,B.extent(1),0,B.extent(2),0,B.extent(3),
+            KOKKOS_LAMBDA (int n, int k, int j, int i) {
+              B(n,k,j,i) = w*B0(n,k,j,i) + (ONE_F-w)*B(n,k,j,i);
+          });
+        }
+        #ifdef EVOLVE_VECTOR_POTENTIAL
+          emf->ComputeMagFieldFromA(Ve, Vs);
+        #endif
+        boundary->ReconstructVcField(Vc);
+      }
+    }
+    data->hallCycle = false;
+    hallSubcycles = nSub;
+
+    idfx::popRegion();
+  #endif
+  }
+}
+
+#endif // FLUID_EVOLVEHALLSUBCYCLES_HPP_
@@ -21,13 +21,32 @@ void Fluid<Phys>::LoopDir(const real t, const real dt) {
 
     // If we have tracers, compute the tracer intercell flux
     if(haveTracer) {
-      this->tracer->template CalcFlux<dir, Phys>(this->FluxRiemann);
+      if(nFusedSpecies > 1) {
+        if constexpr(Phys::dust) {
+          // Tracers of the dust species whose fluxes have been computed with ours
+          for(int s = 0 ; s < nFusedSpecies ; s++) {
+            auto fluid = data->dust[instanceNumber+s].get();
+            fluid->tracer->template CalcFlux<dir, Phys>(fluid->FluxRiemann);
+          }
+        }
+      } else {
+        this->tracer->template CalcFlux<dir, Phys>(this->FluxRiemann);
+      }
     }
 
     // Step 3: compute the resulting evolution of the conserved variables, stored in Uc
     CalcRightHandSide<dir>(t,dt);
     if(haveTracer) {
-      this->tracer->template CalcRightHandSide<dir, Phys>(this->FluxRiemann,t ,dt);
+      if(nFusedSpecies > 1) {
+        if constexpr(Phys::dust) {
+          for(int s = 0 ; s < nFusedSpecies ; s++) {
+            auto fluid = data->dust[instanceNumber+s].get();
+            fluid->tracer->template CalcRightHandSide<dir, Phys>(fluid->FluxRiemann, t, dt);
+          }
+        }
+      } else {
+        this->tracer->template CalcRightHandSide<dir, Phys>(this->FluxRiemann,t ,dt);
+      }
     }
 
     // Recursive: do next dimension
@@ -40,29 +59,36 @@ void Fluid<Phys>::LoopDir(const real t, const real dt) {
 template<typename Phys>
 void Fluid<Phys>::EvolveStage(const real t, const real dt) {
   idfx::pushRegion("Fluid::EvolveStage");
+  idfx::ExecSpaceScope execSpaceScope(execSpace);
   // Compute current when needed
   if(needExplicitCurrent) CalcCurrent();
 
-  if(hallStatus.status == UserDefFunction) {
-    if(hallDiffusivityFunc)
-      hallDiffusivityFunc(*data, t, xHall);
-    else
-      IDEFIX_ERROR("No user-defined Hall diffusivity function has been enrolled");
-  }
+  // Fill the user-defined diffusivities of the explicit modules
+  UpdateDiffusivities(t, ExplicitContext);
 
   if constexpr(Phys::eos) {
     eos->Refresh(*data, t);
   }
 
-  // Loop on all of the directions
-  LoopDir<IDIR>(t,dt);
+  // Loop on all of the directions, block by block so that the working set of each block stays
+  // in cache ([Grid] blocksPerRank). Skipped when our fluxes are computed by the kernels of
+  // another dust specie (nFusedSpecies=0)
+  if(nFusedSpecies > 0) {
+    for(int b = 0 ; b < data->nBlocks ; b++) {
+      data->SetActiveBlock(b);
+      LoopDir<IDIR>(t,dt);
+    }
+    data->SetActiveBlock(-1);
+  }
 
   // Step 4: add source terms to the conserved variables (curvature, rotation, etc)
   if(haveSourceTerms) AddSourceTerms(t, dt);
 
   // Step 5: add drag when needed
   if(haveDrag) {
-    if(!drag->IsImplicit()) {
+    // With concurrent fluids, a drag which feeds back on the gas is applied by
+    // DataBlock::EvolveStage once the gas stage is complete
+    if(!drag->IsImplicit() && !(data->haveConcurrentFluids && drag->HasFeedback())) {
       drag->AddDragForce(dt);
     }
   }
@@ -11,6 +11,8 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <utility>
+#include <array>
 
 #include "idefix.hpp"
 #include "grid.hpp"
@@ -60,15 +62,19 @@ class Fluid {
   template <int> void AddNonIdealMHDFlux(const real);
   template <int> void CalcRightHandSide(real, real );
   void CalcCurrent();
+  void UpdateDiffusivities(const real, const DiffusivityContext);
   void AddSourceTerms(real, real );
   void CoarsenFlow(IdefixArray4D<real>&);
   void CoarsenMagField(IdefixArray4D<real>&);
   real CheckDivB();
   void EvolveStage(const real, const real);
+  void EvolveHallSubcycles(const real, const real);
   void ResetStage();
   void ShowConfig();
-  IdefixArray4D<real> GetFlux() {return this->FluxRiemann;}
+  IdefixArray4D<flux_real> GetFlux() {return this->FluxRiemann;}
   int CheckNan();
+  int CountNan();             // Number of nans of this process, without reduction
+  void CountNan(int &, int &);   // Same, for Vc and Vs separately
 
   // Our boundary conditions
   std::unique_ptr<Boundary<Phys>> boundary;
@@ -82,6 +88,12 @@ class Fluid {
   // Parabolic terms
   bool haveExplicitParabolicTerms{false};
   bool haveRKLParabolicTerms{false};
+  bool haveImplicitParabolicTerms{false};
+
+  // User-defined diffusivities, updated every diffusivityUpdatePeriod cycles (0: every stage)
+  bool haveUserDiffusivities{false};
+  int diffusivityUpdatePeriod{0};
+  std::array<int64_t,nDiffusivityContexts> lastDiffusivityUpdate{-1,-1,-1,-1}; ///< per context
 
   std::unique_ptr<RKLegendre<Phys>> rkl;
 
@@ -92,6 +104,8 @@ class Fluid {
 
   // Nonideal MHD effects coefficients
   ParabolicModuleStatus resistivityStatus, ambipolarStatus, hallStatus;
+  int hallSubcycles{0};   ///< number of Hall sub-steps of the last cycle (hall subcycle)
+  IdefixArray4D<real> hallB0;  ///< field (Vs, or Ve) at the beginning of a Hall sub-step
 
   // Whether or not we have viscosity
   ParabolicModuleStatus viscosityStatus;
@@ -159,6 +173,9 @@ class Fluid {
   void EnrollAmbipolarDiffusivity(DiffusivityFunc);
   void EnrollHallDiffusivity(DiffusivityFunc);
 
+  // Enroll a function filling all of the user-defined diffusivities in a single pass
+  void EnrollDiffusivities(DiffusivitiesFunc);
+
   // Enroll user-defined isothermal sound speed
   void EnrollIsoSoundSpeed(IsoSoundSpeedFunc);
 
@@ -182,7 +199,7 @@ class Fluid {
   // Required by time integrator
   IdefixArray3D<real> InvDt;
 
-  IdefixArray4D<real> FluxRiemann;
+  IdefixArray4D<flux_real> FluxRiemann;
   IdefixArray3D<real> dMax;    // Maximum diffusion speed
 
   std::unique_ptr<RiemannSolver<Phys>> rSolver;
@@ -193,6 +210,15 @@ class Fluid {
   std::string prefix;
   int instanceNumber;
 
+  // Number of fluids whose Riemann fluxes and right hand sides are computed by the kernels of
+  // this one: all of the species for the first dust specie of the shared storage (and 0 for the
+  // others) when DataBlock::haveDustFusedKernels, 1 otherwise
+  int nFusedSpecies{1};
+
+  // Execution space instance running the kernels of the stages of this fluid: the default
+  // instance, or a partition of it with concurrent fluids (DataBlock::InitConcurrentFluids)
+  Kokkos::DefaultExecutionSpace execSpace;
+
  private:
   friend class ConstrainedTransport<Phys>;
   friend class Fargo;
@@ -209,10 +235,10 @@ class Fluid {
   template <typename P>
   friend struct Fluid_AddSourceTermsFunctor;
 
-  template <typename P, int dir>
+  template <typename P, int dir, bool haveMeanAdvection>
   friend struct Fluid_CorrectFluxFunctor;
 
-  template <typename P, int dir>
+  template <typename P, int dir, bool haveMeanAdvection>
   friend struct Fluid_CalcRHSFunctor;
 
   template<typename P>
@@ -233,6 +259,7 @@ class Fluid {
   DiffusivityFunc ohmicDiffusivityFunc{NULL};
   DiffusivityFunc ambipolarDiffusivityFunc{NULL};
   DiffusivityFunc hallDiffusivityFunc{NULL};
+  DiffusivitiesFunc diffusivitiesFunc{NULL};
 
   IdefixArray3D<real> cMax;    // Maximum propagation speed
 
@@ -275,7 +302,7 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
   // Keep the instance # for later use
   instanceNumber = n;
 
-  #if ORDER < 1 || ORDER > 4
+  #if ORDER < 1 || ORDER > 5
      IDEFIX_ERROR("Reconstruction at chosen order is not implemented. Check your definitions file");
   #endif
 
@@ -377,6 +404,9 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
     } else if(opType.compare("rkl") == 0 ) {
       haveRKLParabolicTerms = true;
       thermalDiffusionStatus.isRKL = true;
+    } else if(opType.compare("implicit") == 0 ) {
+      haveImplicitParabolicTerms = true;
+      thermalDiffusionStatus.isImplicit = true;
     } else {
       std::stringstream msg;
       msg  << "Unknown integration type for thermal diffusion: " << opType;
@@ -450,6 +480,9 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
           haveRKLParabolicTerms = true;
           resistivityStatus.isRKL = true;
           needRKLCurrent = true;
+        } else if(opType.compare("implicit") == 0 ) {
+          IDEFIX_ERROR("Implicit integration is only available for TDiffusion, "
+                       "use rkl for resistivity");
         } else {
           std::stringstream msg;
           msg  << "Unknown integration type for resistivity: " << opType;
@@ -478,6 +511,9 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
           haveRKLParabolicTerms = true;
           ambipolarStatus.isRKL = true;
           needRKLCurrent = true;
+        } else if(opType.compare("implicit") == 0 ) {
+          IDEFIX_ERROR("Implicit integration is only available for TDiffusion, "
+                       "use rkl for ambipolar");
         } else {
           std::stringstream msg;
           msg  << "Unknown integration type for ambipolar: " << opType;
@@ -501,6 +537,12 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
         if(opType.compare("explicit") == 0 ) {
           hallStatus.isExplicit = true;
           needExplicitCurrent = true;
+        } else if(opType.compare("subcycle") == 0 ) {
+          // The Hall EMF is integrated on its own sub-steps, out of the Riemann solver
+          #if DIMENSIONS < 3
+            IDEFIX_ERROR("Sub-cycled Hall integration requires DIMENSIONS=3");
+          #endif
+          hallStatus.isSubcycled = true;
         } else if(opType.compare("rkl") == 0 ) {
           IDEFIX_ERROR("RKL inegration is incompatible with Hall");
         } else {
@@ -526,21 +568,46 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
   /////////////////////////////////////////
 
   // We now allocate the fields required by the hydro solver
-  Vc = IdefixArray4D<real>(prefix+"_Vc", Phys::nvar+nTracer,
-                           data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-  Uc = IdefixArray4D<real>(prefix+"_Uc", Phys::nvar+nTracer,
-                           data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-
-  data->states["current"].PushArray(Uc, State::center, prefix+"_Uc");
+  if(Phys::dust && data->haveDustSharedStorage) {
+    // All of the dust species live in the same arrays of the DataBlock, this specie being
+    // a contiguous slice of these arrays. The state is then registered by the DataBlock.
+    const int nv = Phys::nvar+nTracer;
+    if(nv != data->dustNvar) {
+      IDEFIX_ERROR("Dust species should all have the same number of variables in shared storage");
+    }
+    auto range = std::make_pair(instanceNumber*nv, (instanceNumber+1)*nv);
+    Vc = Kokkos::subview(data->dustVc, range, Kokkos::ALL(), Kokkos::ALL(), Kokkos::ALL());
+    Uc = Kokkos::subview(data->dustUc, range, Kokkos::ALL(), Kokkos::ALL(), Kokkos::ALL());
+  } else {
+    Vc = IdefixArray4D<real>(prefix+"_Vc", Phys::nvar+nTracer,
+                             data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
+    Uc = IdefixArray4D<real>(prefix+"_Uc", Phys::nvar+nTracer,
+                             data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
+
+    data->states["current"].PushArray(Uc, State::center, prefix+"_Uc");
+  }
 
-  InvDt = IdefixArray3D<real>(prefix+"_InvDt",
-                              data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-  cMax = IdefixArray3D<real>(prefix+"_cMax",
-                              data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
+  if(Phys::dust && data->haveDustSharedStorage) {
+    // So are the fluxes and the signal speeds, which may then be computed for all of the
+    // species at once
+    const int nv = data->dustNvar;
+    auto range = std::make_pair(instanceNumber*nv, (instanceNumber+1)*nv);
+    FluxRiemann = Kokkos::subview(data->dustFlux, range,
+                                  Kokkos::ALL(), Kokkos::ALL(), Kokkos::ALL());
+    InvDt = Kokkos::subview(data->dustInvDt, instanceNumber,
+                            Kokkos::ALL(), Kokkos::ALL(), Kokkos::ALL());
+    cMax = Kokkos::subview(data->dustCMax, instanceNumber,
+                           Kokkos::ALL(), Kokkos::ALL(), Kokkos::ALL());
+  } else {
+    InvDt = IdefixArray3D<real>(prefix+"_InvDt",
+                                data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
+    cMax = IdefixArray3D<real>(prefix+"_cMax",
+                                data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
+    FluxRiemann =  IdefixArray4D<flux_real>(prefix+"_FluxRiemann", Phys::nvar+nTracer,
+                                     data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
+  }
   dMax = IdefixArray3D<real>(prefix+"_dMax",
                               data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-  FluxRiemann =  IdefixArray4D<real>(prefix+"_FluxRiemann", Phys::nvar+nTracer,
-                                     data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
 
   if constexpr(Phys::mhd) {
     Vs = IdefixArray4D<real>(prefix+"_Vs", DIMENSIONS,
@@ -557,6 +624,17 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
     #else // EVOLVE_VECTOR_POTENTIAL
       data->states["current"].PushArray(Vs, State::center, prefix+"_Vs");
     #endif // EVOLVE_VECTOR_POTENTIAL
+
+    if(hallStatus.isSubcycled) {
+      // Runge-Kutta sub-steps of the Hall effect, done after the stages
+      #ifdef EVOLVE_VECTOR_POTENTIAL
+        const int nB = AX3e+1;
+      #else
+        const int nB = DIMENSIONS;
+      #endif
+      data->scratch.Request(hallB0, prefix+"_HallB0", ScratchArena::stagePhase, nB,
+              data->np_tot[KDIR]+KOFFSET, data->np_tot[JDIR]+JOFFSET, data->np_tot[IDIR]+IOFFSET);
+    }
   }
 
   if(this->haveCurrent) {
@@ -741,6 +819,32 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
   }
 
 
+  // Update policy of the user-defined diffusivities
+  haveUserDiffusivities = resistivityStatus.status == UserDefFunction
+                       || ambipolarStatus.status == UserDefFunction
+                       || hallStatus.status == UserDefFunction
+                       || viscosityStatus.status == UserDefFunction
+                       || thermalDiffusionStatus.status == UserDefFunction
+                       || bragViscosityStatus.status == UserDefFunction
+                       || bragThermalDiffusionStatus.status == UserDefFunction;
+  if(input.CheckEntry(std::string(Phys::prefix),"diffusivityUpdate")>=0) {
+    std::string policy = input.Get<std::string>(std::string(Phys::prefix),"diffusivityUpdate",0);
+    if(policy.compare("stage") == 0) {
+      diffusivityUpdatePeriod = 0;
+    } else if(policy.compare("cycle") == 0) {
+      diffusivityUpdatePeriod = input.GetOrSet<int>(std::string(Phys::prefix),
+                                                    "diffusivityUpdate",1,1);
+      if(diffusivityUpdatePeriod < 1) {
+        IDEFIX_ERROR("The period of diffusivityUpdate should be at least one cycle");
+      }
+    } else {
+      std::stringstream msg;
+      msg  << "Unknown diffusivity update policy: " << policy
+           << ". Can only be stage or cycle.";
+      IDEFIX_ERROR(msg);
+    }
+  }
+
   // Drag force when needed
   if(haveDrag) {
     this->drag = std::make_unique<Drag>(input, this);
@@ -759,9 +863,11 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
 #include "calcRightHandSide.hpp"
 #include "enroll.hpp"
 #include "calcCurrent.hpp"
+#include "updateDiffusivities.hpp"
 #include "coarsenFlow.hpp"
 #include "convertConsToPrim.hpp"
 #include "checkDivB.hpp"
 #include "evolveStage.hpp"
+#include "evolveHallSubcycles.hpp"
 #include "showConfig.hpp"
 #endif // FLUID_FLUID_HPP_
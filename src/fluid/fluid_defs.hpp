@@ -33,8 +33,16 @@ struct ParabolicModuleStatus {
   HydroModuleStatus status{Disabled};
   bool isExplicit{false};
   bool isRKL{false};
+  bool isImplicit{false};
+  bool isSubcycled{false}; ///< integrated on its own sub-steps at the end of the cycle (Hall)
+  bool isShared{false};   ///< user-defined coefficients filled by the fluid diffusivities function
 };
 
+// Steps of the integration in which the user-defined diffusivities are updated, each of them
+// with its own update policy
+enum DiffusivityContext {ExplicitContext, RKLContext, ImplicitContext, HallContext,
+                         nDiffusivityContexts};
+
 
 using GravPotentialFunc = void (*) (DataBlock &, const real t, IdefixArray1D<real>&,
                                     IdefixArray1D<real>&, IdefixArray1D<real>&,
@@ -54,6 +62,21 @@ using DiffusivityFunc = void (*) (DataBlock &, const real t, IdefixArray3D<real>
 using BragDiffusivityFunc = void (*) (DataBlock &, const real,
                       std::vector<IdefixArray3D<real>> &);
 
+// Coefficient arrays of the user-defined parabolic modules, filled in a single pass by a
+// DiffusivitiesFunc. The arrays which should not be updated are left unallocated.
+struct DiffusivityArrays {
+  IdefixArray3D<real> etaOhmic;       ///< Ohmic diffusivity
+  IdefixArray3D<real> xAmbipolar;     ///< Ambipolar diffusivity
+  IdefixArray3D<real> xHall;          ///< Hall diffusivity
+  IdefixArray3D<real> eta1, eta2;     ///< Viscosities
+  IdefixArray3D<real> kappa;          ///< Thermal diffusivity
+  IdefixArray3D<real> etaBrag;        ///< Braginskii viscosity
+  IdefixArray3D<real> kpar, knor;     ///< Braginskii parallel and normal thermal diffusivities
+  IdefixArray3D<real> clessAlpha, clessBeta; ///< Braginskii collisionless saturation
+};
+
+using DiffusivitiesFunc = void (*) (DataBlock &, const real, DiffusivityArrays &);
+
 // Deprecated signatures
 using SrcTermFuncOld = void (*) (DataBlock &, const real t, const real dt);
 
@@ -0,0 +1,293 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <string>
+#include <vector>
+
+#include "implicitDiffusion.hpp"
+#include "dataBlock.hpp"
+#include "bicgstab.hpp"
+#include "cg.hpp"
+#include "minres.hpp"
+#include "reductionManager.hpp"
+
+ImplicitDiffusion::ImplicitDiffusion(Input &input, DataBlock *datain, const std::string &block):
+                                     data(datain) {
+  idfx::pushRegion("ImplicitDiffusion::ImplicitDiffusion");
+
+  const std::string strSolver = input.GetOrSet<std::string>(block,"implicitSolver",0,"PBICGSTAB");
+  if(strSolver.compare("BICGSTAB")==0) {
+    solver = BICGSTAB;
+  } else if(strSolver.compare("PBICGSTAB")==0) {
+    solver = PBICGSTAB;
+  } else if(strSolver.compare("CG")==0) {
+    solver = CG;
+  } else if(strSolver.compare("PCG")==0) {
+    solver = PCG;
+  } else if(strSolver.compare("MINRES")==0) {
+    solver = MINRES;
+  } else if(strSolver.compare("PMINRES")==0) {
+    solver = PMINRES;
+  } else {
+    std::stringstream msg;
+    msg << "ImplicitDiffusion: Unknown solver \"" << strSolver << "\"."
+        << " Use BICGSTAB, PBICGSTAB, CG, PCG, MINRES or PMINRES.";
+    IDEFIX_ERROR(msg);
+  }
+  havePreconditioner = (solver == PBICGSTAB || solver == PCG || solver == PMINRES);
+
+  const real targetError = input.GetOrSet<real>(block,"implicitTargetError",0,1e-8);
+  const int maxIter = input.GetOrSet<int>(block,"implicitMaxIter",0,1000);
+  theta = input.GetOrSet<real>(block,"implicitTheta",0,1.0);
+  if(theta < 0.5 || theta > 1.0) {
+    IDEFIX_ERROR("implicitTheta should be between 0.5 (Crank-Nicolson) and 1 (backward Euler)");
+  }
+
+  // Arrays of the linear system
+  std::array<int,3> ntot = data->np_tot;
+  mass = IdefixArray3D<real>("ImplicitMass", ntot[KDIR], ntot[JDIR], ntot[IDIR]);
+  rhs = IdefixArray3D<real>("ImplicitRhs", ntot[KDIR], ntot[JDIR], ntot[IDIR]);
+  solution = IdefixArray3D<real>("ImplicitSolution", ntot[KDIR], ntot[JDIR], ntot[IDIR]);
+  diag = IdefixArray3D<real>("ImplicitDiagonal", ntot[KDIR], ntot[JDIR], ntot[IDIR]);
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    cond[dir] = IdefixArray3D<real>("ImplicitConductance", ntot[KDIR]+KOFFSET,
+                                                          ntot[JDIR]+JOFFSET,
+                                                          ntot[IDIR]+IOFFSET);
+  }
+
+  if(solver == BICGSTAB || solver == PBICGSTAB) {
+    iterativeSolver = new Bicgstab<ImplicitDiffusion>(*this, targetError, maxIter,
+                                                      data->np_tot, data->beg, data->end);
+  } else if(solver == CG || solver == PCG) {
+    iterativeSolver = new Cg<ImplicitDiffusion>(*this, targetError, maxIter,
+                                                data->np_tot, data->beg, data->end);
+  } else {
+    iterativeSolver = new Minres<ImplicitDiffusion>(*this, targetError, maxIter,
+                                                    data->np_tot, data->beg, data->end);
+  }
+
+  // The ghost zones of the increment are only filled for the boundaries handled by
+  // SetBoundaries
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    for(int side = 0 ; side < 2 ; side++) {
+      const BoundaryType type = (side == 0) ? data->lbound[dir] : data->rbound[dir];
+      if(type == shearingbox || type == userdef || type == undefined) {
+        std::stringstream msg;
+        msg << "ImplicitDiffusion: the " << (side == 0 ? "left" : "right")
+            << " boundary along X" << dir+1 << " is of a type not supported by the implicit"
+            << " solver. Use periodic, outflow, reflective or axis boundaries, or an explicit"
+            << " or rkl integration.";
+        IDEFIX_ERROR(msg);
+      }
+    }
+  }
+
+  #ifdef WITH_MPI
+  std::vector<int> mapVars;
+  mapVars.push_back(0);
+  this->mpi.Init(data->mygrid, mapVars, data->nghost, data->np_int,
+                 data->lbound, data->rbound, false);
+  #endif
+
+  idfx::popRegion();
+}
+
+ImplicitDiffusion::~ImplicitDiffusion() {
+  delete iterativeSolver;
+}
+
+void ImplicitDiffusion::ShowConfig() {
+  idfx::cout << "ImplicitDiffusion: using ";
+  switch(solver) {
+    case BICGSTAB:
+      idfx::cout << "unpreconditionned BICGSTAB";
+      break;
+    case PBICGSTAB:
+      idfx::cout << "preconditionned BICGSTAB";
+      break;
+    case CG:
+      idfx::cout << "unpreconditionned CG";
+      break;
+    case PCG:
+      idfx::cout << "preconditionned CG";
+      break;
+    case MINRES:
+      idfx::cout << "unpreconditionned MinRes";
+      break;
+    case PMINRES:
+      idfx::cout << "preconditionned MinRes";
+      break;
+  }
+  idfx::cout << " solver with theta=" << theta;
+  if(theta == 1.0) idfx::cout << " (backward Euler)";
+  if(theta == 0.5) idfx::cout << " (Crank-Nicolson)";
+  idfx::cout << "." << std::endl;
+  iterativeSolver->ShowConfig();
+}
+
+int ImplicitDiffusion::Solve(const real dtin) {
+  idfx::pushRegion("ImplicitDiffusion::Solve");
+  // Only the fraction theta of the diffusion is evaluated at the end of the step
+  this->dt = theta*dtin;
+
+  IdefixArray3D<real> mass = this->mass;
+  IdefixArray3D<real> rhs = this->rhs;
+  IdefixArray3D<real> solution = this->solution;
+  IdefixArray3D<real> diag = this->diag;
+  IdefixArray3D<real> c1 = this->cond[IDIR];
+  IdefixArray3D<real> c2 = this->cond[JDIR];
+  IdefixArray3D<real> c3 = this->cond[KDIR];
+  const bool havePreconditioner = this->havePreconditioner;
+  const real dt = this->dt;
+
+  // Diagonal of the operator, initial guess (no increment) and preconditioned rhs
+  real rhsNorm;
+  idefix_reduce("ImplicitDiffusionInit",
+                data->beg[KDIR], data->end[KDIR],
+                data->beg[JDIR], data->end[JDIR],
+                data->beg[IDIR], data->end[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i, real &localSum) {
+      real d = c1(k,j,i) + c1(k,j,i+1);
+      #if DIMENSIONS > 1
+      d += c2(k,j,i) + c2(k,j+1,i);
+      #endif
+      #if DIMENSIONS > 2
+      d += c3(k,j,i) + c3(k+1,j,i);
+      #endif
+      d = mass(k,j,i) + dt*d;
+      diag(k,j,i) = d;
+      solution(k,j,i) = ZERO_F;
+      localSum += rhs(k,j,i)*rhs(k,j,i);
+      if(havePreconditioner) rhs(k,j,i) /= d;
+    }, Kokkos::Sum<real>(rhsNorm));
+  rhsNorm = idfx::reductions.Reduce(rhsNorm, idfx::ReductionManager::sum);
+
+  // Nothing to diffuse: the relative error of the solver would be undefined
+  if(rhsNorm == ZERO_F) {
+    lastIterations = 0;
+    lastError = 0;
+    idfx::popRegion();
+    return(0);
+  }
+
+  SetBoundaries(solution);
+  lastIterations = iterativeSolver->Solve(solution, rhs);
+  if(lastIterations < 0) {
+    IDEFIX_ERROR("ImplicitDiffusion: the iterative solver broke down");
+  }
+  lastError = iterativeSolver->GetError();
+
+  idfx::popRegion();
+  return(lastIterations);
+}
+
+void ImplicitDiffusion::operator()(IdefixArray3D<real> in, IdefixArray3D<real> out) {
+  idfx::pushRegion("ImplicitDiffusion::Operator");
+  IdefixArray3D<real> mass = this->mass;
+  IdefixArray3D<real> diag = this->diag;
+  IdefixArray3D<real> c1 = this->cond[IDIR];
+  IdefixArray3D<real> c2 = this->cond[JDIR];
+  IdefixArray3D<real> c3 = this->cond[KDIR];
+  const bool havePreconditioner = this->havePreconditioner;
+  const real dt = this->dt;
+
+  SetBoundaries(in);
+
+  idefix_for("ImplicitDiffusionOperator",
+             data->beg[KDIR], data->end[KDIR],
+             data->beg[JDIR], data->end[JDIR],
+             data->beg[IDIR], data->end[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      const real x = in(k,j,i);
+      real flux = c1(k,j,i)*(x - in(k,j,i-1)) + c1(k,j,i+1)*(x - in(k,j,i+1));
+      #if DIMENSIONS > 1
+      flux += c2(k,j,i)*(x - in(k,j-1,i)) + c2(k,j+1,i)*(x - in(k,j+1,i));
+      #endif
+      #if DIMENSIONS > 2
+      flux += c3(k,j,i)*(x - in(k-1,j,i)) + c3(k+1,j,i)*(x - in(k+1,j,i));
+      #endif
+      real result = mass(k,j,i)*x + dt*flux;
+      if(havePreconditioner) result /= diag(k,j,i);
+      out(k,j,i) = result;
+    });
+
+  idfx::popRegion();
+}
+
+void ImplicitDiffusion::SetBoundaries(IdefixArray3D<real> &arr) {
+  idfx::pushRegion("ImplicitDiffusion::SetBoundaries");
+  IdefixArray3D<real> localVar = arr;
+
+  #ifdef WITH_MPI
+  this->arr4D = IdefixArray4D<real> (arr.data(), 1, data->np_tot[KDIR],
+                                                    data->np_tot[JDIR],
+                                                    data->np_tot[IDIR]);
+  #endif
+
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    #ifdef WITH_MPI
+    if(data->mygrid->nproc[dir]>1) {
+      switch(dir) {
+        case 0:
+          this->mpi.ExchangeX1(this->arr4D);
+          break;
+        case 1:
+          this->mpi.ExchangeX2(this->arr4D);
+          break;
+        case 2:
+          this->mpi.ExchangeX3(this->arr4D);
+          break;
+      }
+    }
+    #endif
+
+    const int nxi = data->np_int[IDIR];
+    const int nxj = data->np_int[JDIR];
+    const int nxk = data->np_int[KDIR];
+    const int ighost = data->nghost[IDIR];
+    const int jghost = data->nghost[JDIR];
+    const int kghost = data->nghost[KDIR];
+
+    for(int side = 0 ; side < 2 ; side++) {
+      const BoundaryType type = (side == 0) ? data->lbound[dir] : data->rbound[dir];
+      // Filled by the MPI exchange
+      if(type == internal) continue;
+      if(type == periodic && data->mygrid->nproc[dir] > 1) continue;
+
+      const int ibeg = (dir == IDIR) ? side*(ighost+nxi) : 0;
+      const int iend = (dir == IDIR) ? ighost + side*(ighost+nxi) : data->np_tot[IDIR];
+      const int jbeg = (dir == JDIR) ? side*(jghost+nxj) : 0;
+      const int jend = (dir == JDIR) ? jghost + side*(jghost+nxj) : data->np_tot[JDIR];
+      const int kbeg = (dir == KDIR) ? side*(kghost+nxk) : 0;
+      const int kend = (dir == KDIR) ? kghost + side*(kghost+nxk) : data->np_tot[KDIR];
+
+      if(type == periodic) {
+        idefix_for("ImplicitBoundaryPeriodic", kbeg, kend, jbeg, jend, ibeg, iend,
+          KOKKOS_LAMBDA (int k, int j, int i) {
+            const int iref = (dir==IDIR) ? ighost + (i+ighost*(nxi-1))%nxi : i;
+            const int jref = (dir==JDIR) ? jghost + (j+jghost*(nxj-1))%nxj : j;
+            const int kref = (dir==KDIR) ? kghost + (k+kghost*(nxk-1))%nxk : k;
+            localVar(k,j,i) = localVar(kref,jref,iref);
+          });
+      } else {
+        // outflow, reflective and axis: zero gradient of the increment, hence no diffusive
+        // flux through the boundary (on the axis, the area of the interface vanishes anyway)
+        const int iref = (side == 0) ? ighost : ighost+nxi-1;
+        const int jref = (side == 0) ? jghost : jghost+nxj-1;
+        const int kref = (side == 0) ? kghost : kghost+nxk-1;
+        idefix_for("ImplicitBoundaryZeroGradient", kbeg, kend, jbeg, jend, ibeg, iend,
+          KOKKOS_LAMBDA (int k, int j, int i) {
+            localVar(k,j,i) = localVar((dir==KDIR) ? kref : k,
+                                       (dir==JDIR) ? jref : j,
+                                       (dir==IDIR) ? iref : i);
+          });
+      }
+    }
+  }
+
+  idfx::popRegion();
+}
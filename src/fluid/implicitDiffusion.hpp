@@ -0,0 +1,69 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef FLUID_IMPLICITDIFFUSION_HPP_
+#define FLUID_IMPLICITDIFFUSION_HPP_
+
+#include <string>
+#include "idefix.hpp"
+#include "input.hpp"
+#include "iterativesolver.hpp"
+#ifdef WITH_MPI
+#include "mpi.hpp"
+#endif
+
+class DataBlock;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+/// Implicit (theta-scheme) step of a scalar diffusion equation, solved with the iterative
+/// solvers of idefix (matrix-free). The unknown x is the increment of the diffused quantity over
+/// the step:
+///   mass*x + theta*dt*sum_faces cond*(x - x_neighbour) = rhs
+/// where mass is the (cell-integrated) heat capacity and cond the conductance of each interface
+/// (area*diffusivity/length). The increment has a zero gradient across the outflow, reflective
+/// and axis boundaries (no diffusive flux through them). Shearing-box and user-defined boundaries
+/// are not supported.
+//////////////////////////////////////////////////////////////////////////////////////////////////
+class ImplicitDiffusion {
+ public:
+  enum SolverType {BICGSTAB, PBICGSTAB, CG, PCG, MINRES, PMINRES};
+
+  ImplicitDiffusion(Input &, DataBlock *, const std::string &);
+  ~ImplicitDiffusion();
+
+  int Solve(const real dt);     ///< Solve for the increment, returns the number of iterations
+  void ShowConfig();
+
+  // The operator of the linear system, divided by its diagonal when preconditioned
+  void operator() (IdefixArray3D<real> in, IdefixArray3D<real> out);
+  void SetBoundaries(IdefixArray3D<real> &);  ///< Fill the ghost zones of an increment
+
+  IdefixArray3D<real> mass;                 ///< diagonal (mass) term of each cell
+  std::array<IdefixArray3D<real>,3> cond;   ///< conductance of the left interface of each cell
+  IdefixArray3D<real> rhs;                  ///< right hand side (filled by the caller)
+  IdefixArray3D<real> solution;             ///< increment over the step
+
+  int lastIterations{0};  ///< number of iterations of the last solve
+  real lastError{0};      ///< error of the last solve
+
+ private:
+  DataBlock *data;
+  SolverType solver;
+  bool havePreconditioner{false};
+  IterativeSolver<ImplicitDiffusion> *iterativeSolver;
+
+  real theta{1};              ///< implicit fraction (1: backward Euler, 0.5: Crank-Nicolson)
+  real dt{0};                 ///< step of the current solve, times theta
+  IdefixArray3D<real> diag;   ///< diagonal of the operator (preconditioner)
+
+  #ifdef WITH_MPI
+  Mpi mpi;
+  IdefixArray4D<real> arr4D;  ///< 4D view of the exchanged array
+  #endif
+};
+
+#endif // FLUID_IMPLICITDIFFUSION_HPP_
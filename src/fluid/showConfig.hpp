@@ -39,6 +39,12 @@ void Fluid<Phys>::ShowConfig() {
     idfx::cout << "3rd order (LimO3)" << std::endl;
   #elif ORDER == 4
     idfx::cout << "4th order (PPM)" << std::endl;
+  #elif ORDER == 5
+    #ifdef RECONSTRUCTION_MP5
+      idfx::cout << "5th order (MP5)" << std::endl;
+    #else
+      idfx::cout << "5th order (WENO5-Z)" << std::endl;
+    #endif
   #endif
 
 
@@ -59,7 +65,7 @@ void Fluid<Phys>::ShowConfig() {
       idfx::cout << Phys::prefix
                  << ": Ohmic resistivity ENABLED with user-defined resistivity function."
                  << std::endl;
-      if(!ohmicDiffusivityFunc) {
+      if(!ohmicDiffusivityFunc && !diffusivitiesFunc) {
         IDEFIX_ERROR("No user-defined Ihmic resistivity function has been enrolled.");
       }
     } else {
@@ -85,7 +91,7 @@ void Fluid<Phys>::ShowConfig() {
       idfx::cout << Phys::prefix
                  << ": Ambipolar diffusion ENABLED with user-defined diffusivity function."
                  << std::endl;
-      if(!ambipolarDiffusivityFunc) {
+      if(!ambipolarDiffusivityFunc && !diffusivitiesFunc) {
         IDEFIX_ERROR("No user-defined ambipolar diffusion function has been enrolled.");
       }
     } else {
@@ -110,7 +116,7 @@ void Fluid<Phys>::ShowConfig() {
     } else if(hallStatus.status == UserDefFunction) {
       idfx::cout << Phys::prefix << ": Hall effect ENABLED with user-defined diffusivity function."
                  << std::endl;
-      if(!hallDiffusivityFunc) {
+      if(!hallDiffusivityFunc && !diffusivitiesFunc) {
         IDEFIX_ERROR("No user-defined Hall diffusivity function has been enrolled.");
       }
     } else {
@@ -118,6 +124,9 @@ void Fluid<Phys>::ShowConfig() {
     }
     if(hallStatus.isExplicit) {
       idfx::cout << Phys::prefix << ": Hall effect uses an explicit time integration." << std::endl;
+    } else if(hallStatus.isSubcycled) {
+      idfx::cout << Phys::prefix << ": Hall effect uses explicit sub-cycles at the end of each "
+                 << "cycle." << std::endl;
     }  else {
       IDEFIX_ERROR("Unknown time integrator for Hall effect");
     }
@@ -158,6 +167,15 @@ void Fluid<Phys>::ShowConfig() {
   if(bragThermalDiffusionStatus.status != Disabled) {
     bragThermalDiffusion->ShowConfig();
   }
+  if(haveUserDiffusivities) {
+    idfx::cout << Phys::prefix << ": user-defined diffusivities ";
+    if(diffusivitiesFunc) idfx::cout << "filled by a single function and ";
+    if(diffusivityUpdatePeriod == 0) {
+      idfx::cout << "updated every stage." << std::endl;
+    } else {
+      idfx::cout << "updated every " << diffusivityUpdatePeriod << " cycle(s)." << std::endl;
+    }
+  }
   if(haveAxis) {
     boundary->axis->ShowConfig();
   }
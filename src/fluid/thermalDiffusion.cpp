@@ -23,7 +23,7 @@ void ThermalDiffusion::ShowConfig() {
   } else if (status.status==UserDefFunction) {
     idfx::cout << "Thermal Diffusion: ENABLED with user-defined diffusivity function."
                    << std::endl;
-    if(!diffusivityFunc) {
+    if(!diffusivityFunc && !status.isShared) {
       IDEFIX_ERROR("No thermal diffusion function has been enrolled");
     }
   } else {
@@ -34,6 +34,10 @@ void ThermalDiffusion::ShowConfig() {
   } else if(status.isRKL) {
     idfx::cout << "Thermal Diffusion: uses a Runge-Kutta-Legendre time integration."
                 << std::endl;
+  } else if(status.isImplicit) {
+    idfx::cout << "Thermal Diffusion: uses an implicit time integration."
+                << std::endl;
+    implicitDiffusion->ShowConfig();
   } else {
     IDEFIX_ERROR("Unknown time integrator for viscosity.");
   }
@@ -47,11 +51,22 @@ void ThermalDiffusion::EnrollThermalDiffusivity(DiffusivityFunc myFunc) {
   this->diffusivityFunc = myFunc;
 }
 
+void ThermalDiffusion::UpdateDiffusivity(const real t) {
+  if(diffusivityFunc) {
+    idfx::pushRegion("UserDef::ThermalDiffusivityFunction");
+    diffusivityFunc(*this->data, t, kappaArr);
+    idfx::popRegion();
+  } else {
+    IDEFIX_ERROR("No user-defined thermal diffusion function has been enrolled");
+  }
+}
+
 // This function computes the viscous flux and stores it in hydro->fluxRiemann
 // (this avoids an extra array)
 // Associated source terms, present in non-cartesian geometry are also computed
 // and stored in this->viscSrc for later use (in calcRhs).
-void ThermalDiffusion::AddDiffusiveFlux(int dir, const real t, const IdefixArray4D<real> &Flux) {
+void ThermalDiffusion::AddDiffusiveFlux(int dir, const real t,
+                                        const IdefixArray4D<flux_real> &Flux) {
   idfx::pushRegion("ThermalDiffusion::AddDiffusiveFlux");
   IdefixArray4D<real> Vc = this->Vc;
   IdefixArray3D<real> dMax = this->dMax;
@@ -70,16 +85,7 @@ void ThermalDiffusion::AddDiffusiveFlux(int dir, const real t, const IdefixArray
 
   HydroModuleStatus haveThermalDiffusion = this->status.status;
 
-  // Compute thermal diffusion if needed
-  if(haveThermalDiffusion == UserDefFunction && dir == IDIR) {
-    if(diffusivityFunc) {
-      idfx::pushRegion("UserDef::ThermalDiffusivityFunction");
-      diffusivityFunc(*this->data, t, kappaArr);
-      idfx::popRegion();
-    } else {
-      IDEFIX_ERROR("No user-defined thermal diffusion function has been enrolled");
-    }
-  }
+  // User-defined diffusivities are filled by Fluid::UpdateDiffusivities
 
 
   int ibeg, iend, jbeg, jend, kbeg, kend;
@@ -147,3 +153,112 @@ void ThermalDiffusion::AddDiffusiveFlux(int dir, const real t, const IdefixArray
       });
   idfx::popRegion();
 }
+
+// Implicit step of the thermal diffusion over dt, operator split from the hydro step.
+// The temperature increment dT solves
+//   dV*rho/(gamma-1)*dT - theta*dt*div(kappa grad dT)*dV = dt*div(kappa grad T)*dV
+// with the density frozen, and is added to the pressure.
+void ThermalDiffusion::AddImplicitDiffusion(const real t, const real dt) {
+  idfx::pushRegion("ThermalDiffusion::AddImplicitDiffusion");
+  IdefixArray4D<real> Vc = this->Vc;
+  IdefixArray3D<real> kappaArr = this->kappaArr;
+  IdefixArray3D<real> dV = this->data->dV;
+  IdefixArray3D<real> mass = implicitDiffusion->mass;
+  IdefixArray3D<real> rhs = implicitDiffusion->rhs;
+  IdefixArray3D<real> dT = implicitDiffusion->solution;
+
+  EquationOfState eos = *(this->eos);
+  #if GEOMETRY == POLAR
+    IdefixArray1D<real> x1 = this->data->x[IDIR];
+  #endif
+  #if GEOMETRY == SPHERICAL
+    IdefixArray1D<real> rt   = this->data->rt;
+    IdefixArray1D<real> dmu  = this->data->dmu;
+    IdefixArray1D<real> dx2 = this->data->dx[JDIR];
+  #endif
+
+  HydroModuleStatus haveThermalDiffusion = this->status.status;
+  real kappaConstant = this->kappa;
+
+  // User-defined diffusivities are filled by Fluid::UpdateDiffusivities
+
+  // Conductance of each interface
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    IdefixArray3D<real> cond = implicitDiffusion->cond[dir];
+    IdefixArray3D<real> A = this->data->A[dir];
+    IdefixArray1D<real> dx = this->data->dx[dir];
+
+    const int ioffset = (dir==IDIR) ? 1 : 0;
+    const int joffset = (dir==JDIR) ? 1 : 0;
+    const int koffset = (dir==KDIR) ? 1 : 0;
+
+    idefix_for("ThermalDiffusionConductance",
+               data->beg[KDIR], data->end[KDIR]+koffset,
+               data->beg[JDIR], data->end[JDIR]+joffset,
+               data->beg[IDIR], data->end[IDIR]+ioffset,
+      KOKKOS_LAMBDA (int k, int j, int i) {
+        // index along dir
+        const int ig = ioffset*i + joffset*j + koffset*k;
+
+        // dx at the interface is the averaged between the two adjacent centered dx
+        real dl = HALF_F*(dx(ig-1) + dx(ig));
+        #if GEOMETRY == POLAR
+        if(dir==JDIR)
+          dl = dl*x1(i);
+
+        #elif GEOMETRY == SPHERICAL
+          if(dir==JDIR)
+            dl = dl*rt(i);
+          else
+            if(dir==KDIR)
+              dl = dl*rt(i)*dmu(j)/dx2(j);
+        #endif // GEOMETRY
+
+        real kappa;
+        if(haveThermalDiffusion == UserDefFunction) {
+          kappa = HALF_F*(kappaArr(k,j,i) +  kappaArr(k-koffset,j-joffset,i-ioffset));
+        } else {
+          kappa = kappaConstant;
+        }
+        cond(k,j,i) = kappa*A(k,j,i)/dl;
+      });
+  }
+
+  // Heat capacity and explicit diffusion of the current temperature
+  IdefixArray3D<real> c1 = implicitDiffusion->cond[IDIR];
+  IdefixArray3D<real> c2 = implicitDiffusion->cond[JDIR];
+  IdefixArray3D<real> c3 = implicitDiffusion->cond[KDIR];
+  idefix_for("ThermalDiffusionImplicitRhs",
+             data->beg[KDIR], data->end[KDIR],
+             data->beg[JDIR], data->end[JDIR],
+             data->beg[IDIR], data->end[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      const real T = Vc(PRS,k,j,i)/Vc(RHO,k,j,i);
+      real flux = c1(k,j,i)*(Vc(PRS,k,j,i-1)/Vc(RHO,k,j,i-1) - T)
+                + c1(k,j,i+1)*(Vc(PRS,k,j,i+1)/Vc(RHO,k,j,i+1) - T);
+      #if DIMENSIONS > 1
+      flux += c2(k,j,i)*(Vc(PRS,k,j-1,i)/Vc(RHO,k,j-1,i) - T)
+            + c2(k,j+1,i)*(Vc(PRS,k,j+1,i)/Vc(RHO,k,j+1,i) - T);
+      #endif
+      #if DIMENSIONS > 2
+      flux += c3(k,j,i)*(Vc(PRS,k-1,j,i)/Vc(RHO,k-1,j,i) - T)
+            + c3(k+1,j,i)*(Vc(PRS,k+1,j,i)/Vc(RHO,k+1,j,i) - T);
+      #endif
+      const real gamma = eos.GetGamma(Vc(PRS,k,j,i),Vc(RHO,k,j,i));
+      mass(k,j,i) = dV(k,j,i)*Vc(RHO,k,j,i)/(gamma-ONE_F);
+      rhs(k,j,i) = dt*flux;
+    });
+
+  implicitDiffusion->Solve(dt);
+
+  // P = rho*T
+  idefix_for("ThermalDiffusionImplicitUpdate",
+             data->beg[KDIR], data->end[KDIR],
+             data->beg[JDIR], data->end[JDIR],
+             data->beg[IDIR], data->end[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      Vc(PRS,k,j,i) += Vc(RHO,k,j,i)*dT(k,j,i);
+    });
+
+  idfx::popRegion();
+}
@@ -8,6 +8,7 @@
 #ifndef FLUID_THERMALDIFFUSION_HPP_
 #define FLUID_THERMALDIFFUSION_HPP_
 
+#include <memory>
 #include <string>
 
 #include "idefix.hpp"
@@ -15,6 +16,7 @@
 #include "grid.hpp"
 #include "fluid_defs.hpp"
 #include "eos.hpp"
+#include "implicitDiffusion.hpp"
 
 
 // Forward class hydro declaration
@@ -29,14 +31,19 @@ class ThermalDiffusion {
 
   void ShowConfig(); // display configuration
 
-  void AddDiffusiveFlux(int, const real, const IdefixArray4D<real> &);
+  void AddDiffusiveFlux(int, const real, const IdefixArray4D<flux_real> &);
+  void AddImplicitDiffusion(const real, const real);  // Implicit step of the diffusion
 
   // Enroll user-defined viscous diffusivity
   void EnrollThermalDiffusivity(DiffusivityFunc);
+  void UpdateDiffusivity(const real);   // fill the user-defined diffusivity
 
   IdefixArray4D<real> viscSrc;  // Source terms of the viscous operator
   IdefixArray3D<real> kappaArr;
 
+  // Linear system of the implicit time integration (when needed)
+  std::unique_ptr<ImplicitDiffusion> implicitDiffusion;
+
   // pre-computed geometrical factors in non-cartesian geometry
   IdefixArray1D<real> one_dmu;
 
@@ -87,6 +94,11 @@ ThermalDiffusion::ThermalDiffusion(Input &input, Grid &grid, Fluid<Phys> *hydroi
     IDEFIX_ERROR("Thermal diffusion is not compatible with the ISOTHERMAL approximation");
   #endif
 
+  if(status.isImplicit) {
+    this->implicitDiffusion = std::make_unique<ImplicitDiffusion>(input, data,
+                                                                  std::string(Phys::prefix));
+  }
+
   idfx::popRegion();
 }
 
@@ -22,8 +22,8 @@ class Tracer {
   template <typename Phys> Tracer(Fluid<Phys> *, int n);
   void ConvertConsToPrim();
   void ConvertPrimToCons();
-  template <int, typename> void CalcFlux(IdefixArray4D<real> &);
-  template <int, typename> void CalcRightHandSide(IdefixArray4D<real> &, real, real);
+  template <int, typename> void CalcFlux(IdefixArray4D<flux_real> &);
+  template <int, typename> void CalcRightHandSide(IdefixArray4D<flux_real> &, real, real);
 
  private:
   IdefixArray4D<real> Vc;  // Vector of primitive variables for the passive tracer
@@ -55,7 +55,7 @@ Tracer::Tracer(Fluid<Phys> *fluid, int n) {
 
 // Compute the upwinded flux
 template <int dir, typename Phys>
-void Tracer::CalcFlux(IdefixArray4D<real> &Flux) {
+void Tracer::CalcFlux(IdefixArray4D<flux_real> &Flux) {
   idfx::pushRegion("Tracer::CalcFlux");
 
   IdefixArray4D<real> Vc = this->Vc;
@@ -100,7 +100,7 @@ void Tracer::CalcFlux(IdefixArray4D<real> &Flux) {
 }
 
 template <int dir, typename Phys>
-void Tracer::CalcRightHandSide(IdefixArray4D<real> &Flux, real t, real dt) {
+void Tracer::CalcRightHandSide(IdefixArray4D<flux_real> &Flux, real t, real dt) {
   idfx::pushRegion("Tracer::ComputeRHS");
 
   IdefixArray4D<real> Uc = this->Uc;
@@ -116,7 +116,8 @@ void Tracer::CalcRightHandSide(IdefixArray4D<real> &Flux, real t, real dt) {
              data->beg[JDIR],data->end[JDIR],
              data->beg[IDIR],data->end[IDIR],
     KOKKOS_LAMBDA (int nv, int k, int j, int i) {
-      Uc(nv,k,j,i) += -dt / dV(k,j,i) * (Flux(nv,k+koffset,j+joffset,i+ioffset) - Flux(nv,k,j,i));
+      Uc(nv,k,j,i) += -dt / dV(k,j,i) * (static_cast<real>(Flux(nv,k+koffset,j+joffset,i+ioffset))
+                                         - Flux(nv,k,j,i));
   });
 
   idfx::popRegion();
@@ -0,0 +1,94 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef FLUID_UPDATEDIFFUSIVITIES_HPP_
+#define FLUID_UPDATEDIFFUSIVITIES_HPP_
+
+#include "fluid.hpp"
+#include "dataBlock.hpp"
+
+// Fill the user-defined diffusivities of the parabolic modules integrated in the given context
+// (explicit stage, RKL stage, implicit step or Hall sub-cycles), following the update policy
+// ([Hydro] diffusivityUpdate), which is tracked separately for each context.
+// The arrays keep their values between two updates.
+template<typename Phys>
+void Fluid<Phys>::UpdateDiffusivities(const real t, const DiffusivityContext context) {
+  if(!haveUserDiffusivities) return;
+
+  if(diffusivityUpdatePeriod > 0) {
+    const int64_t last = lastDiffusivityUpdate[context];
+    if(last >= 0 && data->cycle - last < diffusivityUpdatePeriod) return;
+    lastDiffusivityUpdate[context] = data->cycle;
+  }
+
+  idfx::pushRegion("Fluid::UpdateDiffusivities");
+  // Is a module integrated in the current context?
+  auto isActive = [&](const ParabolicModuleStatus &st) {
+    if(st.status != UserDefFunction) return(false);
+    switch(context) {
+      case ExplicitContext:
+        return(st.isExplicit);
+      case RKLContext:
+        return(st.isRKL);
+      case ImplicitContext:
+        return(st.isImplicit);
+      case HallContext:
+        return(st.isSubcycled);
+      default:
+        return(false);
+    }
+  };
+
+  if(diffusivitiesFunc) {
+    // Single user function: only the arrays to be updated are passed
+    DiffusivityArrays arrays;
+    if(isActive(resistivityStatus)) arrays.etaOhmic = etaOhmic;
+    if(isActive(ambipolarStatus)) arrays.xAmbipolar = xAmbipolar;
+    if(isActive(hallStatus)) arrays.xHall = xHall;
+    if(isActive(viscosityStatus)) {
+      arrays.eta1 = viscosity->eta1Arr;
+      arrays.eta2 = viscosity->eta2Arr;
+    }
+    if(isActive(thermalDiffusionStatus)) arrays.kappa = thermalDiffusion->kappaArr;
+    if(isActive(bragViscosityStatus)) arrays.etaBrag = bragViscosity->etaBragArr;
+    if(isActive(bragThermalDiffusionStatus)) {
+      arrays.kpar = bragThermalDiffusion->kparArr;
+      arrays.knor = bragThermalDiffusion->knorArr;
+      arrays.clessAlpha = bragThermalDiffusion->clessAlphaArr;
+      arrays.clessBeta = bragThermalDiffusion->clessBetaArr;
+    }
+    idfx::pushRegion("UserDef::DiffusivitiesFunction");
+    diffusivitiesFunc(*data, t, arrays);
+    idfx::popRegion();
+  } else {
+    if(isActive(resistivityStatus)) {
+      if(ohmicDiffusivityFunc)
+        ohmicDiffusivityFunc(*data, t, etaOhmic);
+      else
+        IDEFIX_ERROR("No user-defined Ohmic diffusivity function has been enrolled");
+    }
+    if(isActive(ambipolarStatus)) {
+      if(ambipolarDiffusivityFunc)
+        ambipolarDiffusivityFunc(*data, t, xAmbipolar);
+      else
+        IDEFIX_ERROR("No user-defined ambipolar diffusivity function has been enrolled");
+    }
+    if(isActive(hallStatus)) {
+      if(hallDiffusivityFunc)
+        hallDiffusivityFunc(*data, t, xHall);
+      else
+        IDEFIX_ERROR("No user-defined Hall diffusivity function has been enrolled");
+    }
+    if(isActive(viscosityStatus)) viscosity->UpdateDiffusivity(t);
+    if(isActive(thermalDiffusionStatus)) thermalDiffusion->UpdateDiffusivity(t);
+    if(isActive(bragViscosityStatus)) bragViscosity->UpdateDiffusivity(t);
+    if(isActive(bragThermalDiffusionStatus)) bragThermalDiffusion->UpdateDiffusivity(t);
+  }
+  idfx::popRegion();
+}
+
+#endif // FLUID_UPDATEDIFFUSIVITIES_HPP_
@@ -58,9 +58,10 @@ void Viscosity::InitArrays() {
         dmu(j) = 1.0/scrch;
       });
   #endif
-  viscSrc = IdefixArray4D<real>("Viscosity_source", COMPONENTS, data->np_tot[KDIR],
-                                                                data->np_tot[JDIR],
-                                                                data->np_tot[IDIR]);
+  // The geometrical source terms are computed and used within the same stage (or RKL cycle)
+  data->scratch.Request(viscSrc, "Viscosity_source",
+                        ScratchArena::stagePhase | ScratchArena::rklPhase,
+                        COMPONENTS, data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
 }
 void Viscosity::ShowConfig() {
   if(status.status==Constant) {
@@ -69,7 +70,7 @@ void Viscosity::ShowConfig() {
   } else if (status.status==UserDefFunction) {
     idfx::cout << "Viscosity: ENABLED with user-defined viscosity function."
                    << std::endl;
-    if(!viscousDiffusivityFunc) {
+    if(!viscousDiffusivityFunc && !status.isShared) {
       IDEFIX_ERROR("No viscosity function has been enrolled");
     }
   } else {
@@ -93,11 +94,21 @@ void Viscosity::EnrollViscousDiffusivity(ViscousDiffusivityFunc myFunc) {
   this->viscousDiffusivityFunc = myFunc;
 }
 
+void Viscosity::UpdateDiffusivity(const real t) {
+  if(viscousDiffusivityFunc) {
+    idfx::pushRegion("UserDef::ViscousDiffusivityFunction");
+    viscousDiffusivityFunc(*data, t, eta1Arr, eta2Arr);
+    idfx::popRegion();
+  } else {
+    IDEFIX_ERROR("No user-defined viscosity function has been enrolled");
+  }
+}
+
 // This function computes the viscous flux and stores it in Flux
 // (this avoids an extra array)
 // Associated source terms, present in non-cartesian geometry are also computed
 // and stored in this->viscSrc for later use (in calcRhs).
-void Viscosity::AddViscousFlux(int dir, const real t, const IdefixArray4D<real> &Flux) {
+void Viscosity::AddViscousFlux(int dir, const real t, const IdefixArray4D<flux_real> &Flux) {
   idfx::pushRegion("Viscosity::AddViscousFlux");
   IdefixArray4D<real> Vc = this->Vc;
   IdefixArray4D<real> viscSrc = this->viscSrc;
@@ -132,14 +143,7 @@ void Viscosity::AddViscousFlux(int dir, const real t, const IdefixArray4D<real>
 
   HydroModuleStatus haveViscosity = this->status.status;
 
-  // Compute viscosity if needed
-  if(haveViscosity == UserDefFunction && dir == IDIR) {
-    if(viscousDiffusivityFunc) {
-      viscousDiffusivityFunc(*data, t, eta1Arr, eta2Arr);
-    } else {
-      IDEFIX_ERROR("No user-defined viscosity function has been enrolled");
-    }
-  }
+  // User-defined viscosities are filled by Fluid::UpdateDiffusivities
 
   #if HAVE_ENERGY
     haveFargo = this->data->haveFargo;
@@ -29,10 +29,11 @@ class Viscosity {
   template <typename Phys>
   Viscosity(Input &, Grid &, Fluid<Phys> *);
   void ShowConfig();                    // print configuration
-  void AddViscousFlux(int, const real, const IdefixArray4D<real> &);
+  void AddViscousFlux(int, const real, const IdefixArray4D<flux_real> &);
 
   // Enroll user-defined viscous diffusivity
   void EnrollViscousDiffusivity(ViscousDiffusivityFunc);
+  void UpdateDiffusivity(const real);   // fill the user-defined viscosities
 
   // Function for internal use (but public to allow for Cuda lambda capture)
   void InitArrays();
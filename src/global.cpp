@@ -11,6 +11,7 @@
 #include "idefix.hpp"
 #include "global.hpp"
 #include "profiler.hpp"
+#include "reductionManager.hpp"
 #include "units.hpp"
 
 #ifdef WITH_MPI
@@ -23,14 +24,18 @@ int prank;
 int psize;
 
 double mpiCallsTimer = 0.0;
+int64_t mpiMessages = 0;
+int64_t mpiBytes = 0;
 
 bool warningsAreErrors{false};
 
 IdefixOutStream cout;
 IdefixErrStream cerr;
 Profiler prof;
+ReductionManager reductions;
 LoopPattern defaultLoopPattern;
 Units units;
+const Kokkos::DefaultExecutionSpace *execSpace{nullptr};
 
 #ifdef DEBUG
 static int regionIndent = 0;
@@ -95,6 +100,15 @@ void popRegion() {
 #endif
 }
 
+void setLoopSize(int64_t size) {
+  if(prof.perfEnabled) prof.nextLoopSize = size;
+}
+
+void annotateKernel(const std::string& kName, double bytesPerIteration,
+                    double flopsPerIteration) {
+  if(prof.perfEnabled) prof.AnnotateKernel(kName, bytesPerIteration, flopsPerIteration);
+}
+
 // Init the iostream with defined rank
 void IdefixOutStream::init(int rank) {
   if(rank==0)
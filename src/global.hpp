@@ -20,6 +20,7 @@ void safeExit(int );       // Exit the code
 class IdefixOutStream;
 class IdefixErrStream;
 class Profiler;
+class ReductionManager;
 class Units;
 
 extern int prank;                       //< parallel rank
@@ -27,13 +28,42 @@ extern int psize;
 extern IdefixOutStream cout;              //< custom cout for idefix
 extern IdefixErrStream cerr;              //< custom cerr for idefix
 extern Profiler prof;                   //< profiler (for memory & performance usage)
+extern ReductionManager reductions;     //< batched global reductions of scalars
 extern double mpiCallsTimer;            //< time significant MPI calls
+extern int64_t mpiMessages;             //< number of halo exchange messages sent
+extern int64_t mpiBytes;                //< number of bytes sent in halo exchanges
 extern LoopPattern defaultLoopPattern;  //< default loop patterns (for idefix_for loops)
 extern bool warningsAreErrors;    //< whether warnings should be considered as errors
 extern Units units;               //< Units for the run
+extern const Kokkos::DefaultExecutionSpace *execSpace; //< instance of the current ExecSpaceScope
 
 void pushRegion(const std::string&);
 void popRegion();
+void setLoopSize(int64_t);    //< size of the next idefix_for loop (kernel counters)
+void annotateKernel(const std::string&, double, double = 0); //< bytes & flops per iteration
+
+// Execution space instance of idefix_for & idefix_reduce (the default instance unless the
+// loops are launched from an ExecSpaceScope)
+inline Kokkos::DefaultExecutionSpace getExecSpace() {
+  return(execSpace ? *execSpace : Kokkos::DefaultExecutionSpace());
+}
+
+// Launch the loops of the current scope on the instance of a fluid (Fluid::execSpace), the
+// previous instance being restored at the end of the scope
+class ExecSpaceScope {
+ public:
+  explicit ExecSpaceScope(const Kokkos::DefaultExecutionSpace &space) : previous(execSpace) {
+    execSpace = &space;
+  }
+  ~ExecSpaceScope() {
+    execSpace = previous;
+  }
+  ExecSpaceScope(const ExecSpaceScope&) = delete;
+  ExecSpaceScope& operator=(const ExecSpaceScope&) = delete;
+
+ private:
+  const Kokkos::DefaultExecutionSpace *previous;
+};
 
 template<typename T>
 IdefixArray1D<T> ConvertVectorToIdefixArray(std::vector<T> &inputVector) {
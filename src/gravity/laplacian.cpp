@@ -12,6 +12,7 @@
 #include "laplacian.hpp"
 #include "selfGravity.hpp"
 #include "dataBlock.hpp"
+#include "reductionManager.hpp"
 
 
 Laplacian::Laplacian(DataBlock *datain, std::array<LaplacianBoundaryType,3> leftBound,
@@ -690,9 +691,7 @@ real Laplacian::ComputeCFL() {
                 Kokkos::Min<real>(dx1min2));
 
     // Reduction on the whole grid
-    #ifdef WITH_MPI
-    MPI_Allreduce(MPI_IN_PLACE, &dx1min2, 1, realMPI, MPI_MIN, MPI_COMM_WORLD);
-    #endif
+    dx1min2 = idfx::reductions.Reduce(dx1min2, idfx::ReductionManager::min);
 
   real dtmax = 1. / 2. * dx1min2;
 
@@ -727,10 +726,9 @@ real Laplacian::ComputeCFL() {
                 Kokkos::Min<real>(dx2min2));
 
     // Reduction on the whole grid
-    #ifdef WITH_MPI
-    MPI_Allreduce(MPI_IN_PLACE, &dx1min2, 1, realMPI, MPI_MIN, MPI_COMM_WORLD);
-    MPI_Allreduce(MPI_IN_PLACE, &dx2min2, 1, realMPI, MPI_MIN, MPI_COMM_WORLD);
-    #endif
+    idfx::reductions.Add(&dx1min2, 1, idfx::ReductionManager::min);
+    idfx::reductions.Add(&dx2min2, 1, idfx::ReductionManager::min);
+    idfx::reductions.Flush();
 
   real dtmax = 1. / 2. * 1. / ( 1. / dx1min2 + 1. / dx2min2);
 
@@ -782,11 +780,10 @@ real Laplacian::ComputeCFL() {
                 Kokkos::Min<real>(dx3min2));
 
     // Reduction on the whole grid
-    #ifdef WITH_MPI
-    MPI_Allreduce(MPI_IN_PLACE, &dx1min2, 1, realMPI, MPI_MIN, MPI_COMM_WORLD);
-    MPI_Allreduce(MPI_IN_PLACE, &dx2min2, 1, realMPI, MPI_MIN, MPI_COMM_WORLD);
-    MPI_Allreduce(MPI_IN_PLACE, &dx3min2, 1, realMPI, MPI_MIN, MPI_COMM_WORLD);
-    #endif
+    idfx::reductions.Add(&dx1min2, 1, idfx::ReductionManager::min);
+    idfx::reductions.Add(&dx2min2, 1, idfx::ReductionManager::min);
+    idfx::reductions.Add(&dx3min2, 1, idfx::ReductionManager::min);
+    idfx::reductions.Flush();
 
   real dtmax = 1. / 2. * 1. / ( 1. / dx1min2 + 1. / dx2min2 + 1. / dx3min2);
   #endif
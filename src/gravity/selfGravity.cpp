@@ -17,6 +17,7 @@
 #include "cg.hpp"
 #include "minres.hpp"
 #include "jacobi.hpp"
+#include "reductionManager.hpp"
 
 
 void SelfGravity::Init(Input &input, DataBlock *datain) {
@@ -308,9 +309,7 @@ void SelfGravity::InitSolver() {
       if(std::isnan(density(k,j,i))) nnan++;
     }, Kokkos::Sum<int>(nanDensity) // reduction variable
   );
-  #ifdef WITH_MPI
-    MPI_Allreduce(MPI_IN_PLACE, &nanDensity,1,MPI_INT, MPI_SUM, MPI_COMM_WORLD);
-  #endif
+  nanDensity = static_cast<int>(idfx::reductions.Reduce(nanDensity, idfx::ReductionManager::sum));
 
   if(nanDensity>0) {
     std::stringstream msg;
@@ -354,9 +353,8 @@ void SelfGravity::SubstractMeanDensity() {
                 Kokkos::Sum<MyVector>(meanDensityVector));
 
   // Reduction on the whole grid
-  #ifdef WITH_MPI
-  MPI_Allreduce(MPI_IN_PLACE, &meanDensityVector.v, 2, realMPI, MPI_SUM, MPI_COMM_WORLD);
-  #endif
+  idfx::reductions.Add(meanDensityVector.v, 2, idfx::ReductionManager::sum);
+  idfx::reductions.Flush();
 
   real mean = meanDensityVector.v[0] / meanDensityVector.v[1];
 
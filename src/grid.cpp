@@ -5,11 +5,15 @@
 // Licensed under CeCILL 2.1 License, see COPYING for more information
 // ***********************************************************************************
 
+#include <algorithm>
+#include <cmath>
+#include <fstream>
 #include <string>
 
 #include "idefix.hpp"
 #include "gridHost.hpp"
 #include "grid.hpp"
+#include "physics.hpp"
 
 Grid::Grid(SubGrid * subgrid) {
   idfx::pushRegion("Grid::Grid(SubGrid)");
@@ -32,9 +36,11 @@ Grid::Grid(SubGrid * subgrid) {
 
   haveGridCoarsening = subgrid->parentGrid->haveGridCoarsening;
   coarseningDirection = subgrid->parentGrid->coarseningDirection;
+  coarseFluxes = subgrid->parentGrid->coarseFluxes;
 
   nproc = subgrid->parentGrid->nproc;
   xproc = subgrid->parentGrid->xproc;
+  procBeg = subgrid->parentGrid->procBeg;
 
   // Now slice if along the chosen direction
   SliceMe(subgrid);
@@ -169,25 +175,8 @@ Grid::Grid(Input &input) {
       IDEFIX_ERROR("Total grid size must be a multiple of the number of mpi process");
     // Check that dec option has been passed
     if(input.CheckEntry("CommandLine","dec")  != DIMENSIONS) {
-      // No command line decomposition, make auto-decomposition if possible
-      // (only when nproc and dimensions are powers of 2, and in 1D)
-      if(DIMENSIONS == 1) {
-        nproc[0] = idfx::psize;
-      } else {
-        if(!isPow2(idfx::psize))
-          IDEFIX_ERROR(
-            "Automatic domain decomposition requires the number of processes to be a power of 2. "
-            "Alternatively, set a manual decomposition with -dec"
-          );
-        for(int dir = 0; dir < 3; dir++) {
-          if(!isPow2(np_int[dir]))
-            IDEFIX_ERROR(
-              "Automatic domain decomposition requires nx1, nx2 and nx3 to be powers of 2. "
-              "Alternatively, set a manual decomposition with -dec"
-            );
-        }
-        makeDomainDecomposition();
-      }
+      // No command line decomposition, make auto-decomposition
+      makeDomainDecomposition(input);
     } else {
       // Manual domain decomposition (with -dec option)
       int ntot=1;
@@ -218,6 +207,10 @@ Grid::Grid(Input &input) {
     if(rbound[dir] == periodic || rbound[dir] == shearingbox) period[dir] = 1;
   }
 
+  // Volume exchanged by the halo exchanges of the decomposition we use
+  this->nvarExchanged = countExchangedVars(input);
+  this->haloVolume = computeHaloVolume(nproc, nvarExchanged);
+
   // Create cartesian communicator along with cartesian coordinates.
   MPI_Cart_create(MPI_COMM_WORLD, 3, nproc.data(), period, 0, &CartComm);
   MPI_Cart_coords(CartComm, idfx::prank, 3, xproc.data());
@@ -233,6 +226,9 @@ Grid::Grid(Input &input) {
   }
 #endif
 
+  // Size of the subdomains in each direction
+  makeProcExtents(input);
+
   // init coarsening
   if(input.CheckEntry("Grid","coarsening")>=0) {
     std::string coarsenType = input.Get<std::string>("Grid","coarsening",0);
@@ -264,49 +260,352 @@ Grid::Grid(Input &input) {
     }
 
     this->haveGridCoarsening = GridCoarsening::enabled;
+
+    // Faces at which the Riemann fluxes are evaluated inside coarsened regions
+    std::string fluxes = input.GetOrSet<std::string>("Grid","coarseningFluxes",0,"fine");
+    if(fluxes.compare("fine")==0) {
+      this->coarseFluxes = false;
+    } else if(fluxes.compare("coarse")==0) {
+      this->coarseFluxes = true;
+    } else {
+      std::stringstream msg;
+      msg << "Grid coarseningFluxes can only be fine or coarse. I got: " << fluxes;
+      IDEFIX_ERROR(msg);
+    }
   }
   idfx::popRegion();
 }
 
-bool Grid::isPow2(int n) {
-  return( (n & (n-1)) == 0);
+// Number of variables exchanged in each cell by the halo exchanges of the fluids
+int Grid::countExchangedVars(Input &input) {
+  // NB: in MHD, the face-centered field components replace the cell-centered ones
+  int nvar = DefaultPhysics::nvar;
+  if(input.CheckBlock("Dust")) {
+    nvar += input.Get<int>("Dust","nSpecies",0) * DustPhysics::nvar;
+  }
+  return(nvar);
 }
 
-// Produce a domain decomposition in nProc assuming psize and np_int[] are powers of 2
-void Grid::makeDomainDecomposition() {
-  // initialize the routine
-  int nleft=idfx::psize;
-  int nlocal[3];
-  for(int dir = 0; dir < 3; dir++) {
-    nproc[dir] = 1;
-    nlocal[dir] = np_int[dir];
+// Number of reals sent over MPI by all of the processes in one call to the halo exchanges, for
+// the decomposition decomp and nvar variables exchanged in each cell. The exchanges are done
+// one direction after the other, including the ghost zones of the previous directions.
+double Grid::computeHaloVolume(const std::array<int,3> &decomp, const int nvar) {
+  int ntotProc = 1;
+  for(int dir = 0 ; dir < 3 ; dir++) ntotProc *= decomp[dir];
+
+  double volume = 0;
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    if(decomp[dir] == 1) continue;
+    double face = nghost[dir];
+    for(int other = 0 ; other < 3 ; other++) {
+      if(other == dir) continue;
+      int n = np_int[other]/decomp[other];
+      if(other < dir) n += 2*nghost[other];
+      face *= n;
+    }
+    // Interfaces between processes along dir (the domain edges are exchanged when periodic)
+    const bool isPeriodic = (rbound[dir] == periodic || rbound[dir] == shearingbox);
+    const int interfaces = (isPeriodic ? decomp[dir] : decomp[dir]-1) * (ntotProc/decomp[dir]);
+    // Each interface is crossed both ways
+    volume += 2.0*interfaces*face;
   }
+  return(volume*nvar);
+}
 
-  // Loop
-  while(nleft>1) {
-    // Find the direction where there is a maximum of point
-    int dirmax;
-    int nmax=1;
-    int ndir=2;
+// Direction in which Fargo shifts the domain, X2 (cartesian, polar) or X3 (spherical), and the
+// maximum shift. fargoDir is negative without Fargo.
+void Grid::getFargoShift(Input &input, int &fargoDir, int &fargoMaxShift) {
+  fargoDir = -1;
+  fargoMaxShift = 0;
+  if(input.CheckBlock("Fargo")) {
+    #if GEOMETRY == CARTESIAN || GEOMETRY == POLAR
+      fargoDir = JDIR;
+    #elif GEOMETRY == SPHERICAL
+      fargoDir = KDIR;
+    #endif
+    fargoMaxShift = input.GetOrSet<int>("Fargo", "maxShift",0, 10);
+  }
+}
 
-    for(int dir = ndir; dir >= 0; dir--) {
-      // We do this loop backward so that we divide the domain first in the last dimension
+// Check that the decomposition decomp is compatible with the grid and the modules that
+// constrain the subdomain sizes. The reason of a failure is written in msg.
+bool Grid::checkDomainDecomposition(const std::array<int,3> &decomp, const int fargoDir,
+                                    const int fargoMaxShift, std::stringstream &msg) {
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    if(np_int[dir] % decomp[dir]) {
+      msg << "nx" << dir+1 << "=" << np_int[dir] << " is not divisible by " << decomp[dir];
+      return(false);
+    }
+    const int nlocal = np_int[dir]/decomp[dir];
+    // Each subdomain should be able to fill the ghost zones of its neighbours
+    if(decomp[dir] > 1 && nlocal < nghost[dir]) {
+      msg << "subdomains are smaller than the ghost zones in X" << dir+1;
+      return(false);
+    }
+  }
+  // Fargo requires the subdomains to be larger than the maximum shift
+  if(fargoDir >= 0 && decomp[fargoDir] > 1) {
+    if(np_int[fargoDir]/decomp[fargoDir] < fargoMaxShift + nghost[fargoDir]) {
+      msg << "subdomains are smaller than Fargo:maxShift in X" << fargoDir+1;
+      return(false);
+    }
+  }
+  // Axis boundaries exchange data with the process facing us across the axis
+  if(haveAxis && decomp[KDIR] > 1 && decomp[KDIR] % 2 == 1) {
+    msg << "axis boundaries require an even number of processes in X3";
+    return(false);
+  }
+  return(true);
+}
+
+// Produce the domain decomposition in nProc which minimises the volume of the halo exchanges,
+// among all of the factorisations of psize compatible with the grid.
+void Grid::makeDomainDecomposition(Input &input) {
+  int fargoDir, fargoMaxShift;
+  getFargoShift(input, fargoDir, fargoMaxShift);
+  const int nvar = countExchangedVars(input);
+
+  bool found = false;
+  double bestVolume = 0;
+  std::array<int,3> decomp;
+  std::stringstream reason;
+  int nreason = 0;
+  for(int n1 = 1 ; n1 <= idfx::psize ; n1++) {
+    if(idfx::psize % n1) continue;
+    for(int n2 = 1 ; n2 <= idfx::psize/n1 ; n2++) {
+      if((idfx::psize/n1) % n2) continue;
+      decomp = {n1, n2, idfx::psize/(n1*n2)};
+      if(DIMENSIONS < 3 && decomp[KDIR] > 1) continue;
+      if(DIMENSIONS < 2 && decomp[JDIR] > 1) continue;
+
+      std::stringstream msg;
+      if(!checkDomainDecomposition(decomp, fargoDir, fargoMaxShift, msg)) {
+        // Only show the first rejected decompositions
+        if(nreason++ < 10) {
+          reason << std::endl << "(" << n1 << ", " << n2 << ", " << decomp[KDIR] << "): "
+                 << msg.str();
+        }
+        continue;
+      }
+      const double volume = computeHaloVolume(decomp, nvar);
+      // For equal volumes, we keep the decomposition split the most in the last dimensions
       // (better for cache optimisation)
-      if(nlocal[dir]>nmax ) {
-        nmax=nlocal[dir];
-        dirmax=dir;
+      if(!found || volume < bestVolume
+                || (volume == bestVolume && (decomp[KDIR] > nproc[KDIR]
+                   || (decomp[KDIR] == nproc[KDIR] && decomp[JDIR] > nproc[JDIR])))) {
+        found = true;
+        bestVolume = volume;
+        nproc = decomp;
+      }
+    }
+  }
+  if(!found) {
+    std::stringstream msg;
+    msg << "Cannot find an automatic domain decomposition on " << idfx::psize
+        << " MPI processes:" << reason.str() << std::endl
+        << "Change the number of processes or set a manual decomposition with -dec";
+    IDEFIX_ERROR(msg);
+  }
+  autoDecomposition = true;
+}
+
+// Compute the first cell of the subdomains in each direction. The cells are evenly distributed
+// between the processes, unless [Grid] loadBalancing is set to cost, in which case the subdomains
+// share the compute time measured by a previous run (see WriteCostMap). The decomposition stays
+// rectilinear, so that neighbouring subdomains always share the same transverse sizes.
+void Grid::makeProcExtents(Input &input) {
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    procBeg[dir].resize(nproc[dir]+1);
+    for(int p = 0 ; p <= nproc[dir] ; p++) {
+      procBeg[dir][p] = p*(np_int[dir]/nproc[dir]);
+    }
+  }
+
+  std::string balancing = input.GetOrSet<std::string>("Grid","loadBalancing",0,"none");
+  if(balancing.compare("none")==0) return;
+  if(balancing.compare("cost")!=0) {
+    std::stringstream msg;
+    msg << "Grid loadBalancing can only be none or cost. I got: " << balancing;
+    IDEFIX_ERROR(msg);
+  }
+  this->haveLoadBalancing = true;
+  this->costGranularity = input.GetOrSet<int>("Grid","loadBalancing",1,1);
+  if(costGranularity < 1) {
+    IDEFIX_ERROR("Grid loadBalancing granularity should be >= 1");
+  }
+  // The cost map is kept next to the dump files, to be used on restarts
+  std::string directory = "./";
+  if(input.CheckEntry("Output","dmp_dir")>=0) {
+    directory = input.Get<std::string>("Output","dmp_dir",0);
+    if(directory.back() != '/') directory += "/";
+  }
+  this->costFileName = directory + "idefix.cost";
+
+  this->haveCostMap = readCostMap();
+  if(haveCostMap) {
+    int fargoDir, fargoMaxShift;
+    getFargoShift(input, fargoDir, fargoMaxShift);
+    for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+      if(nproc[dir] == 1) continue;
+      // Each subdomain should be able to fill the ghost zones of its neighbours
+      int minSize = nghost[dir];
+      if(dir == fargoDir) minSize += fargoMaxShift;
+      if(haveAxis && dir == KDIR) {
+        // Axis boundaries exchange data with the process facing us across the axis, which should
+        // hold the same cells shifted by half of the domain: split the folded cost map
+        const int half = np_int[KDIR]/2;
+        const int nhalf = nproc[KDIR]/2;
+        std::vector<double> folded(half);
+        for(int k = 0 ; k < half ; k++) {
+          folded[k] = cellCost[KDIR][k] + cellCost[KDIR][k+half];
+        }
+        std::vector<int> bounds = splitCost(folded, nhalf, minSize, costGranularity, KDIR);
+        for(int p = 0 ; p <= nhalf ; p++) {
+          procBeg[KDIR][p] = bounds[p];
+          procBeg[KDIR][p+nhalf] = bounds[p] + half;
+        }
+      } else {
+        procBeg[dir] = splitCost(cellCost[dir], nproc[dir], minSize, costGranularity, dir);
+      }
+    }
+  }
+  // The cost map is measured again during this run
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    std::fill(cellCost[dir].begin(), cellCost[dir].end(), 0.0);
+  }
+}
+
+// Read the cost map written by a previous run. Returns false when no cost map matching the grid
+// could be found, in which case the cost map is left empty.
+bool Grid::readCostMap() {
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    cellCost[dir].assign(np_int[dir], 0.0);
+  }
+  // 1: found, 0: not found, -1: not matching the grid
+  int status = 1;
+  if(idfx::prank == 0) {
+    std::ifstream file(costFileName);
+    if(!file.is_open()) {
+      status = 0;
+    } else {
+      std::string line;
+      std::getline(file, line);   // header
+      for(int dir = 0 ; dir < DIMENSIONS && status > 0 ; dir++) {
+        std::string label;
+        int n = 0;
+        file >> label >> n;
+        if(!file || n != np_int[dir]) {
+          status = -1;
+          break;
+        }
+        for(int i = 0 ; i < n ; i++) {
+          file >> cellCost[dir][i];
+          // Negative costs cannot be measured
+          cellCost[dir][i] = std::max(cellCost[dir][i], 0.0);
+        }
+        if(!file) status = -1;
+      }
+    }
+  }
+  #ifdef WITH_MPI
+    MPI_SAFE_CALL(MPI_Bcast(&status, 1, MPI_INT, 0, MPI_COMM_WORLD));
+    if(status > 0) {
+      for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+        MPI_SAFE_CALL(MPI_Bcast(cellCost[dir].data(), np_int[dir], MPI_DOUBLE, 0, MPI_COMM_WORLD));
       }
     }
-    // At this point, we have nmax points in direction dirmax,
-    // which is the direction we're going to divide by 2
-    if(nmax==1)
-      IDEFIX_ERROR("Your domain size is too small to be decomposed "
-                   "on this number of MPI processes");
-    nlocal[dirmax]=nlocal[dirmax]/2;
-    nproc[dirmax]=nproc[dirmax]*2;
-    nleft=nleft/2;
+  #endif
+  if(status < 0) {
+    std::stringstream msg;
+    msg << "The cost map " << costFileName << " does not match the grid dimensions. "
+        << "It is ignored.";
+    IDEFIX_WARNING(msg);
   }
+  return(status > 0);
 }
+
+// Split the n slices of cells of cost into nparts contiguous pieces of similar total cost. Each
+// piece holds at least minSize slices, and a multiple of granularity slices. Returns the first
+// slice of each piece, followed by n.
+std::vector<int> Grid::splitCost(const std::vector<double> &cost, const int nparts,
+                                 const int minSize, const int granularity, const int dir) {
+  const int n = cost.size();
+  // Smallest piece allowed, rounded to the granularity
+  const int nmin = ((std::max(minSize, 1) + granularity - 1)/granularity)*granularity;
+  if(n % granularity || nparts*nmin > n) {
+    std::stringstream msg;
+    msg << "Cannot split the " << n << " cells of X" << dir+1 << " between " << nparts
+        << " processes with at least " << nmin << " cells each and a multiple of "
+        << granularity << " cells. Check [Grid] loadBalancing.";
+    IDEFIX_ERROR(msg);
+  }
+
+  std::vector<double> sum(n+1, 0.0);
+  for(int i = 0 ; i < n ; i++) sum[i+1] = sum[i] + cost[i];
+
+  std::vector<int> bounds(nparts+1);
+  bounds[0] = 0;
+  bounds[nparts] = n;
+  for(int p = 1 ; p < nparts ; p++) {
+    int b;
+    if(sum[n] > 0) {
+      // Slice boundary at which the cumulated cost is the closest to the target
+      const double target = sum[n]*p/nparts;
+      b = std::lower_bound(sum.begin(), sum.end(), target) - sum.begin();
+      if(b > 0 && target - sum[b-1] < sum[b] - target) b--;
+    } else {
+      b = (n*p)/nparts;
+    }
+    b = granularity*static_cast<int>(std::lround(static_cast<double>(b)/granularity));
+    // Leave enough slices for the pieces on both sides
+    const int lo = bounds[p-1] + nmin;
+    const int hi = n - (nparts-p)*nmin;
+    bounds[p] = std::min(std::max(b, lo), hi);
+  }
+  return(bounds);
+}
+
+// Spread the compute time of this process over the slices of cells it holds in each direction
+void Grid::AddComputeTime(double time) {
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    const int b = procBeg[dir][xproc[dir]];
+    const int e = procBeg[dir][xproc[dir]+1];
+    for(int i = b ; i < e ; i++) {
+      cellCost[dir][i] += time/(e-b);
+    }
+  }
+}
+
+// Sum the cost map of all of the processes and write it, so that a restart can balance the
+// subdomains. This is a collective call.
+void Grid::WriteCostMap() {
+  idfx::pushRegion("Grid::WriteCostMap");
+  std::array<std::vector<double>,3> cost = cellCost;
+  #ifdef WITH_MPI
+    for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+      MPI_SAFE_CALL(MPI_Reduce(cellCost[dir].data(), cost[dir].data(), np_int[dir], MPI_DOUBLE,
+                               MPI_SUM, 0, MPI_COMM_WORLD));
+    }
+  #endif
+  if(idfx::prank == 0) {
+    std::ofstream file(costFileName);
+    if(!file.is_open()) {
+      std::stringstream msg;
+      msg << "Cannot write the cost map " << costFileName;
+      IDEFIX_WARNING(msg);
+    } else {
+      file << "# Idefix cost map: compute time (s) measured in each slice of cells" << std::endl;
+      file << std::scientific;
+      for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+        file << "X" << dir+1 << " " << np_int[dir];
+        for(int i = 0 ; i < np_int[dir] ; i++) file << " " << cost[dir][i];
+        file << std::endl;
+      }
+    }
+  }
+  idfx::popRegion();
+}
+
 /*
 Grid& Grid::operator=(const Grid& grid) {
     for(int dir = 0 ; dir < 3 ; dir++) {
@@ -396,7 +695,34 @@ void Grid::ShowConfig() {
     for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
       idfx::cout << " " << nproc[dir] << " ";
     }
-    idfx::cout << ")" << std::endl;
+    idfx::cout << ")";
+    if(autoDecomposition) idfx::cout << ", minimising the halo exchanges";
+    idfx::cout << std::endl;
+    if(haveLoadBalancing) {
+      if(haveCostMap) {
+        idfx::cout << "Grid: subdomain sizes balanced with the cost map " << costFileName
+                   << std::endl;
+        for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+          if(nproc[dir] == 1) continue;
+          idfx::cout << "\t Direction X" << (dir+1) << ":";
+          for(int p = 0 ; p < nproc[dir] ; p++) {
+            idfx::cout << " " << procBeg[dir][p+1] - procBeg[dir][p];
+          }
+          idfx::cout << std::endl;
+        }
+      } else {
+        idfx::cout << "Grid: no cost map found in " << costFileName << ", even subdomain sizes. "
+                   << "The cost map is measured and written with the dumps." << std::endl;
+      }
+    }
+    if(idfx::psize > 1) {
+      double gridVolume = 1;
+      for(int dir = 0 ; dir < DIMENSIONS ; dir++) gridVolume *= np_int[dir];
+      idfx::cout << "Grid: predicted halo exchange volume is "
+                 << haloVolume*sizeof(real)/1024.0/1024.0 << " MB per boundary call ("
+                 << 100.0*haloVolume/(gridVolume*nvarExchanged) << "% of the fluid data)."
+                 << std::endl;
+    }
     idfx::cout << "Grid: Current MPI proc coordinates (";
 
     for(int dir = 0; dir < 3; dir++) {
@@ -419,6 +745,10 @@ void Grid::ShowConfig() {
       }
     }
     idfx::cout << std::endl;
+    if(coarseFluxes) {
+      idfx::cout << "Grid: Riemann fluxes only computed on the faces of coarsened cells."
+                 << std::endl;
+    }
   }
 }
 
@@ -464,4 +794,5 @@ void Grid::SliceMe(SubGrid *subgrid) {
     nproc[dir] = 1;
     xproc[dir] = 0;
   #endif
+  this->procBeg[dir] = {0, 1};
 }
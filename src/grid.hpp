@@ -7,8 +7,11 @@
 
 #ifndef GRID_HPP_
 #define GRID_HPP_
-#include <vector>
+#include <array>
 #include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
 #include "idefix.hpp"
 #include "input.hpp"
 
@@ -44,10 +47,20 @@ class Grid {
 
   GridCoarsening haveGridCoarsening{GridCoarsening::disabled}; ///< Is grid coarsening enabled?
   std::array<bool,3> coarseningDirection;  ///< whether a coarsening is used in each direction
+  bool coarseFluxes{false};   ///< Riemann fluxes only computed on the faces of coarsened cells
 
   // MPI data
   std::array<int,3> nproc;           ///</< Total number of procs in each direction
   std::array<int,3> xproc;           ///</< Coordinates of current proc in the array of procs
+  bool autoDecomposition{false};     ///< Was the domain decomposition computed automatically?
+  int nvarExchanged{0};              ///< Number of variables exchanged in each cell
+  double haloVolume{0};              ///< Predicted number of reals sent by the halo exchanges
+  std::array<std::vector<int>,3> procBeg; ///< First active cell of each process coordinate in each
+                                          ///< direction (nproc+1 entries, the last one is np_int)
+
+  bool haveLoadBalancing{false};     ///< Are the subdomain sizes computed from the cost map?
+  bool haveCostMap{false};           ///< Was a cost map found when building the decomposition?
+  std::array<std::vector<double>,3> cellCost; ///< Compute time measured in each slice of cells
 
   #ifdef WITH_MPI
   MPI_Comm CartComm;                ///< Cartesian communicator for the planned domain decomposition
@@ -63,12 +76,23 @@ class Grid {
 
   void SliceMe(SubGrid *);       ///< Slice this grid according to the subgrid (internal function)
 
+  void AddComputeTime(double);   ///< Add the compute time of this process to the cost map
+  void WriteCostMap();           ///< Gather the cost map and write it for the next restart
+
   Grid() = default;
 
  private:
-  // Check if number is a power of 2
-  bool isPow2(int);
-  void makeDomainDecomposition();
+  void makeDomainDecomposition(Input &);
+  bool checkDomainDecomposition(const std::array<int,3> &, int, int, std::stringstream &);
+  double computeHaloVolume(const std::array<int,3> &, int);
+  int countExchangedVars(Input &);
+  void getFargoShift(Input &, int &, int &);
+  void makeProcExtents(Input &);
+  bool readCostMap();
+  std::vector<int> splitCost(const std::vector<double> &, int, int, int, int);
+
+  std::string costFileName;      ///< File in which the cost map is stored
+  int costGranularity{1};        ///< Subdomain sizes are multiples of this number of cells
 };
 
 /**
@@ -172,6 +172,7 @@ void Input::ParseCommandLine(int argc, char **argv) {
     } else if(std::string(argv[i]) == "-nowrite") {
       this->forceNoWrite = true;
       enableLogs = false;
+      idfx::prof.writeEnabled = false;
     } else if(std::string(argv[i]) == "-nolog") {
       enableLogs = false;
     } else if(std::string(argv[i]) == "-profile") {
@@ -234,6 +235,9 @@ void Input::ShowConfig() {
 
   #ifdef SINGLE_PRECISION
     idfx::cout << "Input: Compiled with SINGLE PRECISION arithmetic." << std::endl;
+  #elif defined(MIXED_PRECISION)
+    idfx::cout << "Input: Compiled with MIXED PRECISION arithmetic "
+               << "(single precision fluxes)." << std::endl;
   #else
     idfx::cout << "Input: Compiled with DOUBLE PRECISION arithmetic." << std::endl;
   #endif
@@ -242,6 +246,9 @@ void Input::ShowConfig() {
   idfx::cout << "Input: COMPONENTS=" << COMPONENTS << "." << std::endl;
   #ifdef WITH_MPI
     idfx::cout << "Input: MPI ENABLED." << std::endl;
+    #ifdef MPI_SHARED_MEMORY
+      idfx::cout << "Input: MPI halo exchanges use shared memory within a node." << std::endl;
+    #endif
   #endif
 }
 
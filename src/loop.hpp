@@ -84,8 +84,9 @@ inline void idefix_for(const std::string & NAME,
   #ifdef DEBUG
   idfx::pushRegion("idefix_for("+NAME+")");
   #endif
+  idfx::setLoopSize(static_cast<int64_t>(IE-IB));
   const int NI = IE - IB;
-  Kokkos::parallel_for(NAME, NI,
+  Kokkos::parallel_for(NAME, Kokkos::RangePolicy<>(idfx::getExecSpace(), 0, NI),
     KOKKOS_LAMBDA (const int& IDX) {
       int i = IDX;
       i += IB;
@@ -107,12 +108,13 @@ inline void idefix_for(const std::string & NAME,
   #ifdef DEBUG
   idfx::pushRegion("idefix_for("+NAME+")");
   #endif
+  idfx::setLoopSize(static_cast<int64_t>(JE-JB)*(IE-IB));
   // Kokkos 1D Range
   if constexpr(defaultLoop == LoopPattern::RANGE) {
     const int NJ = JE - JB;
     const int NI = IE - IB;
     const int NJNI = NJ * NI;
-    Kokkos::parallel_for(NAME, NJNI,
+    Kokkos::parallel_for(NAME, Kokkos::RangePolicy<>(idfx::getExecSpace(), 0, NJNI),
       KOKKOS_LAMBDA (const int& IDX) {
         int j = IDX  / NI;
         int i = IDX - j*NI;
@@ -125,12 +127,13 @@ inline void idefix_for(const std::string & NAME,
   } else if constexpr(defaultLoop == LoopPattern::MDRANGE) {
     Kokkos::parallel_for(NAME,
       Kokkos::MDRangePolicy<Kokkos::Rank<2, Kokkos::Iterate::Right, Kokkos::Iterate::Right>>
-        ({JB,IB},{JE,IE}), function);
+        (idfx::getExecSpace(), {JB,IB},{JE,IE}), function);
 
     // TeamPolicies with single inner loops
   } else if constexpr(defaultLoop == LoopPattern::TPX || defaultLoop == LoopPattern::TPTTRTVR ) {
     const int NJ = JE - JB;
-    Kokkos::parallel_for(NAME, team_policy (NJ, Kokkos::AUTO,KOKKOS_VECTOR_LENGTH),
+    Kokkos::parallel_for(NAME,
+      team_policy (idfx::getExecSpace(), NJ, Kokkos::AUTO,KOKKOS_VECTOR_LENGTH),
       KOKKOS_LAMBDA (member_type team_member) {
         const int j = team_member.league_rank() + JB;
         Kokkos::parallel_for(TPINNERLOOP<>(team_member,IB,IE),
@@ -165,6 +168,7 @@ inline void idefix_for(const std::string & NAME,
   #ifdef DEBUG
   idfx::pushRegion("idefix_for("+NAME+")");
   #endif
+  idfx::setLoopSize(static_cast<int64_t>(KE-KB)*(JE-JB)*(IE-IB));
   // Kokkos 1D Range
   if constexpr(defaultLoop == LoopPattern::RANGE) {
     const int NK = KE - KB;
@@ -172,7 +176,7 @@ inline void idefix_for(const std::string & NAME,
     const int NI = IE - IB;
     const int NKNJNI = NK*NJ*NI;
     const int NJNI = NJ * NI;
-    Kokkos::parallel_for(NAME,NKNJNI,
+    Kokkos::parallel_for(NAME, Kokkos::RangePolicy<>(idfx::getExecSpace(), 0, NKNJNI),
       KOKKOS_LAMBDA (const int& IDX) {
         int k = IDX / NJNI;
         int j = (IDX - k*NJNI) / NI;
@@ -187,7 +191,7 @@ inline void idefix_for(const std::string & NAME,
   } else if constexpr(defaultLoop == LoopPattern::MDRANGE) {
     Kokkos::parallel_for(NAME,
       Kokkos::MDRangePolicy<Kokkos::Rank<3, Kokkos::Iterate::Right, Kokkos::Iterate::Right>>
-        ({KB,JB,IB},{KE,JE,IE}), function);
+        (idfx::getExecSpace(), {KB,JB,IB},{KE,JE,IE}), function);
 
   // TeamPolicy with single inner loops
   } else if constexpr(defaultLoop == LoopPattern::TPX) {
@@ -195,7 +199,7 @@ inline void idefix_for(const std::string & NAME,
     const int NJ = JE - JB;
     const int NKNJ = NK * NJ;
     Kokkos::parallel_for(NAME,
-      team_policy (NKNJ, Kokkos::AUTO,KOKKOS_VECTOR_LENGTH),
+      team_policy (idfx::getExecSpace(), NKNJ, Kokkos::AUTO,KOKKOS_VECTOR_LENGTH),
       KOKKOS_LAMBDA (member_type team_member) {
         const int k = team_member.league_rank() / NJ + KB;
         const int j = team_member.league_rank() % NJ + JB;
@@ -209,7 +213,7 @@ inline void idefix_for(const std::string & NAME,
   } else if constexpr(defaultLoop == LoopPattern::TPTTRTVR) {
     const int NK = KE - KB;
     Kokkos::parallel_for(NAME,
-      team_policy (NK, Kokkos::AUTO,KOKKOS_VECTOR_LENGTH),
+      team_policy (idfx::getExecSpace(), NK, Kokkos::AUTO,KOKKOS_VECTOR_LENGTH),
       KOKKOS_LAMBDA (member_type team_member) {
         const int k = team_member.league_rank() + KB;
         Kokkos::parallel_for(
@@ -250,6 +254,8 @@ inline void idefix_for(const std::string & NAME,
   #ifdef DEBUG
   idfx::pushRegion("idefix_for("+NAME+")");
   #endif
+  // Kernel counters are in cells: the variable extent n is not counted
+  idfx::setLoopSize(static_cast<int64_t>(KE-KB)*(JE-JB)*(IE-IB));
   // Kokkos 1D Range
   if constexpr(defaultLoop == LoopPattern::RANGE) {
     const int NN = (NE) - (NB);
@@ -259,7 +265,7 @@ inline void idefix_for(const std::string & NAME,
     const int NNNKNJNI = NN*NK*NJ*NI;
     const int NKNJNI = NK*NJ*NI;
     const int NJNI = NJ * NI;
-    Kokkos::parallel_for(NAME,NNNKNJNI,
+    Kokkos::parallel_for(NAME, Kokkos::RangePolicy<>(idfx::getExecSpace(), 0, NNNKNJNI),
       KOKKOS_LAMBDA (const int& IDX) {
         int n = IDX / NKNJNI;
         int k = (IDX - n*NKNJNI) / NJNI;
@@ -276,7 +282,7 @@ inline void idefix_for(const std::string & NAME,
   } else if constexpr(defaultLoop == LoopPattern::MDRANGE) {
     Kokkos::parallel_for(NAME,
       Kokkos::MDRangePolicy<Kokkos::Rank<4,Kokkos::Iterate::Right, Kokkos::Iterate::Right>>
-        ({NB,KB,JB,IB},{NE,KE,JE,IE}), function);
+        (idfx::getExecSpace(), {NB,KB,JB,IB},{NE,KE,JE,IE}), function);
 
   // TeamPolicy loops
   } else if constexpr(defaultLoop == LoopPattern::TPX) {
@@ -286,7 +292,7 @@ inline void idefix_for(const std::string & NAME,
     const int NKNJ = NK * NJ;
     const int NNNKNJ = NN * NK * NJ;
     Kokkos::parallel_for(NAME,
-      team_policy (NNNKNJ, Kokkos::AUTO,KOKKOS_VECTOR_LENGTH),
+      team_policy (idfx::getExecSpace(), NNNKNJ, Kokkos::AUTO,KOKKOS_VECTOR_LENGTH),
       KOKKOS_LAMBDA (member_type team_member) {
         int n = team_member.league_rank() / NKNJ;
         int k = (team_member.league_rank() - n*NKNJ) / NJ;
@@ -306,7 +312,7 @@ inline void idefix_for(const std::string & NAME,
     const int NK = KE - KB;
     const int NNNK = NN * NK;
     Kokkos::parallel_for(NAME,
-      team_policy (NNNK, Kokkos::AUTO,KOKKOS_VECTOR_LENGTH),
+      team_policy (idfx::getExecSpace(), NNNK, Kokkos::AUTO,KOKKOS_VECTOR_LENGTH),
       KOKKOS_LAMBDA (member_type team_member) {
         int n = team_member.league_rank() / NK + NB;
         int k = team_member.league_rank() % NK + KB;
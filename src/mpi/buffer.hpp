@@ -18,6 +18,8 @@ class Buffer {
  public:
   Buffer() = default;
   explicit Buffer(size_t size): pointer{0}, array{IdefixArray1D<real>("BufferArray",size)} {};
+  // Buffer on memory allocated elsewhere (e.g. an MPI shared memory window)
+  Buffer(real *ptr, size_t size): pointer{0}, array{IdefixArray1D<real>(ptr,size)} {};
 
   // Compute the size of a bounding box
   static size_t ComputeBoxSize(BoundingBox box) {
@@ -15,8 +15,18 @@
 //#define MPI_NON_BLOCKING
 #define MPI_PERSISTENT
 
+#if defined(MPI_SHARED_MEMORY) && !defined(MPI_PERSISTENT)
+  #error "Shared memory halo exchanges require MPI persistent communications"
+#endif
+
 int Exchanger::nInstances = 0;
 
+#ifdef MPI_SHARED_MEMORY
+// The neighbours can only read our buffers directly when they are in host memory
+constexpr bool haveHostBuffers = Kokkos::SpaceAccessibility<Kokkos::HostSpace,
+                                        Kokkos::DefaultExecutionSpace::memory_space>::accessible;
+#endif
+
 void Exchanger::Init(
               Grid *grid,
               int direction,
@@ -25,13 +35,27 @@ void Exchanger::Init(
               std::array<int, 3> nint,
               bool inputHaveVs,
               std::array<bool,2> overwriteBXn) {
+  ExchangeFieldSet fieldSet;
+  fieldSet.mapVars = inputMap;
+  fieldSet.haveVs = inputHaveVs;
+  Init(grid, direction, std::vector<ExchangeFieldSet>{fieldSet}, nghost, nint, overwriteBXn);
+}
+
+void Exchanger::Init(
+              Grid *grid,
+              int direction,
+              std::vector<ExchangeFieldSet> fieldSets,
+              std::array<int, 3> nghost,
+              std::array<int, 3> nint,
+              std::array<bool,2> overwriteBXn) {
   idfx::pushRegion("Exchanger::Init");
   this->grid = grid;
   this->direction = direction;
-  // Allocate mapVars on target and copy it from the input argument list
-  this->mapVars = idfx::ConvertVectorToIdefixArray(inputMap);
-  this->mapNVars = inputMap.size();
-  this->haveVs = inputHaveVs;
+  // Allocate the mapVars on target and copy them from the input field sets
+  for(auto &fieldSet : fieldSets) {
+    this->mapVars.push_back(idfx::ConvertVectorToIdefixArray(fieldSet.mapVars));
+    this->haveVs.push_back(fieldSet.haveVs);
+  }
 
   // increase the number of instances
   this->thisInstance = nInstances;
@@ -103,12 +127,16 @@ void Exchanger::Init(
 
   // Compute buffer sizes
   for(int face=0 ; face < 2 ; face++) {
-    bufferSizeSend[face] = mapNVars * Buffer::ComputeBoxSize(boxSend[face]);
-    bufferSizeRecv[face] = mapNVars * Buffer::ComputeBoxSize(boxRecv[face]);
-    if(haveVs) {
-      for(int component = 0 ; component <DIMENSIONS ; component++) {
-        bufferSizeSend[face] += Buffer::ComputeBoxSize( boxSendVs[component][face] );
-        bufferSizeRecv[face] += Buffer::ComputeBoxSize( boxRecvVs[component][face] );
+    bufferSizeSend[face] = 0;
+    bufferSizeRecv[face] = 0;
+    for(int set = 0 ; set < mapVars.size() ; set++) {
+      bufferSizeSend[face] += mapVars[set].extent(0) * Buffer::ComputeBoxSize(boxSend[face]);
+      bufferSizeRecv[face] += mapVars[set].extent(0) * Buffer::ComputeBoxSize(boxRecv[face]);
+      if(haveVs[set]) {
+        for(int component = 0 ; component <DIMENSIONS ; component++) {
+          bufferSizeSend[face] += Buffer::ComputeBoxSize( boxSendVs[component][face] );
+          bufferSizeRecv[face] += Buffer::ComputeBoxSize( boxRecvVs[component][face] );
+        }
       }
     }
   }
@@ -124,28 +152,38 @@ void Exchanger::Init(
   MPI_Cart_shift(grid->CartComm,direction,1,&procRecv[faceLeft],&procSend[faceRight]);
   MPI_Cart_shift(grid->CartComm,direction,-1,&procRecv[faceRight],&procSend[faceLeft]);
 
+  #ifdef MPI_SHARED_MEMORY
+    InitSharedMemory();
+  #endif
+
   #ifdef MPI_PERSISTENT
+  // Nothing is sent through MPI to the neighbours of the same node
+  std::array<int,2> countSend, countRecv;
+  for(int face = 0 ; face < 2 ; face++) {
+    countSend[face] = sharedSend[face] ? 0 : bufferSizeSend[face];
+    countRecv[face] = sharedRecv[face] ? 0 : bufferSizeRecv[face];
+  }
 
   // X1-dir exchanges
   // We receive from procRecv, and we send to procSend
 
-  MPI_Send_init(BufferSend[faceRight].data(), bufferSizeSend[faceRight], realMPI,
-            procSend[faceRight], thisInstance*2,
+  MPI_Send_init(BufferSend[faceRight].data(), countSend[faceRight], realMPI,
+            procSend[faceRight], thisInstance*4,
             grid->CartComm, &sendRequest[faceRight]);
 
-  MPI_Recv_init(BufferRecv[faceLeft].data(), bufferSizeRecv[faceLeft], realMPI,
-            procRecv[faceLeft],thisInstance*2,
+  MPI_Recv_init(BufferRecv[faceLeft].data(), countRecv[faceLeft], realMPI,
+            procRecv[faceLeft],thisInstance*4,
             grid->CartComm, &recvRequest[faceLeft]);
 
   // Send to the left
   // We receive from procRecv, and we send to procSend
 
-  MPI_Send_init(BufferSend[faceLeft].data(), bufferSizeSend[faceLeft], realMPI,
-            procSend[faceLeft],thisInstance*2+1,
+  MPI_Send_init(BufferSend[faceLeft].data(), countSend[faceLeft], realMPI,
+            procSend[faceLeft],thisInstance*4+1,
             grid->CartComm, &sendRequest[faceLeft]);
 
-  MPI_Recv_init(BufferRecv[faceRight].data(), bufferSizeRecv[faceRight], realMPI,
-            procRecv[faceRight], thisInstance*2+1,
+  MPI_Recv_init(BufferRecv[faceRight].data(), countRecv[faceRight], realMPI,
+            procRecv[faceRight], thisInstance*4+1,
             grid->CartComm, &recvRequest[faceRight]);
 
   #endif // MPI_PERSISTENT
@@ -157,6 +195,77 @@ void Exchanger::Init(
   idfx::popRegion();
 }
 
+#ifdef MPI_SHARED_MEMORY
+// Find the neighbours running on the same node, and allocate our send buffers towards them in
+// MPI-3 shared memory windows, from which these neighbours directly unpack their ghost zones.
+void Exchanger::InitSharedMemory() {
+  // Split the cartesian communicator by node (collective)
+  MPI_SAFE_CALL(MPI_Comm_split_type(grid->CartComm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL,
+                                    &nodeComm));
+  MPI_Group cartGroup, nodeGroup;
+  MPI_SAFE_CALL(MPI_Comm_group(grid->CartComm, &cartGroup));
+  MPI_SAFE_CALL(MPI_Comm_group(nodeComm, &nodeGroup));
+  int nodeSend[2], nodeRecv[2];
+  MPI_SAFE_CALL(MPI_Group_translate_ranks(cartGroup, 2, procSend, nodeGroup, nodeSend));
+  MPI_SAFE_CALL(MPI_Group_translate_ranks(cartGroup, 2, procRecv, nodeGroup, nodeRecv));
+  MPI_SAFE_CALL(MPI_Group_free(&cartGroup));
+  MPI_SAFE_CALL(MPI_Group_free(&nodeGroup));
+
+  for(int face = 0 ; face < 2 ; face++) {
+    sharedSend[face] = haveHostBuffers && nodeSend[face] != MPI_UNDEFINED
+                                       && nodeSend[face] != MPI_PROC_NULL;
+    sharedRecv[face] = haveHostBuffers && nodeRecv[face] != MPI_UNDEFINED
+                                       && nodeRecv[face] != MPI_PROC_NULL;
+  }
+
+  // One window per send face (collective on the node), so that the neighbours find our buffers
+  for(int face = 0 ; face < 2 ; face++) {
+    const MPI_Aint size = sharedSend[face] ? bufferSizeSend[face]*sizeof(real) : 0;
+    real *base;
+    MPI_SAFE_CALL(MPI_Win_allocate_shared(size, sizeof(real), MPI_INFO_NULL, nodeComm,
+                                          &base, &sendWindow[face]));
+    // Passive access epoch for the whole life of the window, synchronised with MPI_Win_sync
+    MPI_SAFE_CALL(MPI_Win_lock_all(MPI_MODE_NOCHECK, sendWindow[face]));
+    if(sharedSend[face]) {
+      BufferSend[face] = Buffer(base, bufferSizeSend[face]);
+    }
+  }
+
+  // We receive on our left face what our left neighbour sends from its right face
+  for(int face = 0 ; face < 2 ; face++) {
+    doneSendRequest[face] = MPI_REQUEST_NULL;
+    doneRecvRequest[face] = MPI_REQUEST_NULL;
+    if(!sharedRecv[face]) continue;
+    const int peerFace = (face == faceLeft) ? faceRight : faceLeft;
+    MPI_Aint size;
+    int dispUnit;
+    real *base;
+    MPI_SAFE_CALL(MPI_Win_shared_query(sendWindow[peerFace], nodeRecv[face], &size, &dispUnit,
+                                       &base));
+    if(size != bufferSizeRecv[face]*sizeof(real)) {
+      IDEFIX_ERROR("Exchanger: the shared buffer of the neighbour does not match our ghost zones");
+    }
+    BufferPeer[face] = Buffer(base, bufferSizeRecv[face]);
+    // No MPI receive buffer needed on this face
+    BufferRecv[face] = Buffer(0);
+  }
+
+  // Handshakes telling the owner of a shared buffer that it has been read, tagged by the face of
+  // the buffer
+  for(int face = 0 ; face < 2 ; face++) {
+    const int peerFace = (face == faceLeft) ? faceRight : faceLeft;
+    if(sharedRecv[face]) {
+      MPI_SAFE_CALL(MPI_Send_init(nullptr, 0, MPI_BYTE, procRecv[face], thisInstance*4+2+peerFace,
+                                  grid->CartComm, &doneSendRequest[face]));
+    }
+    if(sharedSend[face]) {
+      MPI_SAFE_CALL(MPI_Recv_init(nullptr, 0, MPI_BYTE, procSend[face], thisInstance*4+2+face,
+                                  grid->CartComm, &doneRecvRequest[face]));
+    }
+  }
+}
+#endif // MPI_SHARED_MEMORY
+
 Exchanger::~Exchanger() {
   idfx::pushRegion("Exchanger::~Exchanger");
   if(isInitialized) {
@@ -167,17 +276,34 @@ Exchanger::~Exchanger() {
         MPI_Request_free( &recvRequest[i]);
       }
     #endif
+    #ifdef MPI_SHARED_MEMORY
+      for(int i=0 ; i< 2; i++) {
+        if(doneSendRequest[i] != MPI_REQUEST_NULL) MPI_Request_free(&doneSendRequest[i]);
+        if(doneRecvRequest[i] != MPI_REQUEST_NULL) MPI_Request_free(&doneRecvRequest[i]);
+        MPI_Win_unlock_all(sendWindow[i]);
+        MPI_Win_free(&sendWindow[i]);
+      }
+      MPI_Comm_free(&nodeComm);
+    #endif
     isInitialized = false;
   }
   idfx::popRegion();
 }
 
 void Exchanger::Exchange(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
+  Exchange(std::vector<IdefixArray4D<real>>{Vc}, std::vector<IdefixArray4D<real>>{Vs});
+}
+
+void Exchanger::Exchange(const std::vector<IdefixArray4D<real>> &Vc,
+                         const std::vector<IdefixArray4D<real>> &Vs) {
   idfx::pushRegion("Mpi::ExchangeX1");
+  const int nSets = mapVars.size();
+  if(Vc.size() != nSets || Vs.size() != nSets) {
+    IDEFIX_ERROR("Exchanger: the number of arrays does not match the number of field sets");
+  }
   // Load  the buffers with data
   Buffer BufferLeft = BufferSend[faceLeft];
   Buffer BufferRight = BufferSend[faceRight];
-  IdefixArray1D<int> map = this->mapVars;
 
   bool recvRight = (procRecv[faceRight] != MPI_PROC_NULL);
   bool recvLeft  = (procRecv[faceLeft] != MPI_PROC_NULL);
@@ -190,6 +316,11 @@ void Exchanger::Exchange(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
   MPI_Status recvStatus[2];
 
   MPI_Startall(2, recvRequest);
+  #ifdef MPI_SHARED_MEMORY
+    for(int face = 0 ; face < 2 ; face++) {
+      if(sharedSend[face]) MPI_Start(&doneRecvRequest[face]);
+    }
+  #endif
   idfx::mpiCallsTimer += MPI_Wtime() - tStart;
 #endif
   myTimer += MPI_Wtime();
@@ -197,13 +328,19 @@ void Exchanger::Exchange(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
   BufferLeft.ResetPointer();
   BufferRight.ResetPointer();
 
-  BufferLeft.Pack(Vc, map, boxSend[faceLeft]);
-  BufferRight.Pack(Vc, map, boxSend[faceRight]);
-  // Load face-centered field in the buffer
-  if(haveVs) {
-    for(int component = 0 ; component < DIMENSIONS ; component++) {
-      BufferLeft.Pack(Vs, component, boxSendVs[component][faceLeft]);
-      BufferRight.Pack(Vs, component, boxSendVs[component][faceRight]);
+  // All of the field sets are packed one after the other in the same buffers
+  for(int set = 0 ; set < nSets ; set++) {
+    IdefixArray1D<int> map = this->mapVars[set];
+    IdefixArray4D<real> VcSet = Vc[set];
+    IdefixArray4D<real> VsSet = Vs[set];
+    BufferLeft.Pack(VcSet, map, boxSend[faceLeft]);
+    BufferRight.Pack(VcSet, map, boxSend[faceRight]);
+    // Load face-centered field in the buffer
+    if(haveVs[set]) {
+      for(int component = 0 ; component < DIMENSIONS ; component++) {
+        BufferLeft.Pack(VsSet, component, boxSendVs[component][faceLeft]);
+        BufferRight.Pack(VsSet, component, boxSendVs[component][faceRight]);
+      }
     }
   }
 
@@ -212,9 +349,20 @@ void Exchanger::Exchange(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
   myTimer -= MPI_Wtime();
   tStart = MPI_Wtime();
 #ifdef MPI_PERSISTENT
+  #ifdef MPI_SHARED_MEMORY
+    // Make our shared buffers visible before the neighbours are told they are filled
+    for(int face = 0 ; face < 2 ; face++) {
+      if(sharedSend[face]) MPI_Win_sync(sendWindow[face]);
+    }
+  #endif
   MPI_Startall(2, sendRequest);
   // Wait for buffers to be received
   MPI_Waitall(2,recvRequest,recvStatus);
+  #ifdef MPI_SHARED_MEMORY
+    for(int face = 0 ; face < 2 ; face++) {
+      if(sharedRecv[face]) MPI_Win_sync(sendWindow[face == faceLeft ? faceRight : faceLeft]);
+    }
+  #endif
 
 #else
 
@@ -266,26 +414,31 @@ void Exchanger::Exchange(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
 #endif
 myTimer += MPI_Wtime();
 idfx::mpiCallsTimer += MPI_Wtime() - tStart;
-// Unpack
-BufferLeft=BufferRecv[faceLeft];
-BufferRight=BufferRecv[faceRight];
+// Unpack (directly from the buffers of the neighbours on the same node)
+BufferLeft = sharedRecv[faceLeft] ? BufferPeer[faceLeft] : BufferRecv[faceLeft];
+BufferRight = sharedRecv[faceRight] ? BufferPeer[faceRight] : BufferRecv[faceRight];
 
 BufferLeft.ResetPointer();
 BufferRight.ResetPointer();
 
-if(recvLeft) {
-    BufferLeft.Unpack(Vc, map, boxRecv[faceLeft]);
-  if(haveVs) {
-    for(int component = 0 ; component < DIMENSIONS ; component++) {
-      BufferLeft.Unpack(Vs, component, boxRecvVs[component][faceLeft]);
+for(int set = 0 ; set < nSets ; set++) {
+  IdefixArray1D<int> map = this->mapVars[set];
+  IdefixArray4D<real> VcSet = Vc[set];
+  IdefixArray4D<real> VsSet = Vs[set];
+  if(recvLeft) {
+    BufferLeft.Unpack(VcSet, map, boxRecv[faceLeft]);
+    if(haveVs[set]) {
+      for(int component = 0 ; component < DIMENSIONS ; component++) {
+        BufferLeft.Unpack(VsSet, component, boxRecvVs[component][faceLeft]);
+      }
     }
   }
-}
-if(recvRight) {
-  BufferRight.Unpack(Vc, map, boxRecv[faceRight]);
-  if(haveVs) {
-    for(int component = 0 ; component < DIMENSIONS ; component++) {
-      BufferRight.Unpack(Vs, component, boxRecvVs[component][faceRight]);
+  if(recvRight) {
+    BufferRight.Unpack(VcSet, map, boxRecv[faceRight]);
+    if(haveVs[set]) {
+      for(int component = 0 ; component < DIMENSIONS ; component++) {
+        BufferRight.Unpack(VsSet, component, boxRecvVs[component][faceRight]);
+      }
     }
   }
 }
@@ -297,6 +450,16 @@ myTimer -= MPI_Wtime();
 
 #ifdef MPI_PERSISTENT
   MPI_Waitall(2, sendRequest, sendStatus);
+#endif
+#ifdef MPI_SHARED_MEMORY
+  // Tell the neighbours we are done with their buffers, and wait until ours have been read
+  // before they can be filled again
+  Kokkos::fence();
+  for(int face = 0 ; face < 2 ; face++) {
+    if(sharedRecv[face]) MPI_Start(&doneSendRequest[face]);
+  }
+  MPI_Waitall(2, doneSendRequest, MPI_STATUSES_IGNORE);
+  MPI_Waitall(2, doneRecvRequest, MPI_STATUSES_IGNORE);
 #endif
   myTimer += MPI_Wtime();
   bytesSentOrReceived += (bufferSizeRecv[faceLeft]
@@ -304,5 +467,13 @@ myTimer -= MPI_Wtime();
                           +bufferSizeRecv[faceRight]
                           +bufferSizeSend[faceRight])*sizeof(real);
 
+  // Global message counters (shown in the integration log)
+  for(int face = 0 ; face < 2 ; face++) {
+    if(procSend[face] != MPI_PROC_NULL && !sharedSend[face]) {
+      idfx::mpiMessages++;
+      idfx::mpiBytes += bufferSizeSend[face]*sizeof(real);
+    }
+  }
+
   idfx::popRegion();
 }
@@ -20,6 +20,13 @@
 
 class Grid;
 
+// A set of variables exchanged together: a list of cell-centered variables, possibly
+// completed by a face-centered field. Several field sets can be packed in the same messages.
+struct ExchangeFieldSet {
+  std::vector<int> mapVars;   // indices of the cell-centered variables to be exchanged
+  bool haveVs{false};         // whether the face-centered field is also exchanged
+};
+
 class Exchanger {
  public:
   Exchanger() = default;
@@ -31,7 +38,18 @@ class Exchanger {
               bool inputHaveVs = false,
               std::array<bool,2> overwriteBXn = {true, true});
 
+  // Init for several field sets, which are exchanged in the same messages
+  void Init(  Grid* grid,
+              int direction,
+              std::vector<ExchangeFieldSet> fieldSets,
+              std::array<int, 3> nghost,
+              std::array<int, 3> nint,
+              std::array<bool,2> overwriteBXn = {true, true});
+
   void Exchange(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs);
+  // Exchange the field sets (Vc[n], Vs[n]), in the order used by Init
+  void Exchange(const std::vector<IdefixArray4D<real>> &Vc,
+                const std::vector<IdefixArray4D<real>> &Vs);
   ~Exchanger();
 
   static int nInstances;     // total number of mpi instances in the code
@@ -60,8 +78,8 @@ class Exchanger {
   int procRecv[2];  // MPI process to receive from in X1 direction
 
   int direction;
-  IdefixArray1D<int>  mapVars;
-  int mapNVars{0};
+  std::vector<IdefixArray1D<int>> mapVars;  // variables exchanged for each field set
+  std::vector<bool> haveVs;                 // face-centered field exchanged for each field set
 
   int nint[3];            //< number of internal elements of the arrays we treat
   int nghost[3];          //< number of ghost zone of the arrays we treat
@@ -69,12 +87,25 @@ class Exchanger {
   int beg[3];             //< begining index of the active zone
   int end[3];             //< end index of the active zone
 
-  bool haveVs{false};
-
   // Requests for MPI persistent communications
   MPI_Request sendRequest[2];
   MPI_Request recvRequest[2];
 
+  // Faces exchanged through the shared memory of the node. The persistent requests of these faces
+  // carry no data: they only tell the neighbour that our send buffer has been filled.
+  std::array<bool,2> sharedSend{false, false};  // neighbour to send to is on the same node
+  std::array<bool,2> sharedRecv{false, false};  // neighbour to receive from is on the same node
+  Buffer BufferPeer[2];   // send buffers of the neighbours on the same node (in their windows)
+
+  #ifdef MPI_SHARED_MEMORY
+  void InitSharedMemory();
+
+  MPI_Comm nodeComm;                // processes of the node
+  MPI_Win sendWindow[2];            // shared windows holding our send buffers
+  MPI_Request doneSendRequest[2];   // tell the neighbours that their buffers have been read
+  MPI_Request doneRecvRequest[2];   // wait for the neighbours to have read our buffers
+  #endif
+
   Grid *grid;
 };
 
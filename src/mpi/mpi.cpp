@@ -47,6 +47,24 @@ void Mpi::Init(Grid *grid, std::vector<int> inputMap,
                std::array<BoundaryType,3> lbound,
                std::array<BoundaryType,3> rbound,
                bool inputHaveVs) {
+  ExchangeFieldSet fieldSet;
+  fieldSet.mapVars = inputMap;
+  fieldSet.haveVs = inputHaveVs;
+  Init(grid, std::vector<ExchangeFieldSet>{fieldSet}, nghost, nint, lbound, rbound);
+}
+
+///
+/// Initialise an instance of the MPI class which exchanges several field sets at once.
+/// @param grid: pointer to the grid object (needed to get the MPI neighbours)
+/// @param fieldSets: list of the field sets packed in each message
+/// @param nghost: size of the ghost region in each direction
+/// @param nint: size of the internal region in each direction
+///
+
+void Mpi::Init(Grid *grid, std::vector<ExchangeFieldSet> fieldSets,
+               std::array<int,3> nghost, std::array<int,3> nint,
+               std::array<BoundaryType,3> lbound,
+               std::array<BoundaryType,3> rbound) {
   idfx::pushRegion("Mpi::Init");
 
   // increase the number of instances
@@ -62,9 +80,9 @@ void Mpi::Init(Grid *grid, std::vector<int> inputMap,
       overWriteBXn[faceRight] = false;
     }
 
-    exchanger[dir].Init(grid, dir, inputMap,
+    exchanger[dir].Init(grid, dir, fieldSets,
                           nghost, nint,
-                          inputHaveVs, overWriteBXn);
+                          overWriteBXn);
   }
 
   isInitialized = true;
@@ -120,6 +138,27 @@ void Mpi::ExchangeX3(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
 }
 
 
+void Mpi::ExchangeX1(const std::vector<IdefixArray4D<real>> &Vc,
+                     const std::vector<IdefixArray4D<real>> &Vs) {
+  idfx::pushRegion("Mpi::ExchangeX1");
+  exchanger[IDIR].Exchange(Vc, Vs);
+  idfx::popRegion();
+}
+
+void Mpi::ExchangeX2(const std::vector<IdefixArray4D<real>> &Vc,
+                     const std::vector<IdefixArray4D<real>> &Vs) {
+  idfx::pushRegion("Mpi::ExchangeX2");
+  exchanger[JDIR].Exchange(Vc, Vs);
+  idfx::popRegion();
+}
+
+void Mpi::ExchangeX3(const std::vector<IdefixArray4D<real>> &Vc,
+                     const std::vector<IdefixArray4D<real>> &Vs) {
+  idfx::pushRegion("Mpi::ExchangeX3");
+  exchanger[KDIR].Exchange(Vc, Vs);
+  idfx::popRegion();
+}
+
 void Mpi::CheckConfig() {
   idfx::pushRegion("Mpi::CheckConfig");
   // compile time check
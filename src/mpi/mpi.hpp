@@ -37,6 +37,14 @@ class Mpi {
                 IdefixArray4D<real> inputVs = IdefixArray4D<real>());
                                       ///< Exchange boundary elements in the X3 direction
 
+  // Coalesced exchanges of several field sets (Vc[n],Vs[n]) in the same messages
+  void ExchangeX1(const std::vector<IdefixArray4D<real>> &,
+                  const std::vector<IdefixArray4D<real>> &);
+  void ExchangeX2(const std::vector<IdefixArray4D<real>> &,
+                  const std::vector<IdefixArray4D<real>> &);
+  void ExchangeX3(const std::vector<IdefixArray4D<real>> &,
+                  const std::vector<IdefixArray4D<real>> &);
+
   // Init from datablock
   void Init(Grid *grid, std::vector<int> inputMap,
             std::array<int,3> nghost, std::array<int,3> nint,
@@ -44,6 +52,12 @@ class Mpi {
             std::array<BoundaryType,3> rbound,
             bool inputHaveVs = false );
 
+  // Init for several field sets exchanged together
+  void Init(Grid *grid, std::vector<ExchangeFieldSet> fieldSets,
+            std::array<int,3> nghost, std::array<int,3> nint,
+            std::array<BoundaryType,3> lbound,
+            std::array<BoundaryType,3> rbound);
+
   // Check that MPI will work with the designated target (in particular GPU Direct)
   static void CheckConfig();
 
@@ -976,6 +976,8 @@ int Dump::Write(Output& output) {
   fclose(fileHdl);
 #endif
 
+  // Keep the measured cost map with the dump, for restarts with balanced subdomains
+  if(data->mygrid->haveLoadBalancing) data->mygrid->WriteCostMap();
 
   idfx::cout << "done in " << timer.seconds() << " s." << std::endl;
   idfx::popRegion();
@@ -6,8 +6,10 @@
 // ***********************************************************************************
 
 #include <algorithm>
+#include <fstream>
 #include <iomanip>
 #include <mutex>    // NOLINT [build/c++11]
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -53,6 +55,16 @@ const char* label, const void* const ptr, const uint64_t size) {
   idfx::prof.spaceSize[space_i] -= size;
 }
 
+// Kernel hooks (only enabled with performance profiling, to get per-kernel counters)
+extern "C" void kokkosp_begin_kernel(const char* name, const uint32_t devID, uint64_t* kID) {
+  *kID = 0;
+  idfx::prof.BeginKernel(name);
+}
+
+extern "C" void kokkosp_end_kernel(const uint64_t kID) {
+  idfx::prof.EndKernel();
+}
+
 ///////////////////////////////////
 // Profiler function definitions //
 ///////////////////////////////////
@@ -76,21 +88,29 @@ void idfx::Profiler::Init() {
 }
 
 void idfx::Profiler::Show() {
-  double usedMemory{-1};
-
   // follow ISO/IEC 80000
   constexpr int nUnits = 5;
   const std::array<std::string,nUnits> units {"B", "KB", "MB", "GB", "TB"};
 
-  for(int i=0; i < this->numSpaces ; i++) {
-    usedMemory = this->spaceMax[i];
+  auto formatSize = [&units](double size) {
     int count{0};
-    while(count < nUnits && usedMemory/1024 >= 1) {
-      usedMemory /= 1024;
+    while(count < nUnits-1 && size/1024 >= 1) {
+      size /= 1024;
       ++count;
     }
+    std::ostringstream out;
+    out << size << " " << units[count];
+    return out.str();
+  };
+
+  for(int i=0; i < this->numSpaces ; i++) {
     idfx::cout << "Profiler: maximum memory usage for " << this->spaceName[i];
-    idfx::cout << " memory space: " << usedMemory << " " << units[count] << std::endl;
+    idfx::cout << " memory space: " << formatSize(this->spaceMax[i]) << std::endl;
+  }
+  if(scratchRequested > 0) {
+    idfx::cout << "Profiler: scratch arrays: " << formatSize(scratchAllocated)
+               << " allocated (peak) for " << formatSize(scratchRequested)
+               << " requested (sum of allocations)." << std::endl;
   }
 
   if(perfEnabled) {
@@ -106,14 +126,128 @@ void idfx::Profiler::Show() {
     rootRegion.Show(rootRegion.GetTimer());
     idfx::cout << "-------------------------------------------------------------------------------";
     idfx::cout << std::endl;
+    ShowKernels();
+    WriteKernelCounters();
     idfx::cout << "Profiler: end of performance profiling report." << std::endl;
   }
 }
 
+void idfx::Profiler::RegisterScratch(int64_t requested, int64_t allocated) {
+  scratchRequested += requested;
+  scratchAllocated += allocated;
+}
+
 void idfx::Profiler::EnablePerformanceProfiling() {
   currentRegion = &rootRegion;
   rootRegion.Start();
   perfEnabled = true;
+
+  // enroll kernel callbacks
+  Kokkos::Tools::Experimental::set_begin_parallel_for_callback(&kokkosp_begin_kernel);
+  Kokkos::Tools::Experimental::set_end_parallel_for_callback(&kokkosp_end_kernel);
+  Kokkos::Tools::Experimental::set_begin_parallel_reduce_callback(&kokkosp_begin_kernel);
+  Kokkos::Tools::Experimental::set_end_parallel_reduce_callback(&kokkosp_end_kernel);
+  Kokkos::Tools::Experimental::set_begin_parallel_scan_callback(&kokkosp_begin_kernel);
+  Kokkos::Tools::Experimental::set_end_parallel_scan_callback(&kokkosp_end_kernel);
+}
+
+void idfx::Profiler::AnnotateKernel(const std::string &name, double bytesPerIteration,
+                                    double flopsPerIteration) {
+  KernelCounter &kernel = kernels[name];
+  kernel.bytesPerIteration = bytesPerIteration;
+  kernel.flopsPerIteration = flopsPerIteration;
+}
+
+void idfx::Profiler::BeginKernel(const char *name) {
+  currentKernel = &kernels[std::string(name)];
+  currentKernel->nLaunches++;
+  currentKernel->nIterations += nextLoopSize;
+  // Kernels that are not launched by idefix_for (e.g. Kokkos internals) have no size
+  nextLoopSize = 0;
+  kernelTimer.reset();
+}
+
+void idfx::Profiler::EndKernel() {
+  // Kernels are asynchronous on GPUs: wait for completion before measuring
+  Kokkos::fence();
+  if(currentKernel != nullptr) {
+    currentKernel->time += kernelTimer.seconds();
+    currentKernel = nullptr;
+  }
+}
+
+void idfx::Profiler::ShowKernels() {
+  // Sort the kernels by accumulated time
+  std::vector<std::pair<std::string, KernelCounter>> sorted(kernels.begin(), kernels.end());
+  std::sort(sorted.begin(), sorted.end(),
+            [](const auto &a, const auto &b) { return a.second.time > b.second.time; });
+
+  constexpr int nShown = 20;
+  idfx::cout << "Profiler: most expensive kernels (full list in kernels.csv/kernels.json): ";
+  idfx::cout << std::endl;
+  idfx::cout << "-------------------------------------------------------------------------------";
+  idfx::cout << std::endl;
+  idfx::cout << "<total time>  <% of total time>  <launches>  <cell updates/s>  <GB/s>  <name>";
+  idfx::cout << std::endl;
+  idfx::cout << "-------------------------------------------------------------------------------";
+  idfx::cout << std::endl;
+  const double totTime = rootRegion.GetTimer();
+  for(int n = 0 ; n < std::min(nShown, static_cast<int>(sorted.size())) ; n++) {
+    const KernelCounter &kernel = sorted[n].second;
+    if(kernel.nLaunches == 0) continue;
+    idfx::cout << std::scientific << std::setprecision(2) << kernel.time << " sec  "
+               << std::fixed << std::setprecision(1) << kernel.time/totTime*100 << "%  "
+               << kernel.nLaunches << "  "
+               << std::scientific << std::setprecision(2)
+               << (kernel.time > 0 ? kernel.nIterations/kernel.time : 0) << "  ";
+    if(kernel.bytesPerIteration > 0 && kernel.time > 0) {
+      idfx::cout << std::fixed << std::setprecision(1)
+                 << kernel.bytesPerIteration*kernel.nIterations/kernel.time/1e9 << "  ";
+    } else {
+      idfx::cout << "-  ";
+    }
+    idfx::cout << sorted[n].first << std::endl;
+  }
+  idfx::cout << "-------------------------------------------------------------------------------";
+  idfx::cout << std::endl;
+}
+
+void idfx::Profiler::WriteKernelCounters() {
+  if(idfx::prank != 0 || !writeEnabled) return;
+
+  std::ofstream csv("kernels.csv");
+  std::ofstream json("kernels.json");
+  csv << "name,launches,iterations,time,cell_updates_per_s,bytes,GB_per_s,flops,GFlop_per_s"
+      << std::endl;
+  json << "[" << std::endl;
+  bool first = true;
+  for(auto const &it : kernels) {
+    const KernelCounter &kernel = it.second;
+    if(kernel.nLaunches == 0) continue;
+    const double cellRate = kernel.time > 0 ? kernel.nIterations/kernel.time : 0;
+    const double bytes = kernel.bytesPerIteration*kernel.nIterations;
+    const double flops = kernel.flopsPerIteration*kernel.nIterations;
+    const double bandwidth = kernel.time > 0 ? bytes/kernel.time/1e9 : 0;
+    const double flopRate = kernel.time > 0 ? flops/kernel.time/1e9 : 0;
+
+    csv << "\"" << it.first << "\"," << kernel.nLaunches << "," << kernel.nIterations << ","
+        << std::scientific << std::setprecision(6)
+        << kernel.time << "," << cellRate << "," << bytes << "," << bandwidth << ","
+        << flops << "," << flopRate << std::endl;
+
+    if(!first) json << "," << std::endl;
+    first = false;
+    json << "  {\"name\": \"" << it.first << "\", \"launches\": " << kernel.nLaunches
+         << ", \"iterations\": " << kernel.nIterations
+         << std::scientific << std::setprecision(6)
+         << ", \"time\": " << kernel.time
+         << ", \"cell_updates_per_s\": " << cellRate
+         << ", \"bytes\": " << bytes
+         << ", \"GB_per_s\": " << bandwidth
+         << ", \"flops\": " << flops
+         << ", \"GFlop_per_s\": " << flopRate << "}";
+  }
+  json << std::endl << "]" << std::endl;
 }
 
 
@@ -11,6 +11,7 @@
 #include <map>
 #include <mutex>  // NOLINT [build/c++11]
 #include <string>
+#include <vector>
 
 namespace idfx {
 
@@ -44,11 +45,26 @@ class Region {
 };
 
 
+// KernelCounter accumulates the statistics of all the kernels sharing the same name
+struct KernelCounter {
+  int64_t nLaunches{0};             ///< number of launches
+  int64_t nIterations{0};           ///< total number of loop iterations (cells)
+  double time{0};                   ///< accumulated time (s)
+  double bytesPerIteration{0};      ///< user-annotated memory traffic per iteration
+  double flopsPerIteration{0};      ///< user-annotated floating point operations per iteration
+};
+
 class Profiler {
  public:
   void Init();
   void Show();
   void EnablePerformanceProfiling();
+  void AnnotateKernel(const std::string &, double, double);
+  void BeginKernel(const char *);
+  void EndKernel();
+  void ShowKernels();
+  void WriteKernelCounters();
+  void RegisterScratch(int64_t, int64_t);
   int numSpaces;
   int64_t spaceSize[16];
   int64_t spaceMax[16];
@@ -56,8 +72,20 @@ class Profiler {
   std::mutex m;
 
   bool perfEnabled{false};
+  bool writeEnabled{true};          ///< whether kernel counters are written to disk
   Region rootRegion;
   Region *currentRegion;
+
+  // Kernel counters
+  std::map<std::string, KernelCounter> kernels;
+  int64_t nextLoopSize{0};          ///< size of the next loop launched by idefix_for
+
+  // Scratch arrays
+  int64_t scratchRequested{0};      ///< sum of the sizes of the scratch arrays (bytes)
+  int64_t scratchAllocated{0};      ///< memory allocated by the scratch arenas (bytes)
+ private:
+  KernelCounter *currentKernel{nullptr};
+  Kokkos::Timer kernelTimer;
 };
 
 
@@ -24,6 +24,14 @@
   #endif
 #endif // SINGLE_PRECISION
 
+// Type used to store the intercell fluxes. In mixed precision, the fluxes are stored
+// in single precision while the conservative variables are evolved in double precision
+#ifdef MIXED_PRECISION
+  using flux_real = float;
+#else
+  using flux_real = real;
+#endif // MIXED_PRECISION
+
 // math function
 #ifdef SINGLE_PRECISION
 
@@ -26,8 +26,9 @@ inline void idefix_reduce(const std::string & NAME,
     #ifdef DEBUG
     idfx::pushRegion("idefix_reduce("+NAME+")");
     #endif
+    idfx::setLoopSize(static_cast<int64_t>(IE-IB));
     Kokkos::parallel_reduce(NAME,
-      Kokkos::RangePolicy<>(IB,IE), function, redFunction);
+      Kokkos::RangePolicy<>(idfx::getExecSpace(),IB,IE), function, redFunction);
     #ifdef DEBUG
     Kokkos::fence();
     idfx::popRegion();
@@ -44,12 +45,13 @@ inline void idefix_reduce(const std::string & NAME,
     #ifdef DEBUG
     idfx::pushRegion("idefix_reduce("+NAME+")");
     #endif
+    idfx::setLoopSize(static_cast<int64_t>(JE-JB)*(IE-IB));
 
     // We only implement MDRange reductions here since the other implementations are too
     // complicated to be implemented for any reduction operator on any class
     Kokkos::parallel_reduce(NAME,
       Kokkos::MDRangePolicy<Kokkos::Rank<2, Kokkos::Iterate::Right, Kokkos::Iterate::Right>>
-        ({JB,IB},{JE,IE}), function, redFunction);
+        (idfx::getExecSpace(), {JB,IB},{JE,IE}), function, redFunction);
 
     #ifdef DEBUG
     Kokkos::fence();
@@ -70,9 +72,10 @@ inline void idefix_reduce(const std::string & NAME,
     #ifdef DEBUG
     idfx::pushRegion("idefix_reduce("+NAME+")");
     #endif
+    idfx::setLoopSize(static_cast<int64_t>(KE-KB)*(JE-JB)*(IE-IB));
     Kokkos::parallel_reduce(NAME,
       Kokkos::MDRangePolicy<Kokkos::Rank<3, Kokkos::Iterate::Right, Kokkos::Iterate::Right>>
-        ({KB,JB,IB},{KE,JE,IE}), function, redFunction);
+        (idfx::getExecSpace(), {KB,JB,IB},{KE,JE,IE}), function, redFunction);
 
     #ifdef DEBUG
     Kokkos::fence();
@@ -94,9 +97,11 @@ inline void idefix_reduce(const std::string & NAME,
     #ifdef DEBUG
     idfx::pushRegion("idefix_reduce("+NAME+")");
     #endif
+    // Kernel counters are in cells: the variable extent n is not counted
+    idfx::setLoopSize(static_cast<int64_t>(KE-KB)*(JE-JB)*(IE-IB));
     Kokkos::parallel_reduce(NAME,
       Kokkos::MDRangePolicy<Kokkos::Rank<4, Kokkos::Iterate::Right, Kokkos::Iterate::Right>>
-        ({NB,KB,JB,IB},{NE,KE,JE,IE}), function, redFunction);
+        (idfx::getExecSpace(), {NB,KB,JB,IB},{NE,KE,JE,IE}), function, redFunction);
 
     #ifdef DEBUG
     Kokkos::fence();
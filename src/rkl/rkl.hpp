@@ -16,6 +16,7 @@
 #include "dataBlock.hpp"
 #include "viscosity.hpp"
 #include "bragViscosity.hpp"
+#include "reductionManager.hpp"
 #ifdef WITH_MPI
 #include "mpi.hpp"
 #endif
@@ -203,52 +204,30 @@ RKLegendre<Phys>::RKLegendre(Input &input, Fluid<Phys>* hydroin) {
   #endif
 
 
-  // Variable allocation
+  // Variable allocation. These arrays are only used within an RKL cycle, so that they can
+  // share memory with the scratch arrays of other phases
+  ScratchArena &scratch = data->scratch;
+  const int lifetime = ScratchArena::rklPhase;
+  const int nk = data->np_tot[KDIR];
+  const int nj = data->np_tot[JDIR];
+  const int ni = data->np_tot[IDIR];
 
-  dU = IdefixArray4D<real>("RKL_dU", NVAR,
-                           data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-  dU0 = IdefixArray4D<real>("RKL_dU0", NVAR,
-                           data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-  Uc0 = IdefixArray4D<real>("RKL_Uc0", NVAR,
-                           data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-  Uc1 = IdefixArray4D<real>("RKL_Uc1", NVAR,
-                           data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
+  scratch.Request(dU, "RKL_dU", lifetime, NVAR, nk, nj, ni);
+  scratch.Request(dU0, "RKL_dU0", lifetime, NVAR, nk, nj, ni);
+  scratch.Request(Uc0, "RKL_Uc0", lifetime, NVAR, nk, nj, ni);
+  scratch.Request(Uc1, "RKL_Uc1", lifetime, NVAR, nk, nj, ni);
 
   if(haveVs) {
     #ifdef EVOLVE_VECTOR_POTENTIAL
-      dA = IdefixArray4D<real>("RKL_dA", AX3e+1,
-                      data->np_tot[KDIR]+KOFFSET,
-                      data->np_tot[JDIR]+JOFFSET,
-                      data->np_tot[IDIR]+IOFFSET);
-      dA0 = IdefixArray4D<real>("RKL_dA0", AX3e+1,
-                        data->np_tot[KDIR]+KOFFSET,
-                        data->np_tot[JDIR]+JOFFSET,
-                        data->np_tot[IDIR]+IOFFSET);
-      Ve0 = IdefixArray4D<real>("RKL_Ve0", AX3e+1,
-                        data->np_tot[KDIR]+KOFFSET,
-                        data->np_tot[JDIR]+JOFFSET,
-                        data->np_tot[IDIR]+IOFFSET);
-      Ve1 = IdefixArray4D<real>("RKL_Ve1", AX3e+1,
-                        data->np_tot[KDIR]+KOFFSET,
-                        data->np_tot[JDIR]+JOFFSET,
-                        data->np_tot[IDIR]+IOFFSET);
+      scratch.Request(dA, "RKL_dA", lifetime, AX3e+1, nk+KOFFSET, nj+JOFFSET, ni+IOFFSET);
+      scratch.Request(dA0, "RKL_dA0", lifetime, AX3e+1, nk+KOFFSET, nj+JOFFSET, ni+IOFFSET);
+      scratch.Request(Ve0, "RKL_Ve0", lifetime, AX3e+1, nk+KOFFSET, nj+JOFFSET, ni+IOFFSET);
+      scratch.Request(Ve1, "RKL_Ve1", lifetime, AX3e+1, nk+KOFFSET, nj+JOFFSET, ni+IOFFSET);
     #else
-      dB = IdefixArray4D<real>("RKL_dB", DIMENSIONS,
-                        data->np_tot[KDIR]+KOFFSET,
-                        data->np_tot[JDIR]+JOFFSET,
-                        data->np_tot[IDIR]+IOFFSET);
-      dB0 = IdefixArray4D<real>("RKL_dB0", DIMENSIONS,
-                        data->np_tot[KDIR]+KOFFSET,
-                        data->np_tot[JDIR]+JOFFSET,
-                        data->np_tot[IDIR]+IOFFSET);
-      Vs0 = IdefixArray4D<real>("RKL_Vs0", DIMENSIONS,
-                        data->np_tot[KDIR]+KOFFSET,
-                        data->np_tot[JDIR]+JOFFSET,
-                        data->np_tot[IDIR]+IOFFSET);
-      Vs1 = IdefixArray4D<real>("RKL_Vs1", DIMENSIONS,
-                        data->np_tot[KDIR]+KOFFSET,
-                        data->np_tot[JDIR]+JOFFSET,
-                        data->np_tot[IDIR]+IOFFSET);
+      scratch.Request(dB, "RKL_dB", lifetime, DIMENSIONS, nk+KOFFSET, nj+JOFFSET, ni+IOFFSET);
+      scratch.Request(dB0, "RKL_dB0", lifetime, DIMENSIONS, nk+KOFFSET, nj+JOFFSET, ni+IOFFSET);
+      scratch.Request(Vs0, "RKL_Vs0", lifetime, DIMENSIONS, nk+KOFFSET, nj+JOFFSET, ni+IOFFSET);
+      scratch.Request(Vs1, "RKL_Vs1", lifetime, DIMENSIONS, nk+KOFFSET, nj+JOFFSET, ni+IOFFSET);
     #endif
   }
 
@@ -558,7 +537,7 @@ void RKLegendre<Phys>::Cycle() {
 template<typename Phys>
 void RKLegendre<Phys>::ResetFlux() {
   idfx::pushRegion("RKLegendre::ResetFlux");
-  IdefixArray4D<real> Flux = hydro->FluxRiemann;
+  IdefixArray4D<flux_real> Flux = hydro->FluxRiemann;
   IdefixArray1D<int> vars = this->varList;
   idefix_for("RKL_ResetFlux",
              0,nvarRKL,
@@ -597,7 +576,7 @@ struct RKLegendre_ResetStageFunctor {
   }
 
   IdefixArray4D<real> dU;
-  IdefixArray4D<real> Flux;
+  IdefixArray4D<flux_real> Flux;
   IdefixArray1D<int> vars;
   IdefixArray4D<real> dA, dB;
   IdefixArray3D<real> ex,ey,ez;
@@ -666,11 +645,7 @@ void RKLegendre<Phys>::ComputeDt() {
     Kokkos::Max<real>(newinvdt)
   );
 
-#ifdef WITH_MPI
-  if(idfx::psize>1) {
-    MPI_SAFE_CALL(MPI_Allreduce(MPI_IN_PLACE, &newinvdt, 1, realMPI, MPI_MAX, MPI_COMM_WORLD));
-  }
-#endif
+  newinvdt = idfx::reductions.Reduce(newinvdt, idfx::ReductionManager::max);
 
   dt = 1.0/newinvdt;
   dt = (cfl_rkl*dt)/2.0; // parabolic time step
@@ -705,7 +680,10 @@ void RKLegendre<Phys>::EvolveStage(real t) {
   if(haveVs && hydro->needRKLCurrent) hydro->CalcCurrent();
 
   // Loop on dimensions for the parabolic fluxes and RHS, starting from IDIR
-  if(haveVc || stage == 1) LoopDir<IDIR>(t);
+  if(haveVc || stage == 1) {
+    hydro->UpdateDiffusivities(t, RKLContext);
+    LoopDir<IDIR>(t);
+  }
 
   if(haveVs) {
     hydro->emf->CalcNonidealEMF(t);
@@ -725,7 +703,7 @@ template <int dir>
 void RKLegendre<Phys>::CalcParabolicRHS(real t) {
   idfx::pushRegion("RKLegendre::CalcParabolicRHS");
 
-  IdefixArray4D<real> Flux = hydro->FluxRiemann;
+  IdefixArray4D<flux_real> Flux = hydro->FluxRiemann;
   IdefixArray3D<real> A    = data->A[dir];
   IdefixArray3D<real> dV   = data->dV;
   IdefixArray1D<real> x1m  = data->xl[IDIR];
@@ -816,7 +794,7 @@ void RKLegendre<Phys>::CalcParabolicRHS(real t) {
 
       const int nv = varList(n);
 
-      rhs = -  ( Flux(nv, k+koffset, j+joffset, i+ioffset)
+      rhs = -  (static_cast<real>(Flux(nv, k+koffset, j+joffset, i+ioffset))
                      - Flux(nv, k, j, i))/dV(k,j,i);
 
       // Viscosity source terms
@@ -840,12 +818,13 @@ void RKLegendre<Phys>::CalcParabolicRHS(real t) {
 
     if constexpr(Phys::mhd) {
       #if (GEOMETRY == POLAR || GEOMETRY == CYLINDRICAL) &&  (defined iBPHI)
-        if(nv==iBPHI) rhs = - 1 / dx_ * (Flux(iBPHI, k, j, i+1) - Flux(iBPHI, k, j, i) );
+        if(nv==iBPHI) rhs = - 1 / dx_ * (static_cast<real>(Flux(iBPHI, k, j, i+1))
+                                         - Flux(iBPHI, k, j, i) );
 
       #elif (GEOMETRY == SPHERICAL)
         real q = 1 / (x1_*dx_);
         if(nv == BX2 || nv == BX3) {
-          rhs = -q * ((Flux(nv, k, j, i+1)  - Flux(nv, k, j, i) ));
+          rhs = -q * ((static_cast<real>(Flux(nv, k, j, i+1))  - Flux(nv, k, j, i) ));
         }
       #endif // GEOMETRY
     } // MHD
@@ -859,7 +838,7 @@ void RKLegendre<Phys>::CalcParabolicRHS(real t) {
       real rt_ = rt(i);
       if constexpr(Phys::mhd) {
         if(nv == iBPHI) {
-          rhs = - 1 / (rt_*dx_) * (Flux(nv, k, j+1, i) - Flux(nv, k, j, i));
+          rhs = - 1 / (rt_*dx_) * (static_cast<real>(Flux(nv, k, j+1, i)) - Flux(nv, k, j, i));
         }
       }
     #endif // GEOMETRY
@@ -0,0 +1,206 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef SIMDBATCH_HPP_
+#define SIMDBATCH_HPP_
+
+#include <cmath>
+#include "idefix.hpp"
+
+// Thin wrapper around a fixed number of reals, used to process W interfaces per call in the
+// Riemann solvers (Idefix_SIMD_WIDTH cmake option). All of the operations are lane-wise
+// loops of compile-time length, which compilers map onto vector instructions.
+// Helpers which are templated on their value type (K_Flux, K_PrimToCons...) accept either
+// real or Batch<W>. Since batches are compared lane-wise, data-dependent branches have to be
+// written with select() instead of if/else or ternaries.
+namespace idfx {
+
+template<int W>
+struct BatchMask {
+  bool m[W];
+
+  KOKKOS_FORCEINLINE_FUNCTION bool operator[](const int w) const { return m[w]; }
+  KOKKOS_FORCEINLINE_FUNCTION bool &operator[](const int w) { return m[w]; }
+};
+
+template<int W>
+struct Batch {
+  static constexpr int width = W;
+  real v[W];
+
+  Batch() = default;
+  // Broadcast a scalar to all of the lanes
+  KOKKOS_FORCEINLINE_FUNCTION Batch(const real x) {   // NOLINT(runtime/explicit)
+    for(int w = 0 ; w < W ; w++) v[w] = x;
+  }
+
+  KOKKOS_FORCEINLINE_FUNCTION real operator[](const int w) const { return v[w]; }
+  KOKKOS_FORCEINLINE_FUNCTION real &operator[](const int w) { return v[w]; }
+
+  KOKKOS_FORCEINLINE_FUNCTION Batch operator-() const {
+    Batch r;
+    for(int w = 0 ; w < W ; w++) r.v[w] = -v[w];
+    return r;
+  }
+};
+
+// Arithmetic operators between batches, and between batches and scalars
+#define IDEFIX_BATCH_OPERATOR(OP)                                                              \
+  template<int W>                                                                              \
+  KOKKOS_FORCEINLINE_FUNCTION Batch<W> operator OP(const Batch<W> &a, const Batch<W> &b) {     \
+    Batch<W> r;                                                                                \
+    for(int w = 0 ; w < W ; w++) r.v[w] = a.v[w] OP b.v[w];                                    \
+    return r;                                                                                  \
+  }                                                                                            \
+  template<int W>                                                                              \
+  KOKKOS_FORCEINLINE_FUNCTION Batch<W> operator OP(const Batch<W> &a, const real b) {          \
+    Batch<W> r;                                                                                \
+    for(int w = 0 ; w < W ; w++) r.v[w] = a.v[w] OP b;                                         \
+    return r;                                                                                  \
+  }                                                                                            \
+  template<int W>                                                                              \
+  KOKKOS_FORCEINLINE_FUNCTION Batch<W> operator OP(const real a, const Batch<W> &b) {          \
+    Batch<W> r;                                                                                \
+    for(int w = 0 ; w < W ; w++) r.v[w] = a OP b.v[w];                                         \
+    return r;                                                                                  \
+  }                                                                                            \
+  template<int W>                                                                              \
+  KOKKOS_FORCEINLINE_FUNCTION Batch<W> &operator OP##=(Batch<W> &a, const Batch<W> &b) {       \
+    for(int w = 0 ; w < W ; w++) a.v[w] OP##= b.v[w];                                          \
+    return a;                                                                                  \
+  }                                                                                            \
+  template<int W>                                                                              \
+  KOKKOS_FORCEINLINE_FUNCTION Batch<W> &operator OP##=(Batch<W> &a, const real b) {            \
+    for(int w = 0 ; w < W ; w++) a.v[w] OP##= b;                                               \
+    return a;                                                                                  \
+  }
+
+IDEFIX_BATCH_OPERATOR(+)
+IDEFIX_BATCH_OPERATOR(-)
+IDEFIX_BATCH_OPERATOR(*)
+IDEFIX_BATCH_OPERATOR(/)
+#undef IDEFIX_BATCH_OPERATOR
+
+// Lane-wise comparisons
+#define IDEFIX_BATCH_COMPARISON(OP)                                                            \
+  template<int W>                                                                              \
+  KOKKOS_FORCEINLINE_FUNCTION BatchMask<W> operator OP(const Batch<W> &a, const Batch<W> &b) { \
+    BatchMask<W> r;                                                                            \
+    for(int w = 0 ; w < W ; w++) r.m[w] = a.v[w] OP b.v[w];                                    \
+    return r;                                                                                  \
+  }                                                                                            \
+  template<int W>                                                                              \
+  KOKKOS_FORCEINLINE_FUNCTION BatchMask<W> operator OP(const Batch<W> &a, const real b) {      \
+    BatchMask<W> r;                                                                            \
+    for(int w = 0 ; w < W ; w++) r.m[w] = a.v[w] OP b;                                         \
+    return r;                                                                                  \
+  }                                                                                            \
+  template<int W>                                                                              \
+  KOKKOS_FORCEINLINE_FUNCTION BatchMask<W> operator OP(const real a, const Batch<W> &b) {      \
+    BatchMask<W> r;                                                                            \
+    for(int w = 0 ; w < W ; w++) r.m[w] = a OP b.v[w];                                         \
+    return r;                                                                                  \
+  }
+
+IDEFIX_BATCH_COMPARISON(<)
+IDEFIX_BATCH_COMPARISON(>)
+IDEFIX_BATCH_COMPARISON(<=)
+IDEFIX_BATCH_COMPARISON(>=)
+#undef IDEFIX_BATCH_COMPARISON
+
+template<int W>
+KOKKOS_FORCEINLINE_FUNCTION BatchMask<W> operator||(const BatchMask<W> &a,
+                                                    const BatchMask<W> &b) {
+  BatchMask<W> r;
+  for(int w = 0 ; w < W ; w++) r.m[w] = a.m[w] || b.m[w];
+  return r;
+}
+
+template<int W>
+KOKKOS_FORCEINLINE_FUNCTION BatchMask<W> operator&&(const BatchMask<W> &a,
+                                                    const BatchMask<W> &b) {
+  BatchMask<W> r;
+  for(int w = 0 ; w < W ; w++) r.m[w] = a.m[w] && b.m[w];
+  return r;
+}
+
+// select(mask, a, b) is the lane-wise equivalent of mask ? a : b
+KOKKOS_FORCEINLINE_FUNCTION real select(const bool mask, const real a, const real b) {
+  return(mask ? a : b);
+}
+
+template<int W>
+KOKKOS_FORCEINLINE_FUNCTION Batch<W> select(const BatchMask<W> &mask,
+                                            const Batch<W> &a, const Batch<W> &b) {
+  Batch<W> r;
+  for(int w = 0 ; w < W ; w++) r.v[w] = mask.m[w] ? a.v[w] : b.v[w];
+  return r;
+}
+
+// Math functions, found by argument dependent lookup for batches
+#define IDEFIX_BATCH_FUNCTION1(FUNC)                                                           \
+  template<int W>                                                                              \
+  KOKKOS_FORCEINLINE_FUNCTION Batch<W> FUNC(const Batch<W> &a) {                               \
+    Batch<W> r;                                                                                \
+    for(int w = 0 ; w < W ; w++) r.v[w] = std::FUNC(a.v[w]);                                   \
+    return r;                                                                                  \
+  }
+
+#define IDEFIX_BATCH_FUNCTION2(FUNC)                                                           \
+  template<int W>                                                                              \
+  KOKKOS_FORCEINLINE_FUNCTION Batch<W> FUNC(const Batch<W> &a, const Batch<W> &b) {            \
+    Batch<W> r;                                                                                \
+    for(int w = 0 ; w < W ; w++) r.v[w] = std::FUNC(a.v[w], b.v[w]);                           \
+    return r;                                                                                  \
+  }
+
+IDEFIX_BATCH_FUNCTION1(sqrt)
+IDEFIX_BATCH_FUNCTION1(fabs)
+IDEFIX_BATCH_FUNCTION2(fmin)
+IDEFIX_BATCH_FUNCTION2(fmax)
+#undef IDEFIX_BATCH_FUNCTION1
+#undef IDEFIX_BATCH_FUNCTION2
+
+// Index of lane w of a batch starting at i0, in a loop which ends at iend (excluded). Lanes
+// past the end of the loop duplicate the last index, and their results should not be stored.
+KOKKOS_FORCEINLINE_FUNCTION int BatchIndex(const int i0, const int w, const int iend) {
+  return(i0 + w < iend ? i0 + w : iend - 1);
+}
+
+// Equation of state evaluated on the value type of the caller. Scalars are forwarded to the
+// eos, while batches are evaluated lane by lane, so that any equation of state (including
+// user-defined ones) can be used with batches.
+template<typename EOS>
+KOKKOS_FORCEINLINE_FUNCTION real GetGamma(const EOS &eos, const real P, const real rho) {
+  return(eos.GetGamma(P,rho));
+}
+
+template<typename EOS, int W>
+KOKKOS_FORCEINLINE_FUNCTION Batch<W> GetGamma(const EOS &eos, const Batch<W> &P,
+                                                             const Batch<W> &rho) {
+  Batch<W> r;
+  for(int w = 0 ; w < W ; w++) r.v[w] = eos.GetGamma(P.v[w],rho.v[w]);
+  return r;
+}
+
+template<typename EOS>
+KOKKOS_FORCEINLINE_FUNCTION real GetInternalEnergy(const EOS &eos, const real P,
+                                                                   const real rho) {
+  return(eos.GetInternalEnergy(P,rho));
+}
+
+template<typename EOS, int W>
+KOKKOS_FORCEINLINE_FUNCTION Batch<W> GetInternalEnergy(const EOS &eos, const Batch<W> &P,
+                                                                      const Batch<W> &rho) {
+  Batch<W> r;
+  for(int w = 0 ; w < W ; w++) r.v[w] = eos.GetInternalEnergy(P.v[w],rho.v[w]);
+  return r;
+}
+
+}  // namespace idfx
+
+#endif // SIMDBATCH_HPP_
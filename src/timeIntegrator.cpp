@@ -7,6 +7,7 @@
 
 //#define WITH_TEMPERATURE_SENSOR
 
+#include <algorithm>
 #include <cstdio>
 #include <iomanip>
 #include <string>
@@ -18,6 +19,7 @@
 #include "stateContainer.hpp"
 #include "fluid.hpp"
 #include "planetarySystem.hpp"
+#include "reductionManager.hpp"
 
 
 TimeIntegrator::TimeIntegrator(Input & input, DataBlock & data) {
@@ -33,6 +35,10 @@ TimeIntegrator::TimeIntegrator(Input & input, DataBlock & data) {
     this->haveFixedDt = true;
     this->fixedDt = input.Get<real>("TimeIntegrator","fixed_dt",0);
     data.dt=fixedDt;
+    if(data.haveDustSubcycling) {
+      // The number of sub-cycles derives from the CFL timestep, which is not computed here
+      IDEFIX_ERROR("[Dust] subcycling is incompatible with [TimeIntegrator] fixed_dt");
+    }
   }
 
   if(!haveFixedDt) {
@@ -74,6 +80,12 @@ TimeIntegrator::TimeIntegrator(Input & input, DataBlock & data) {
   if(data.hydro->haveRKLParabolicTerms) {
     haveRKL = true;
   }
+  if(data.hydro->haveImplicitParabolicTerms) {
+    haveImplicit = true;
+  }
+  if(data.hydro->hallStatus.isSubcycled) {
+    haveHallSubcycles = true;
+  }
 
   // If multi-stage, create a new state in the datablock called "begin"
   if(nstages>1) {
@@ -95,6 +107,18 @@ void TimeIntegrator::ShowLog(DataBlock &data) {
   // reduce to an normalized overhead in %
   double mpiOverhead = 100.0 * mpiCycleTime / (timer.seconds() - lastLog);
   lastMpiLog = idfx::mpiCallsTimer;
+  // Halo exchange messages and volume sent per cycle by this process
+  double mpiMessagesPerCycle = static_cast<double>(idfx::mpiMessages - lastMpiMessages)
+                                / cyclePeriod;
+  double mpiKBytesPerCycle = static_cast<double>(idfx::mpiBytes - lastMpiBytes)
+                                / cyclePeriod / 1024.0;
+  // Global reductions which did not need their own collective, thanks to batching
+  const int64_t mpiReductionsSaved = idfx::reductions.requests - idfx::reductions.collectives;
+  double mpiReductionsSavedPerCycle = static_cast<double>(mpiReductionsSaved
+                                                          - lastMpiReductionsSaved) / cyclePeriod;
+  lastMpiMessages = idfx::mpiMessages;
+  lastMpiBytes = idfx::mpiBytes;
+  lastMpiReductionsSaved = mpiReductionsSaved;
 #endif
   double sgOverhead;
   if(data.haveGravity && data.gravity->haveSelfGravityPotential) {
@@ -115,6 +139,9 @@ void TimeIntegrator::ShowLog(DataBlock &data) {
     idfx::cout << " | " << std::setw(col_width) << "cell (updates/s)";
 #ifdef WITH_MPI
     idfx::cout << " | " << std::setw(col_width) << "MPI overhead (%)";
+    idfx::cout << " | " << std::setw(col_width) << "MPI msg/cycle";
+    idfx::cout << " | " << std::setw(col_width) << "MPI kB/cycle";
+    idfx::cout << " | " << std::setw(col_width) << "MPI coll. saved";
     if(idfx::prank==0)  {
       idfx::cout << " | " << std::setw(col_width) << "MPI imbalance(%)";
     }
@@ -125,6 +152,16 @@ void TimeIntegrator::ShowLog(DataBlock &data) {
     if(haveRKL) {
       idfx::cout << " | " << std::setw(col_width) << "RKL stages";
     }
+    if(haveImplicit) {
+      idfx::cout << " | " << std::setw(col_width) << "Krylov iter.";
+    }
+    if(haveHallSubcycles) {
+      idfx::cout << " | " << std::setw(col_width) << "Hall steps";
+    }
+    if(data.haveDustSubcycling) {
+      idfx::cout << " | " << std::setw(col_width) << "Dust subcycles";
+      idfx::cout << " | " << std::setw(col_width) << "Dust speed-up";
+    }
     if(data.haveGravity && data.gravity->haveSelfGravityPotential) {
       idfx::cout << " | " << std::setw(col_width) << "SG iterations";
       idfx::cout << " | " << std::setw(col_width) << "SG error";
@@ -135,7 +172,11 @@ void TimeIntegrator::ShowLog(DataBlock &data) {
 
   #ifdef WITH_MPI
     double imbalance = 0;
-    if(ncycles>=cyclePeriod) imbalance = ComputeBalance();
+    if(ncycles>=cyclePeriod) {
+      // Measure the cost map used to balance the subdomains on restarts
+      if(data.mygrid->haveLoadBalancing) data.mygrid->AddComputeTime(computeLastLog);
+      imbalance = ComputeBalance();
+    }
   #endif
   idfx::cout << "TimeIntegrator: ";
   idfx::cout << std::scientific;
@@ -147,6 +188,9 @@ void TimeIntegrator::ShowLog(DataBlock &data) {
 #ifdef WITH_MPI
   idfx::cout << std::fixed;
     idfx::cout << " | " << std::setw(col_width) << mpiOverhead;
+    idfx::cout << " | " << std::setw(col_width) << mpiMessagesPerCycle;
+    idfx::cout << " | " << std::setw(col_width) << mpiKBytesPerCycle;
+    idfx::cout << " | " << std::setw(col_width) << mpiReductionsSavedPerCycle;
   if(idfx::prank==0) {
     idfx::cout << " | " << std::setw(col_width) << imbalance;
   }
@@ -154,6 +198,9 @@ void TimeIntegrator::ShowLog(DataBlock &data) {
   } else {
     idfx::cout << " | " << std::setw(col_width) << "N/A";
 #if WITH_MPI
+    idfx::cout << " | " << std::setw(col_width) << "N/A";
+    idfx::cout << " | " << std::setw(col_width) << "N/A";
+    idfx::cout << " | " << std::setw(col_width) << "N/A";
     idfx::cout << " | " << std::setw(col_width) << "N/A";
     if(idfx::prank==0) {
       idfx::cout << " | " << std::setw(col_width) << "N/A";
@@ -177,6 +224,26 @@ void TimeIntegrator::ShowLog(DataBlock &data) {
   if(haveRKL) {
     idfx::cout << " | " << std::setw(col_width) << data.hydro->rkl->stage;
   }
+  if(haveImplicit) {
+    idfx::cout << " | " << std::setw(col_width)
+               << data.hydro->thermalDiffusion->implicitDiffusion->lastIterations;
+  }
+  if(haveHallSubcycles) {
+    idfx::cout << " | " << std::setw(col_width) << data.hydro->hallSubcycles;
+  }
+  if(data.haveDustSubcycling) {
+    // Estimated speed-up compared to a global timestep, assuming all fluids have the same cost
+    int maxSubcycles = 1;
+    int sumSubcycles = 1;
+    for(int n = 0 ; n < data.dust.size() ; n++) {
+      maxSubcycles = std::max(maxSubcycles, data.dustSubcycles[n]);
+      sumSubcycles += data.dustSubcycles[n];
+    }
+    const double speedup = static_cast<double>((data.dust.size()+1)*maxSubcycles)/sumSubcycles;
+    idfx::cout << " | " << std::setw(col_width) << maxSubcycles;
+    idfx::cout << std::fixed;
+    idfx::cout << " | " << std::setw(col_width) << speedup;
+  }
   if(data.haveGravity && data.gravity->haveSelfGravityPotential) {
     if(ncycles>=cyclePeriod) {
       idfx::cout << " | " << std::setw(col_width) << data.gravity->selfGravity.nsteps;
@@ -235,6 +302,8 @@ double TimeIntegrator::ComputeBalance() {
             }
           }
           idfx::cout << "You should probably check these nodes are running properly." << std::endl;
+          idfx::cout << "If the cost of the cells is uneven, [Grid] loadBalancing cost adapts the "
+                     << "subdomain sizes on restarts." << std::endl;
           idfx::cout << "-------------------------------------------------------------"<< std::endl;
         }
       }
@@ -249,6 +318,7 @@ void TimeIntegrator::Cycle(DataBlock &data) {
   real newdt;
 
   idfx::pushRegion("TimeIntegrator::Cycle");
+  data.cycle = ncycles;
 
   if(ncycles%cyclePeriod==0) ShowLog(data);
 
@@ -265,9 +335,12 @@ void TimeIntegrator::Cycle(DataBlock &data) {
   // Reinit datablock for a new stage
   data.ResetStage();
 
-#ifdef WITH_MPI
-  MPI_Request dtReduce;
-#endif
+  // Buffer holding the timesteps to be reduced (gas first, then sub-cycled dust species)
+  std::vector<real> dtReduceBuffer;
+  // Look for Nans every now and then (this actually cost a lot of time on GPUs
+  // because streams are divergent). The nans are counted after each stage and summed
+  // over the processes right away, so that the next stage never starts from nans.
+  const bool checkNan = (ncycles%checkNanPeriodicity==0);
 
   /////////////////////////////////////////////////
   // BEGIN STAGES LOOP                           //
@@ -291,20 +364,27 @@ void TimeIntegrator::Cycle(DataBlock &data) {
       if(ncycles % data.gravity->skipGravity == 0) data.gravity->ComputeGravity(ncycles);
     }
 
-    Kokkos::fence();
+    // Instance fences: the fluids evolved on their own instances (concurrent fluids) are
+    // joined by DataBlock::EvolveStage
+    Kokkos::DefaultExecutionSpace().fence("TimeIntegrator::Cycle");
     computeLastLog -= timer.seconds();
     // Update Uc & Vs
     data.EvolveStage();
-    Kokkos::fence();
+    Kokkos::DefaultExecutionSpace().fence("TimeIntegrator::Cycle");
     computeLastLog += timer.seconds();
 
     // evolve dt accordingly
     data.t += data.dt;
 
-    // Look for Nans every now and then (this actually cost a lot of time on GPUs
-    // because streams are divergent)
-    if(ncycles%checkNanPeriodicity==0) {
-      if(data.CheckNan()>0) {
+    if(checkNan) {
+      // Own batch, hence its own blocking collective: the next stage should not start from
+      // nans, so that it cannot wait for the time step reduction, which is left in flight.
+      real nanCount = data.CountNan();
+      idfx::reductions.Add(&nanCount, 1, idfx::ReductionManager::sum);
+      idfx::reductions.Flush();
+      if(nanCount>0) {
+        // Locate the nans (details are in the log files)
+        data.CheckNan();
         throw std::runtime_error(std::string("Nan found after integration cycle"));
       }
     }
@@ -313,13 +393,15 @@ void TimeIntegrator::Cycle(DataBlock &data) {
     if(stage==0) {
       if(!haveFixedDt) {
         newdt = cfl*data.ComputeTimestep();
-        #ifdef WITH_MPI
-          if(idfx::psize>1) {
-            MPI_SAFE_CALL(MPI_Iallreduce(MPI_IN_PLACE, &newdt, 1, realMPI, MPI_MIN, MPI_COMM_WORLD,
-                                        &dtReduce));
-          }
-        #endif
+        dtReduceBuffer.assign(1, newdt);
+        if(data.haveDustSubcycling) {
+          dtReduceBuffer.insert(dtReduceBuffer.end(), data.dustDt.begin(), data.dustDt.end());
+        }
+        idfx::reductions.Add(dtReduceBuffer.data(), dtReduceBuffer.size(),
+                             idfx::ReductionManager::min);
       }
+      // Overlap the reduction with the next stages
+      idfx::reductions.Start();
     }
 
     // Is this not the first stage?
@@ -353,11 +435,23 @@ void TimeIntegrator::Cycle(DataBlock &data) {
   /////////////////////////////////////////////////
 
   // Wait for dt MPI reduction
-#ifdef WITH_MPI
-  if(!haveFixedDt && idfx::psize>1) {
-    MPI_SAFE_CALL(MPI_Wait(&dtReduce, MPI_STATUS_IGNORE));
+  idfx::reductions.Wait();
+  if(!haveFixedDt) {
+    newdt = dtReduceBuffer[0];
+    if(data.haveDustSubcycling) {
+      for(int n = 0 ; n < data.dust.size() ; n++) {
+        data.dustDt[n] = dtReduceBuffer[n+1];
+      }
+    }
+  }
+
+  if(haveHallSubcycles) {    // Sub-cycles of the Hall effect
+    data.EvolveHallStage();
+  }
+
+  if(haveImplicit) {    // Implicit step of the parabolic terms
+    data.EvolveImplicitStage();
   }
-#endif
 
   if(haveRKL && (ncycles%2)==0) {    // Runge-Kutta-Legendre cycle
     data.EvolveRKLStage();
@@ -398,6 +492,8 @@ void TimeIntegrator::Cycle(DataBlock &data) {
       }
       data.dt=newdt;
     }
+    // Adjust the number of dust sub-cycles to the new timestep
+    data.dt = data.ComputeDustSubcycles(data.dt, cfl);
     if(data.dt < 1e-15) {
       std::stringstream msg;
       msg << "dt = " << data.dt << " is too small.";
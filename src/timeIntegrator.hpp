@@ -38,6 +38,12 @@ class TimeIntegrator {
   // Whether we have RKL
   bool haveRKL{false};
 
+  // Whether we have implicit parabolic terms
+  bool haveImplicit{false};
+
+  // Whether the Hall effect is sub-cycled
+  bool haveHallSubcycles{false};
+
   int nstages;
   // Weights of time integrator
   real w0[2];
@@ -57,6 +63,9 @@ class TimeIntegrator {
 
   double lastLog;         // time for the last log (s)
   double lastMpiLog;      // time for the last MPI log (s)
+  int64_t lastMpiMessages{0}; // # of MPI messages sent at the last log
+  int64_t lastMpiBytes{0};    // # of MPI bytes sent at the last log
+  int64_t lastMpiReductionsSaved{0}; // # of MPI collectives saved by batching at the last log
   double lastSGLog;      // time for the last SelfGravity log (s)
   double maxRuntime;      // Maximum runtime requested (disabled when negative)
   int64_t cyclePeriod;    // # of cycles between two logs
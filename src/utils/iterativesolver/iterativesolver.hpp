@@ -11,6 +11,7 @@
 #include <vector>
 #include "idefix.hpp"
 #include "vector.hpp"
+#include "reductionManager.hpp"
 
 template <class T>
 class IterativeSolver {
@@ -96,9 +97,8 @@ void IterativeSolver<T>::TestErrorL1() {
                 Kokkos::Sum<MyVector>(normL1Vector));
 
   // Reduction on the whole grid
-  #ifdef WITH_MPI
-  MPI_Allreduce(MPI_IN_PLACE, &normL1Vector.v, 2, realMPI, MPI_SUM, MPI_COMM_WORLD);
-  #endif
+  idfx::reductions.Add(normL1Vector.v, 2, idfx::ReductionManager::sum);
+  idfx::reductions.Flush();
 
   // Squared error
   this->currentError = sqrt(normL1Vector.v[0] * normL1Vector.v[0] / normL1Vector.v[1]);
@@ -154,9 +154,8 @@ void IterativeSolver<T>::TestErrorL2() {
                 Kokkos::Sum<MyVector>(normL2Vector));
 
   // Reduction on the whole grid
-  #ifdef WITH_MPI
-  MPI_Allreduce(MPI_IN_PLACE, &normL2Vector.v, 2, realMPI, MPI_SUM, MPI_COMM_WORLD);
-  #endif
+  idfx::reductions.Add(normL2Vector.v, 2, idfx::ReductionManager::sum);
+  idfx::reductions.Flush();
 
   // Squared error
   this->currentError = sqrt(normL2Vector.v[0] / normL2Vector.v[1]);
@@ -219,10 +218,9 @@ void IterativeSolver<T>::TestErrorLINF() {
                 Kokkos::Sum<real>(rho2));
 
   // Reduction on the whole grid
-  #ifdef WITH_MPI
-  MPI_Allreduce(MPI_IN_PLACE, &maxRes2, 1, realMPI, MPI_MAX, MPI_COMM_WORLD);
-  MPI_Allreduce(MPI_IN_PLACE, &rho2, 1, realMPI, MPI_SUM, MPI_COMM_WORLD);
-  #endif
+  idfx::reductions.Add(&maxRes2, 1, idfx::ReductionManager::max);
+  idfx::reductions.Add(&rho2, 1, idfx::ReductionManager::sum);
+  idfx::reductions.Flush();
 
   // Squared error
   currentError = sqrt(maxRes2/rho2);
@@ -298,9 +296,7 @@ real IterativeSolver<T>::ComputeDotProduct(IdefixArray3D<real> mat1, IdefixArray
                 Kokkos::Sum<real>(sum));
 
   // Reduction on the whole grid
-  #ifdef WITH_MPI
-  MPI_Allreduce(MPI_IN_PLACE, &sum, 1, realMPI, MPI_SUM, MPI_COMM_WORLD);
-  #endif
+  sum = idfx::reductions.Reduce(sum, idfx::ReductionManager::sum);
 
   idfx::popRegion();
 
@@ -0,0 +1,139 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <cmath>
+#include <utility>
+#include "reductionManager.hpp"
+#include "global.hpp"
+#ifdef WITH_MPI
+#include "mpi.hpp"
+#endif
+
+namespace idfx {
+
+#ifdef WITH_MPI
+// Reduction of (value, op) pairs, each value being combined with its own operation
+static void ReduceMixedPairs(void *in, void *inout, int *len, MPI_Datatype *) {
+  const real *a = static_cast<real *>(in);
+  real *b = static_cast<real *>(inout);
+  for(int n = 0 ; n < *len ; n++) {
+    const int op = static_cast<int>(a[2*n+1]);
+    if(op == ReductionManager::sum) {
+      b[2*n] += a[2*n];
+    } else if(op == ReductionManager::min) {
+      b[2*n] = std::fmin(a[2*n], b[2*n]);
+    } else {
+      b[2*n] = std::fmax(a[2*n], b[2*n]);
+    }
+  }
+}
+#endif
+
+ReductionManager::~ReductionManager() {
+  #ifdef WITH_MPI
+  int finalized;
+  MPI_Finalized(&finalized);
+  if(haveMixedOp && !finalized) {
+    MPI_Op_free(&mixedOp);
+    MPI_Type_free(&pairType);
+  }
+  #endif
+}
+
+void ReductionManager::Add(real *ptr, int n, Op op) {
+  if(pending.targets.empty()) {
+    pending.op = op;
+    pending.opMixed = false;
+  }
+  if(op != pending.op) pending.opMixed = true;
+  pending.targets.push_back({ptr, n});
+  for(int i = 0 ; i < n ; i++) {
+    pending.buffer.push_back(ptr[i]);
+    pending.buffer.push_back(static_cast<real>(op));
+  }
+}
+
+void ReductionManager::Start() {
+  if(pending.targets.empty()) return;
+
+  #ifdef WITH_MPI
+  if(psize>1) {
+    // Only the requests which go through a collective are counted: with a single process
+    // nothing is reduced, hence nothing is saved.
+    requests += pending.targets.size();
+    inFlight.push_back(std::move(pending));
+    Batch &batch = inFlight.back();
+    const int size = batch.buffer.size()/2;
+    if(batch.opMixed) {
+      if(!haveMixedOp) {
+        MPI_SAFE_CALL(MPI_Type_contiguous(2, realMPI, &pairType));
+        MPI_SAFE_CALL(MPI_Type_commit(&pairType));
+        MPI_SAFE_CALL(MPI_Op_create(&ReduceMixedPairs, 1, &mixedOp));
+        haveMixedOp = true;
+      }
+      MPI_SAFE_CALL(MPI_Iallreduce(MPI_IN_PLACE, batch.buffer.data(), size, pairType,
+                                   mixedOp, MPI_COMM_WORLD, &batch.request));
+    } else {
+      // A single operation: drop the op codes and use the native MPI operation
+      for(int i = 0 ; i < size ; i++) {
+        batch.buffer[i] = batch.buffer[2*i];
+      }
+      batch.buffer.resize(size);
+      MPI_Op mpiOp = (batch.op == sum) ? MPI_SUM : ((batch.op == min) ? MPI_MIN : MPI_MAX);
+      MPI_SAFE_CALL(MPI_Iallreduce(MPI_IN_PLACE, batch.buffer.data(), size, realMPI,
+                                   mpiOp, MPI_COMM_WORLD, &batch.request));
+    }
+    collectives++;
+    pending = Batch();
+    return;
+  }
+  #endif
+  // Serial run: the local values are the global ones
+  pending.targets.clear();
+  pending.buffer.clear();
+}
+
+void ReductionManager::Wait() {
+  while(!inFlight.empty()) {
+    Complete(inFlight.front());
+    inFlight.pop_front();
+  }
+}
+
+void ReductionManager::Flush() {
+  const size_t before = inFlight.size();
+  Start();
+  // Only wait for this batch, the ones launched before may complete later
+  if(inFlight.size() > before) {
+    Complete(inFlight.back());
+    inFlight.pop_back();
+  }
+}
+
+real ReductionManager::Reduce(real value, Op op) {
+  Add(&value, 1, op);
+  Flush();
+  return(value);
+}
+
+void ReductionManager::Complete(Batch &batch) {
+  #ifdef WITH_MPI
+  double tStart = MPI_Wtime();
+  MPI_SAFE_CALL(MPI_Wait(&batch.request, MPI_STATUS_IGNORE));
+  idfx::mpiCallsTimer += MPI_Wtime() - tStart;
+  #endif
+  const int stride = batch.opMixed ? 2 : 1;
+  int index = 0;
+  for(const Target &target : batch.targets) {
+    for(int i = 0 ; i < target.n ; i++) {
+      target.ptr[i] = batch.buffer[stride*index];
+      index++;
+    }
+  }
+}
+
+} // namespace idfx
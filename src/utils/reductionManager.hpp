@@ -0,0 +1,72 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef UTILS_REDUCTIONMANAGER_HPP_
+#define UTILS_REDUCTIONMANAGER_HPP_
+
+#include <list>
+#include <vector>
+#include "idefix.hpp"
+
+namespace idfx {
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+/// The ReductionManager gathers the global reductions (sum, min or max over all of the
+/// processes) of the scalars computed by the modules, so that they are done in a single MPI
+/// collective per synchronisation point instead of one collective per quantity.
+/// Values are queued with Add() and reduced in place when their batch completes: with Start()
+/// and Wait() around some work for the reductions which can be delayed (the time step), or with
+/// Flush() for the ones which are needed right away. Batches with different operations are
+/// reduced together with a custom MPI operation.
+//////////////////////////////////////////////////////////////////////////////////////////////////
+class ReductionManager {
+ public:
+  enum Op {sum, min, max};
+
+  ~ReductionManager();
+
+  // Queue n values to be reduced with op. The reduced values are written back to ptr when the
+  // batch completes, ptr should stay valid until then.
+  void Add(real *ptr, int n, Op op);
+  void Start();       ///< launch the non-blocking reduction of the values queued so far
+  void Wait();        ///< complete all of the launched reductions
+  void Flush();       ///< reduce the values queued so far now
+
+  real Reduce(real value, Op op);   ///< reduce a single value now
+
+  int64_t requests{0};    ///< number of requests reduced through a collective (MPI runs)
+  int64_t collectives{0}; ///< number of collectives actually done
+
+ private:
+  struct Target {
+    real *ptr;
+    int n;
+  };
+  struct Batch {
+    std::vector<Target> targets;
+    std::vector<real> buffer;     ///< (value, op) pairs, or values only when opMixed is false
+    Op op;
+    bool opMixed{false};
+    #ifdef WITH_MPI
+    MPI_Request request;
+    #endif
+  };
+
+  void Complete(Batch &);
+
+  Batch pending;
+  std::list<Batch> inFlight;
+  #ifdef WITH_MPI
+  MPI_Op mixedOp;
+  MPI_Datatype pairType;
+  bool haveMixedOp{false};
+  #endif
+};
+
+} // namespace idfx
+
+#endif // UTILS_REDUCTIONMANAGER_HPP_
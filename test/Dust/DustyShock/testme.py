@@ -5,6 +5,7 @@
 @author: glesur
 """
 import os
+import shutil
 import sys
 sys.path.append(os.getenv("IDEFIX_DIR"))
 
@@ -15,7 +16,7 @@ name="dump.0001.dmp"
 def testMe(test):
   test.configure()
   test.compile()
-  inifiles=["idefix.ini","idefix-implicit.ini"]
+  inifiles=["idefix.ini","idefix-implicit.ini","idefix-exact.ini","idefix-shared.ini"]
 
   # loop on all the ini files for this test
   for ini in inifiles:
@@ -25,6 +26,22 @@ def testMe(test):
     test.standardTest()
     test.nonRegressionTest(filename=name,tolerance=1e-14)
 
+  # The species of the shared storage are evolved by the same kernels, with the same
+  # operations as separate species: both storages should give the same solution
+  test.run(inputFile="idefix.ini")
+  if not test.fake:
+    shutil.copy(name,"dump.separate.dmp")
+  test.run(inputFile="idefix-shared.ini")
+  test.compareDump("dump.separate.dmp",name,tolerance=0)
+
+  # The fluids evolved on their own execution space instances are joined before the drag,
+  # which is then applied in the same order: the solution should not change
+  test.run(inputFile="idefix.ini")
+  if not test.fake:
+    shutil.copy(name,"dump.sequential.dmp")
+  test.run(inputFile="idefix-concurrent.ini")
+  test.compareDump("dump.sequential.dmp",name,tolerance=0)
+
 
 test=tst.idfxTest(__file__)
 
@@ -3,6 +3,9 @@
 
 #define  FILENAME    "timevol.dat"
 
+// Uniform drift of the dust with respect to the gas
+real dustDrift;
+
 // Analyse data to produce an output
 void Analysis(DataBlock & data) {
 
@@ -36,6 +39,7 @@ void Analysis(DataBlock & data) {
 Setup::Setup(Input &input, Grid &grid, DataBlock &data, Output &output) {
 
   output.EnrollAnalysis(&Analysis);
+  dustDrift = input.GetOrSet<real>("Setup","dustDrift",0,0.0);
   if(!input.restartRequested) {
       // Initialise the output file
       std::ofstream f;
@@ -62,7 +66,7 @@ void Setup::InitFlow(DataBlock &data) {
                 d.dustVc[0](RHO,k,j,i) = 1.0;
 
                 d.Vc(VX1,k,j,i) = 0.01*sin(2.0*M_PI*d.x[IDIR](i));
-                d.dustVc[0](VX1,k,j,i) = 0.0;
+                d.dustVc[0](VX1,k,j,i) = dustDrift;
 
 #if HAVE_ENERGY
                 d.Vc(PRS,k,j,i) = 1.0;
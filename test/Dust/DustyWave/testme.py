@@ -5,6 +5,7 @@
 @author: glesur
 """
 import os
+import shutil
 import sys
 sys.path.append(os.getenv("IDEFIX_DIR"))
 
@@ -12,18 +13,42 @@ import pytools.idfx_test as tst
 
 name="dump.0001.dmp"
 
+def maxDustSubcycles():
+  # Largest number of dust sub-cycles reported in the integration log
+  with open("idefix.0.log") as f:
+    lines = [l.split("|") for l in f if l.startswith("TimeIntegrator:") and "|" in l]
+  col = [c.strip() for c in lines[0]].index("Dust subcycles")
+  return max(int(l[col]) for l in lines[1:])
+
 def testMe(test):
   test.configure()
   test.compile()
-  inifiles=["idefix.ini","idefix-implicit.ini"]
+  inifiles=["idefix.ini","idefix-implicit.ini","idefix-subcycling.ini"]
 
   # loop on all the ini files for this test
   for ini in inifiles:
     test.run(inputFile=ini)
-    if test.init:
-      test.makeReference(filename=name)
     test.standardTest()
-    test.nonRegressionTest(filename=name,tolerance=1e-14)
+    # the sub-cycled run has no reference dump: it is checked against the analytical decay
+    # rate by the standard test
+    if ini!="idefix-subcycling.ini":
+      if test.init:
+        test.makeReference(filename=name)
+      test.nonRegressionTest(filename=name,tolerance=1e-14)
+
+  # The dust drift sets the timestep: sub-cycling the dust should reproduce the solution
+  # obtained with the dust-limited timestep, up to the time discretisation error. This error
+  # is estimated to ~1e-5 (first order sub-steps with k dx=0.013, gas RK2 with omega dt=0.01,
+  # drag splitting with dt/tau=2e-4, on a wave of amplitude 0.01). The bound is 5% of the
+  # wave amplitude.
+  test.run(inputFile="idefix-drift.ini")
+  if not test.fake:
+    shutil.copy(name,"dump.drift.dmp")
+  test.run(inputFile="idefix-drift-subcycling.ini")
+  if not test.fake:
+    nSub = maxDustSubcycles()
+    assert nSub > 1, "The dust should be sub-cycled (%d sub-cycle)"%nSub
+  test.compareDump("dump.drift.dmp",name,tolerance=5e-4)
 
 
 test=tst.idfxTest(__file__)
@@ -0,0 +1,53 @@
+#!/usr/bin/env python3
+"""
+Compare the performances of the scalar hll and hllc Riemann solver kernels with their batched
+versions (Idefix_SIMD_WIDTH) on the double Mach reflection problem.
+
+For each run, the overall performance and the cell updates/s of the Riemann solver kernel
+alone (as reported by -profile) are shown. A width of 0 is the scalar reference build.
+
+usage: benchsimd.py [-cmake opt1 opt2 ...] [-widths w1 w2 ...] [-maxcycles n] [-j jobs]
+"""
+import os
+import sys
+
+idefixDir = os.getenv("IDEFIX_DIR")
+if idefixDir is None:
+  sys.exit("IDEFIX_DIR is not defined")
+sys.path.append(idefixDir)
+import pytools.bench as bench
+
+parser = bench.argParser(cmakeExample="Kokkos_ARCH_SKX=ON")
+parser.add_argument("-widths",
+                    type=int,
+                    default=[0, 4, 8],
+                    help="SIMD widths to be compared (0: scalar kernels)",
+                    nargs='+')
+args = parser.parse_args()
+
+problemDir = os.path.dirname(os.path.abspath(__file__))
+
+solvers = {"hll": "HLL_Kernel", "hllc": "HLLC_Kernel"}
+
+results = []
+for width in args.widths:
+  buildDir = bench.build(problemDir, "simd-"+str(width),
+                         ["Idefix_SIMD_WIDTH="+str(width)] + args.cmake, args.j)
+
+  for solver, kernel in solvers.items():
+    output = bench.run(buildDir, ["-i", os.path.join(problemDir, "idefix-"+solver+".ini"),
+                                  "-maxcycles", str(args.maxcycles), "-nowrite", "-profile"],
+                       problemDir)
+    perf = bench.cellUpdates(output, "width "+str(width)+" build")
+    # The batched kernels iterate over batches of width interfaces
+    if width > 0:
+      kperf = width*bench.kernelPerf(output, kernel+"_Batch")
+    else:
+      kperf = bench.kernelPerf(output, kernel)
+    results.append((width, solver, perf, kperf))
+
+print("**************************************************************************")
+print(f"{'width':>6s} {'solver':>7s} {'cell updates/s':>15s} {'Riemann kernel':>15s}")
+for width, solver, perf, kperf in results:
+  print(f"{width:>6d} {solver:>7s} {perf:>15.4e} {kperf:>15.4e}")
+print("**************************************************************************")
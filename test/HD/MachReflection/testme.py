@@ -8,8 +8,12 @@ import os
 import sys
 sys.path.append(os.getenv("IDEFIX_DIR"))
 
+import shutil
 import pytools.idfx_test as tst
 
+# the batched kernels may contract the floating point operations differently
+simdTolerance=1e-12
+
 def testMe(test):
   test.configure()
   test.compile()
@@ -22,6 +26,26 @@ def testMe(test):
     test.standardTest()
     test.nonRegressionTest(filename="dump.0001.dmp")
 
+def testSimd(test, width=4):
+  # the batched hll and hllc solvers (Idefix_SIMD_WIDTH) should give the results of the
+  # scalar ones
+  inifiles=["idefix-hll.ini","idefix-hllc.ini"]
+  test.configure()
+  test.compile()
+  for ini in inifiles:
+    test.run(inputFile=ini)
+    if not test.fake:
+      shutil.copy("dump.0001.dmp","dump.scalar-"+ini.replace(".ini",".dmp"))
+
+  test.cmake=["Idefix_SIMD_WIDTH="+str(width)]
+  test.configure()
+  test.compile()
+  for ini in inifiles:
+    test.run(inputFile=ini)
+    test.compareDump("dump.scalar-"+ini.replace(".ini",".dmp"),"dump.0001.dmp",
+                     tolerance=simdTolerance)
+  test.cmake=[]
+
 
 test=tst.idfxTest(__file__)
 if not test.dec:
@@ -41,3 +65,8 @@ else:
 
   test.mpi=True
   testMe(test)
+
+  # test the batched Riemann solvers, only available on CPUs
+  if not (test.cuda or test.hip):
+    test.mpi=False
+    testSimd(test)
@@ -16,7 +16,8 @@ def testMe(test):
   test.configure()
   test.compile()
   inifiles=["idefix.ini","idefix-hll.ini","idefix-hllc.ini","idefix-tvdlf.ini"]
-  if test.reconstruction==4:
+  # PPM and the fifth order schemes (Weno5Z, MP5) are used with the 3rd order time integrator
+  if test.reconstruction>=4:
     inifiles=["idefix-rk3.ini","idefix-hllc-rk3.ini"]
 
   # loop on all the ini files for this test
@@ -25,7 +26,10 @@ def testMe(test):
     if test.init:
       test.makeReference(filename=name)
     test.standardTest()
-    test.nonRegressionTest(filename=name)
+    if test.mixed:
+      test.nonRegressionTest(filename=name,tolerance=1e-6)
+    else:
+      test.nonRegressionTest(filename=name)
 
 
 test=tst.idfxTest(__file__)
@@ -37,7 +41,7 @@ if not test.all:
     testMe(test)
 else:
   test.noplot = True
-  for rec in range(2,5):
+  for rec in range(2,7):
     test.vectPot=False
     test.single=False
     test.reconstruction=rec
@@ -48,3 +52,8 @@ else:
   test.reconstruction=2
   test.single=True
   testMe(test)
+
+  # test in mixed precision (single precision fluxes), against double precision references
+  test.single=False
+  test.mixed=True
+  testMe(test)
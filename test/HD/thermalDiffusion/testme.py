@@ -5,29 +5,50 @@
 @author: glesur
 """
 import os
+import shutil
 import sys
 sys.path.append(os.getenv("IDEFIX_DIR"))
 
 import pytools.idfx_test as tst
 
+name="dump.0001.dmp"
+
 def testMe(test):
   test.configure()
   test.compile()
-  inifiles=["idefix.ini","idefix-rkl.ini"]
+  inifiles=["idefix.ini","idefix-rkl.ini","idefix-implicit.ini"]
 
   for ini in inifiles:
     test.run(inputFile=ini)
-    if test.init and not test.mpi:
-      test.makeReference(filename="dump.0001.dmp")
     test.standardTest()
-    test.nonRegressionTest(filename="dump.0001.dmp")
+    # the implicit run has no reference: it is compared to the explicit and rkl ones below
+    if ini!="idefix-implicit.ini":
+      if test.init and not test.mpi:
+        test.makeReference(filename=name)
+      test.nonRegressionTest(filename=name)
+      if not test.fake:
+        shutil.copy(name,"dump."+ini+".dmp")
+
+  # The three integrations share the spatial discretisation. The time errors of the
+  # Crank-Nicolson step (omega*dt~2e-3) and of the explicit ones are well below 1e-3 of the
+  # 1e-6 perturbation
+  test.compareDump("dump.idefix.ini.dmp",name,tolerance=1e-9)
+  test.compareDump("dump.idefix-rkl.ini.dmp",name,tolerance=1e-9)
+
+  # Same comparison with outflow boundaries, through which no heat should diffuse
+  # (no analytical solution there, hence no standard test)
+  test.run(inputFile="idefix-outflow.ini")
+  if not test.fake:
+    shutil.copy(name,"dump.outflow.dmp")
+  test.run(inputFile="idefix-implicit-outflow.ini")
+  test.compareDump("dump.outflow.dmp",name,tolerance=1e-8)
 
 
 test=tst.idfxTest(__file__)
 
 if not test.all:
   if(test.check):
-    test.checkOnly(filename="dump.0001.dmp")
+    test.checkOnly(filename=name)
   else:
     testMe(test)
 else:
@@ -23,6 +23,13 @@ void AmbipolarFunction(DataBlock &data, real t, IdefixArray3D<real> &xAin ) {
     });
 
 }
+// Same diffusivity, filled by the single diffusivities function of the fluid
+void DiffusivitiesFunction(DataBlock &data, real t, DiffusivityArrays &arrays) {
+    if(arrays.xAmbipolar.extent(0) > 0) {
+        AmbipolarFunction(data, t, arrays.xAmbipolar);
+    }
+}
+
 // User-defined boundaries
 void UserdefBoundary(Hydro *hydro, int dir, BoundarySide side, real t) {
     auto *data = hydro->data;
@@ -89,7 +96,11 @@ void UserdefBoundary(Hydro *hydro, int dir, BoundarySide side, real t) {
 // Arrays or variables which are used later on
 Setup::Setup(Input &input, Grid &grid, DataBlock &data, Output &output) {
     data.hydro->EnrollUserDefBoundary(&UserdefBoundary);
-    data.hydro->EnrollAmbipolarDiffusivity(&AmbipolarFunction);
+    if(input.GetOrSet<bool>("Setup","diffusivitiesFunction",0,false)) {
+        data.hydro->EnrollDiffusivities(&DiffusivitiesFunction);
+    } else {
+        data.hydro->EnrollAmbipolarDiffusivity(&AmbipolarFunction);
+    }
     cs=input.Get<real>("Hydro","csiso",1);
 }
 
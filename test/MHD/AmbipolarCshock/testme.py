@@ -5,6 +5,7 @@
 @author: glesur
 """
 import os
+import shutil
 import sys
 sys.path.append(os.getenv("IDEFIX_DIR"))
 
@@ -21,6 +22,18 @@ def testMe(test):
       test.makeReference(filename="dump.0001.dmp")
     test.standardTest()
     test.nonRegressionTest(filename="dump.0001.dmp",tolerance=tolerance)
+    if ini=="idefix.ini" and not test.fake:
+      shutil.copy("dump.0001.dmp","dump.stage.dmp")
+
+  # The single diffusivities function is called where the ambipolar function was
+  test.run(inputFile="idefix-diffusivities.ini")
+  test.standardTest()
+  test.compareDump("dump.stage.dmp","dump.0001.dmp",tolerance=0)
+
+  # Updating the diffusivity every 10 cycles should not change the steady shock
+  test.run(inputFile="idefix-cycle.ini")
+  test.standardTest()
+  test.compareDump("dump.stage.dmp","dump.0001.dmp",tolerance=1e-3)
 
 
 test=tst.idfxTest(__file__)
@@ -5,6 +5,7 @@
 @author: glesur
 """
 import os
+import shutil
 import sys
 sys.path.append(os.getenv("IDEFIX_DIR"))
 
@@ -15,15 +16,23 @@ name="dump.0001.dmp"
 def testMe(test):
   test.configure()
   test.compile()
-  inifiles=["idefix.ini","idefix-rkl.ini","idefix-x2.ini","idefix-x3.ini"]
+  inifiles=["idefix.ini","idefix-rkl.ini","idefix-x2.ini","idefix-x3.ini","idefix-coarse.ini"]
 
   # loop on all the ini files for this test
   for ini in inifiles:
     test.run(inputFile=ini)
-    if test.init and not test.mpi:
-      test.makeReference(filename=name)
     test.standardTest()
-    test.nonRegressionTest(filename=name)
+    # the coarse run has no reference: it is compared to the fine one below
+    if ini!="idefix-coarse.ini":
+      if test.init and not test.mpi:
+        test.makeReference(filename=name)
+      test.nonRegressionTest(filename=name)
+    if ini=="idefix.ini" and not test.fake:
+      shutil.copy(name,"dump.fine.dmp")
+
+  # Skipping the Riemann solver inside the coarsened cells should not change the solution
+  # beyond the truncation error of the interpolated fluxes
+  test.compareDump("dump.fine.dmp",name,tolerance=1e-3)
 
 
 test=tst.idfxTest(__file__)
@@ -13,20 +13,33 @@ Created on Thu Sep  3 17:09:32 2020
 @author: lesurg
 """
 import sys
+import shutil
 import numpy as np
 import argparse
 import matplotlib.pyplot as plt
-from scipy.signal import argrelextrema
 
 parser = argparse.ArgumentParser()
 parser.add_argument("-noplot",
                     default=False,
                     help="disable plotting",
                     action="store_true")
+parser.add_argument("-energy",
+                    default=False,
+                    help="check that the wave energy is conserved (sub-cycled Hall effect)",
+                    action="store_true")
+parser.add_argument("-save",
+                    default=None,
+                    help="keep a copy of timevol.dat, for the convergence check of a later run")
+parser.add_argument("-convergence",
+                    default=None,
+                    help="check that the frequency error is at most half of the one of the lower "
+                         +"resolution run kept in this file")
 
 
 args, unknown=parser.parse_known_args()
 
+# largest relative loss of wave energy of the sub-cycled Hall effect, which adds no diffusion
+energyTolerance=0.05
 
 # values for the field strength to compute theoretical eigenfrequency values
 lH=1.0
@@ -34,22 +47,34 @@ B=1.0
 Va=1.0
 k=2.0*np.pi
 
-
-# load the dat file produced by the setup
-raw=np.loadtxt('../timevol.dat',skiprows=1)
-t=raw[:,0]
-by=raw[:,1]
-
-
 # Theoretical speedes
 f_w=Va/(2*np.pi)*k*(np.sqrt(1+(k*lH/2)**2)+k*lH/2)
 f_i=Va/(2*np.pi)*k*(np.sqrt(1+(k*lH/2)**2)-k*lH/2)
 f_A=k*Va/(2*np.pi)
 
 
+def load(filename):
+  # load the dat file produced by the setup: t, by and the wave energy
+  raw=np.loadtxt(filename,skiprows=1)
+  return raw[:,0],raw[:,1],raw[:,2]
+
+def frequency(t,by):
+  # Windowed Fourier transform of by on a fine frequency grid above the Alfven frequency.
+  # Unlike the FFT, it is not limited to a resolution of 1/(t[-1]-t[0]) and does not assume
+  # that the analysis outputs are evenly spaced.
+  dby=(by-np.mean(by))*np.hanning(by.size)
+  f=np.linspace(f_A,2*f_w,4000)
+  sp=np.abs(np.exp(-2j*np.pi*np.outer(f,t)) @ dby)
+  return f[np.argmax(sp)]
 
-# Compute temporal spectrum and get frequency
-#by=By[:,0]
+
+t,by,E=load('../timevol.dat')
+if args.save:
+  shutil.copy('../timevol.dat','../'+args.save)
+
+
+
+# Compute temporal spectrum
 sp=np.abs(np.fft.rfft(by))
 f=np.arange(sp.size)/(t[-1]-t[0])
 
@@ -76,12 +101,23 @@ if(not args.noplot):
     plt.show()
 
 
-imax=argrelextrema(sp,np.greater,order=2)[0][0]
-f_wnum=f[imax]
+f_wnum=frequency(t,by)
 error=np.fabs(f_w-f_wnum)/f_w
 print("Theoretical whistler frequency=%g, numerical=%g, error=%g"%(f_w,f_wnum,error))
+success = error<0.06
+
+if args.energy:
+  energyError=np.fabs(E[-1]-E[0])/E[0]
+  print("Wave energy: initial=%g, final=%g, error=%g"%(E[0],E[-1],energyError))
+  success = success and energyError<energyTolerance
+
+if args.convergence:
+  t0,by0,E0=load('../'+args.convergence)
+  error0=np.fabs(f_w-frequency(t0,by0))/f_w
+  print("Frequency error at the lower resolution=%g, ratio=%g"%(error0,error0/error))
+  success = success and error<0.5*error0
 
-if(error<0.06):
+if(success):
     print("SUCCESS")
     sys.exit(0)
 else:
@@ -22,12 +22,37 @@ void Analysis(DataBlock & data) {
   DataBlockHost d(data);
   d.SyncFromDevice();
 
+  // Energy of the wave: kinetic energy and magnetic energy of the perturbation, the mean
+  // field being of norm 1
+  double etot, etotGlob;
+  IdefixArray4D<real> Vc = data.hydro->Vc;
+
+  idefix_reduce("Analysis", data.beg[KDIR],data.end[KDIR],
+                data.beg[JDIR],data.end[JDIR],
+                data.beg[IDIR],data.end[IDIR],
+              KOKKOS_LAMBDA(int k, int j, int i, double &eloc) {
+                eloc += 0.5*Vc(RHO,k,j,i)*(Vc(VX1,k,j,i)*Vc(VX1,k,j,i)
+                                          +Vc(VX2,k,j,i)*Vc(VX2,k,j,i)
+                                          +Vc(VX3,k,j,i)*Vc(VX3,k,j,i))
+                       +0.5*(Vc(BX1,k,j,i)*Vc(BX1,k,j,i)
+                            +Vc(BX2,k,j,i)*Vc(BX2,k,j,i)
+                            +Vc(BX3,k,j,i)*Vc(BX3,k,j,i) - 1.0);
+              }, Kokkos::Sum<double>(etot));
+
+  #ifdef WITH_MPI
+    MPI_Reduce(&etot, &etotGlob, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+  #else
+    etotGlob = etot;
+  #endif
+  etotGlob /= static_cast<double>(data.mygrid->np_int[IDIR])*data.mygrid->np_int[JDIR]
+                                                           *data.mygrid->np_int[KDIR];
+
   if(idfx::prank == 0) {
     real by = d.Vc(BX2,data.beg[KDIR],data.beg[JDIR],data.beg[IDIR]);
     std::ofstream f;
     f.open(FILENAME,std::ios::app);
     f.precision(10);
-    f << std::scientific << data.t << "\t" << by << std::endl;
+    f << std::scientific << data.t << "\t" << by << "\t" << etotGlob << std::endl;
     f.close();
   }
 
@@ -46,7 +71,7 @@ Setup::Setup(Input &input, Grid &grid, DataBlock &data, Output &output) {
       // Initialise the output file
       std::ofstream f;
       f.open(FILENAME,std::ios::trunc);
-      f << "t\t\t by" << std::endl;
+      f << "t\t\t by\t\t E" << std::endl;
       f.close();
     }
 }
@@ -12,18 +12,27 @@ import pytools.idfx_test as tst
 
 name="dump.0001.dmp"
 tolerance=1e-15
+
+# The sub-cycled whistler should keep its energy, and its frequency should converge with the
+# resolution (options of python/testidefix.py). The sub-cycled runs have no reference dump.
+subcycleTests={"idefix-subcycle.ini": ["-energy","-save","timevol-subcycle.dat"],
+               "idefix-subcycle-hires.ini": ["-energy","-convergence","timevol-subcycle.dat"]}
+
 def testMe(test):
   test.configure()
   test.compile()
-  inifiles=["idefix.ini"]
+  inifiles=["idefix.ini","idefix-subcycle.ini","idefix-subcycle-hires.ini"]
 
   # loop on all the ini files for this test
   for ini in inifiles:
     test.run(inputFile=ini)
-    test.standardTest();
-    if test.init:
-      test.makeReference(filename=name)
-    test.nonRegressionTest(filename=name,tolerance=tolerance)
+    if ini in subcycleTests:
+      test.standardTest(subcycleTests[ini])
+    else:
+      test.standardTest()
+      if test.init:
+        test.makeReference(filename=name)
+      test.nonRegressionTest(filename=name,tolerance=tolerance)
 
 
 test=tst.idfxTest(__file__)
@@ -0,0 +1,94 @@
+#!/usr/bin/env python3
+"""
+Convergence vs cost comparison of the reconstruction schemes (Idefix_RECONSTRUCTION) on the
+3D linear wave tests.
+
+For each reconstruction scheme and resolution, the L1 error after one wave period (as
+computed by python/testidefix.py), the wall clock time of the run and the performance are
+shown, together with the convergence order measured between two successive resolutions.
+
+usage: benchconvergence.py [-cmake opt1 opt2 ...] [-reconstructions r1 r2 ...]
+                           [-resolutions n1 n2 ...] [-wave fast|slow|alfven|entropy]
+                           [-nstages n] [-j jobs]
+"""
+import math
+import os
+import re
+import sys
+import time
+
+import numpy as np
+
+idefixDir = os.getenv("IDEFIX_DIR")
+if idefixDir is None:
+  sys.exit("IDEFIX_DIR is not defined")
+sys.path.append(idefixDir)
+from pytools.dump_io import readDump
+import pytools.bench as bench
+
+parser = bench.argParser(maxcycles=None)
+parser.add_argument("-reconstructions",
+                    default=["Linear", "LimO3", "Parabolic", "Weno5Z", "MP5"],
+                    help="Reconstruction schemes to be compared",
+                    nargs='+')
+parser.add_argument("-resolutions",
+                    type=int,
+                    default=[16, 32, 64],
+                    help="Number of cells along X1 (X2 and X3 have half as many)",
+                    nargs='+')
+parser.add_argument("-wave",
+                    default="fast",
+                    help="Wave mode (fast, slow, alfven or entropy)")
+parser.add_argument("-nstages",
+                    type=int,
+                    default=3,
+                    help="Number of stages of the time integrator")
+args = parser.parse_args()
+
+problemDir = os.path.dirname(os.path.abspath(__file__))
+
+with open(os.path.join(problemDir, "idefix-"+args.wave+".ini")) as f:
+  iniFile = f.read()
+
+def getError(runDir):
+  V = readDump(os.path.join(runDir, "dump.0000.dmp"))
+  U = readDump(os.path.join(runDir, "dump.0001.dmp"))
+  err = 0.0
+  keylist = ['Vc-RHO', 'Vc-VX1', 'Vc-VX2', 'Vc-VX3', 'Vs-BX1s', 'Vs-BX2s', 'Vs-BX3s', 'Vc-PRS']
+  for key in keylist:
+    Q1 = V.data[key] - np.mean(V.data[key])
+    Q2 = U.data[key] - np.mean(U.data[key])
+    err = err + (np.mean(np.abs(Q1-Q2)))**2
+  return np.sqrt(err/len(keylist))
+
+results = []
+for reconstruction in args.reconstructions:
+  buildDir = bench.build(problemDir, reconstruction,
+                         ["Idefix_RECONSTRUCTION="+reconstruction] + args.cmake, args.j)
+
+  for n in args.resolutions:
+    runDir = os.path.join(buildDir, "run-"+str(n))
+    os.makedirs(runDir)
+    ini = re.sub(r"X1-grid\s+1\s+0.0\s+\d+", "X1-grid    1  0.0  "+str(n), iniFile)
+    ini = re.sub(r"X2-grid\s+1\s+0.0\s+\d+", "X2-grid    1  0.0  "+str(n//2), ini)
+    ini = re.sub(r"X3-grid\s+1\s+0.0\s+\d+", "X3-grid    1  0.0  "+str(n//2), ini)
+    ini = re.sub(r"nstages\s+\d+", "nstages        "+str(args.nstages), ini)
+    with open(os.path.join(runDir, "idefix.ini"), "w") as f:
+      f.write(ini)
+
+    start = time.perf_counter()
+    output = bench.run(buildDir, [], runDir)
+    wallTime = time.perf_counter() - start
+    perf = bench.cellUpdates(output, reconstruction+" run")
+    results.append((reconstruction, n, getError(runDir), wallTime, perf))
+
+print("**************************************************************************")
+print(f"{'reconstruction':>15s} {'N':>5s} {'L1 error':>11s} {'order':>6s} "
+      f"{'time (s)':>9s} {'cell updates/s':>15s}")
+for i, (reconstruction, n, err, wallTime, perf) in enumerate(results):
+  order = math.nan
+  if i > 0 and results[i-1][0] == reconstruction:
+    order = math.log(results[i-1][2]/err)/math.log(n/results[i-1][1])
+  print(f"{reconstruction:>15s} {n:>5d} {err:>11.4e} {order:>6.2f} "
+        f"{wallTime:>9.2f} {perf:>15.4e}")
+print("**************************************************************************")
@@ -5,6 +5,7 @@
 @author: glesur
 """
 import os
+import shutil
 import sys
 sys.path.append(os.getenv("IDEFIX_DIR"))
 
@@ -13,7 +14,8 @@ tolerance=2e-13
 def testMe(test):
   test.configure()
   test.compile()
-  inifiles=["idefix-fast.ini","idefix-slow.ini","idefix-alfven.ini","idefix-entropy.ini"]
+  inifiles=["idefix-fast.ini","idefix-slow.ini","idefix-alfven.ini","idefix-entropy.ini",
+            "idefix-hlld.ini"]
   for ini in inifiles:
     mytol=tolerance
 
@@ -23,6 +25,12 @@ def testMe(test):
     test.standardTest()
     test.nonRegressionTest(filename="dump.0001.dmp",tolerance=mytol)
 
+  # The branch-free HLLD kernel should reproduce the default one
+  if not test.fake:
+    shutil.copy("dump.0001.dmp","dump.hlld.dmp")
+  test.run(inputFile="idefix-hlld-masked.ini")
+  test.compareDump("dump.hlld.dmp","dump.0001.dmp",tolerance=tolerance)
+
 
 test=tst.idfxTest(__file__)
 if not test.dec:
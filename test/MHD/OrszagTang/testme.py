@@ -43,7 +43,7 @@ if not test.all:
   else:
     testMe(test)
 else:
-  for rec in [2,3,4]:
+  for rec in [2,3,4,5,6]:
     test.noplot = True
     test.vectPot = False
     test.single=False
@@ -0,0 +1,49 @@
+#!/usr/bin/env python3
+"""
+Measure the share of the constrained transport (CT) in the cycle of the 3D Orszag-Tang
+problem, for each emf averaging scheme, with and without the fused corner EMF kernels
+([Hydro] emf_fused).
+
+The CT share is the fraction of the total time spent in the ConstrainedTransport and Emf
+profiler regions, as reported by -profile.
+
+usage: benchemf.py [-cmake opt1 opt2 ...] [-maxcycles n] [-j jobs]
+"""
+import os
+import re
+import sys
+
+idefixDir = os.getenv("IDEFIX_DIR")
+if idefixDir is None:
+  sys.exit("IDEFIX_DIR is not defined")
+sys.path.append(idefixDir)
+import pytools.bench as bench
+
+args = bench.argParser(cmakeExample="Kokkos_ENABLE_CUDA=ON").parse_args()
+
+problemDir = os.path.dirname(os.path.abspath(__file__))
+buildDir = bench.build(problemDir, "emf", args.cmake, args.j)
+
+with open(os.path.join(problemDir, "idefix.ini")) as f:
+  iniFile = f.read()
+
+results = []
+for emf in ["uct0", "uct_contact", "uct_hll", "uct_hlld"]:
+  for fused in ["no", "yes"]:
+    ini = re.sub(r"\[Hydro\]\n", "[Hydro]\nemf    "+emf+"\nemf_fused    "+fused+"\n", iniFile)
+    iniName = os.path.join(buildDir, "idefix-"+emf+"-"+fused+".ini")
+    with open(iniName, "w") as f:
+      f.write(ini)
+
+    output = bench.run(buildDir, ["-i", iniName, "-maxcycles", str(args.maxcycles),
+                                  "-nowrite", "-profile"], problemDir)
+    perf = bench.cellUpdates(output, emf+" run")
+    share = bench.regionShare(output, ("ConstrainedTransport::", "Emf::"))
+    cornerShare = bench.regionShare(output, "ConstrainedTransport::CalcCornerEMF")
+    results.append((emf, fused, perf, share, cornerShare))
+
+print("**************************************************************************")
+print(f"{'emf':>12s} {'fused':>6s} {'cell updates/s':>15s} {'CT share':>9s} {'corner EMF':>11s}")
+for emf, fused, perf, share, cornerShare in results:
+  print(f"{emf:>12s} {fused:>6s} {perf:>15.4e} {share:>8.1f}% {cornerShare:>10.1f}%")
+print("**************************************************************************")
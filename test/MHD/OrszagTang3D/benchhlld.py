@@ -0,0 +1,56 @@
+#!/usr/bin/env python3
+"""
+Compare the performances of the default HLLD solver kernel with the branch-free one
+([Hydro] hlld_masked) on the 3D Orszag-Tang problem, for each loop pattern of idefix_for
+(Idefix_LOOP_PATTERN).
+
+For each run, the overall performance and the cell updates/s of the Riemann solver kernel
+alone (as reported by -profile) are shown.
+
+usage: benchhlld.py [-cmake opt1 opt2 ...] [-patterns p1 p2 ...] [-maxcycles n] [-j jobs]
+"""
+import os
+import re
+import sys
+
+idefixDir = os.getenv("IDEFIX_DIR")
+if idefixDir is None:
+  sys.exit("IDEFIX_DIR is not defined")
+sys.path.append(idefixDir)
+import pytools.bench as bench
+
+parser = bench.argParser()
+parser.add_argument("-patterns",
+                    default=["Default", "SIMD", "Range", "MDRange", "TeamPolicy",
+                             "TeamPolicyInnerVector"],
+                    help="Loop patterns to be compared",
+                    nargs='+')
+args = parser.parse_args()
+
+problemDir = os.path.dirname(os.path.abspath(__file__))
+
+with open(os.path.join(problemDir, "idefix.ini")) as f:
+  iniFile = f.read()
+
+results = []
+for pattern in args.patterns:
+  buildDir = bench.build(problemDir, "hlld-"+pattern,
+                         ["Idefix_LOOP_PATTERN="+pattern] + args.cmake, args.j)
+
+  for masked in ["no", "yes"]:
+    ini = re.sub(r"\[Hydro\]\n", "[Hydro]\nhlld_masked    "+masked+"\n", iniFile)
+    iniName = os.path.join(buildDir, "idefix-"+masked+".ini")
+    with open(iniName, "w") as f:
+      f.write(ini)
+
+    output = bench.run(buildDir, ["-i", iniName, "-maxcycles", str(args.maxcycles),
+                                  "-nowrite", "-profile"], problemDir)
+    perf = bench.cellUpdates(output, pattern+" build")
+    kernel = "CalcRiemannFluxMasked" if masked == "yes" else "CalcRiemannFlux"
+    results.append((pattern, masked, perf, bench.kernelPerf(output, kernel)))
+
+print("**************************************************************************")
+print(f"{'pattern':>22s} {'masked':>7s} {'cell updates/s':>15s} {'Riemann kernel':>15s}")
+for pattern, masked, perf, kperf in results:
+  print(f"{pattern:>22s} {masked:>7s} {perf:>15.4e} {kperf:>15.4e}")
+print("**************************************************************************")
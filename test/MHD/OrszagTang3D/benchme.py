@@ -0,0 +1,40 @@
+#!/usr/bin/env python3
+"""
+Compare the performances of a generic build (Riemann solver and emf averaging
+read from the input file, double precision) with
+ - a build where the solver and emf are fixed at compile time (Idefix_SOLVER/Idefix_EMF)
+ - a mixed precision build (Idefix_PRECISION=Mixed)
+on the 3D Orszag-Tang problem.
+
+usage: benchme.py [-cmake opt1 opt2 ...] [-maxcycles n] [-j jobs]
+"""
+import os
+import sys
+
+idefixDir = os.getenv("IDEFIX_DIR")
+if idefixDir is None:
+  sys.exit("IDEFIX_DIR is not defined")
+sys.path.append(idefixDir)
+import pytools.bench as bench
+
+args = bench.argParser(cmakeExample="Kokkos_ENABLE_CUDA=ON").parse_args()
+
+problemDir = os.path.dirname(os.path.abspath(__file__))
+
+builds = {"generic": [],
+          "specialized": ["Idefix_SOLVER=hlld", "Idefix_EMF=uct_contact"],
+          "mixed": ["Idefix_PRECISION=Mixed"]}
+
+perfs = {}
+for name, options in builds.items():
+  buildDir = bench.build(problemDir, name, args.cmake + options, args.j)
+  output = bench.run(buildDir, ["-maxcycles", str(args.maxcycles), "-nowrite"], problemDir)
+  perfs[name] = bench.cellUpdates(output, name+" build")
+
+print("***************************************************")
+for name, perf in perfs.items():
+  print(f"{name:>12s}: {perf:.4e} cell updates/second")
+for name, perf in perfs.items():
+  if name != "generic":
+    print(f"{name:>12s}: speedup {perf/perfs['generic']:.3f}")
+print("***************************************************")
@@ -7,13 +7,16 @@ import os
 import sys
 sys.path.append(os.getenv("IDEFIX_DIR"))
 
+import shutil
 import pytools.idfx_test as tst
 
 # Whether we should reset our reference run (only do that on purpose!)
 
 tolerance=1e-13
+# the batched kernels may contract the floating point operations differently
+simdTolerance=1e-12
 
-def testMe(test):
+def testMe(test, inifile=""):
   test.configure()
   test.compile()
   tol=tolerance
@@ -21,12 +24,28 @@ def testMe(test):
     tol=1e-6
 
   # default with idefix.ini
-  test.run()
-  if test.init:
+  test.run(inputFile=inifile)
+  if inifile:
+    # other input files should give the same results as idefix.ini
+    test.inifile="idefix.ini"
+  elif test.init:
       if not test.mpi:
           test.makeReference(filename="dump.0001.dmp")
   test.nonRegressionTest(filename="dump.0001.dmp",tolerance=tol)
 
+def testSimd(test, width=4):
+  # the batched hlld solver (Idefix_SIMD_WIDTH) should give the results of the scalar one
+  testMe(test)
+  if not test.fake:
+    shutil.copy("dump.0001.dmp","dump.scalar.dmp")
+
+  test.cmake=["Idefix_SIMD_WIDTH="+str(width)]
+  test.configure()
+  test.compile()
+  test.run()
+  test.compareDump("dump.scalar.dmp","dump.0001.dmp",tolerance=simdTolerance)
+  test.cmake=[]
+
 
 test=tst.idfxTest(__file__)
 
@@ -48,6 +67,22 @@ else:
   test.mpi=True
   testMe(test)
 
+  # test with the fluxes computed block by block
+  test.mpi=False
+  testMe(test, inifile="idefix-blocks.ini")
+  test.mpi=True
+  testMe(test, inifile="idefix-blocks.ini")
+
+  # test with the Riemann solver and emf averaging fixed at compile time
+  test.mpi=False
+  test.cmake=["Idefix_SOLVER=hlld","Idefix_EMF=uct_contact"]
+  testMe(test)
+  test.cmake=[]
+
+  # test the batched Riemann solver, only available on CPUs
+  if not (test.cuda or test.hip):
+    test.mpi=False
+    testSimd(test)
 
   # test with vector potential
   test.mpi=False